@@ -0,0 +1,584 @@
+#include <math.h> /* fabsf() */
+#include <stdarg.h> /* va_list */
+#include <stdio.h> /* printf(), remove(), snprintf(), vsnprintf() */
+#include <stdlib.h> /* EXIT_FAILURE, EXIT_SUCCESS */
+#include <string.h> /* memcmp(), memcpy(), memset(), strchr(), strcmp(), strcpy(), strlen(), strstr() */
+
+#include "raylib.h"
+
+#define RAYTMX_IMPLEMENTATION
+#include "raytmx.h"
+
+/* Tests of raytmx that need neither a window nor a GPU. Maps are loaded from memory with LOAD_HEADLESS and the models */
+/* they're loaded into are checked field by field. Errors that raytmx reports through TraceLog() are captured so they */
+/* can be checked too. Build and run with "make test" from this directory, where the binary maps are written. */
+
+static int checksLength = 0, failedChecksLength = 0;
+static char loggedError[512]; /* The most recent error or warning logged, or an empty string if there wasn't one */
+
+#define CHECK(condition) \
+    do { \
+        checksLength += 1; \
+        if (!(condition)) { \
+            failedChecksLength += 1; \
+            printf("%s:%d: Check failed: %s\n", __FILE__, __LINE__, #condition); \
+        } \
+    } while (0)
+
+/* A 16x16 tile layer whose GIDs, some empty and some flipped, are given by TestLayerGid(). Its data is written into */
+/* the document as it's needed by each test. */
+#define TEST_LAYER_SIZE 16
+
+static const char* testMapFormat =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<map version=\"1.10\" orientation=\"orthogonal\" renderorder=\"right-down\" width=\"16\" height=\"16\" "
+        "tilewidth=\"16\" tileheight=\"16\" infinite=\"0\" nextlayerid=\"3\" nextobjectid=\"4\">\n"
+    " <properties>\n"
+    "  <property name=\"title\" value=\"tests\"/>\n"
+    "  <property name=\"level\" type=\"int\" value=\"7\"/>\n"
+    " </properties>\n"
+    " <tileset firstgid=\"1\" name=\"tiles\" tilewidth=\"16\" tileheight=\"16\" tilecount=\"8\" columns=\"4\">\n"
+    "  <image source=\"tiles.png\" width=\"64\" height=\"32\"/>\n"
+    "  <tile id=\"2\">\n"
+    "   <animation>\n"
+    "    <frame tileid=\"4\" duration=\"100\"/>\n"
+    "    <frame tileid=\"5\" duration=\"300\"/>\n"
+    "   </animation>\n"
+    "  </tile>\n"
+    " </tileset>\n"
+    " <layer id=\"1\" name=\"ground\" width=\"16\" height=\"16\">\n"
+    "  <data encoding=\"%s\"%s%s%s>\n"
+    "%s\n"
+    "</data>\n"
+    " </layer>\n"
+    " <objectgroup id=\"2\" name=\"things\" draworder=\"topdown\">\n"
+    "  <object id=\"1\" name=\"box\" x=\"40\" y=\"90\" width=\"20\" height=\"10\"/>\n"
+    "  <object id=\"2\" name=\"tile\" gid=\"3\" x=\"8\" y=\"48\" width=\"16\" height=\"16\"/>\n"
+    "  <object id=\"3\" name=\"point\" x=\"100\" y=\"12\">\n"
+    "   <point/>\n"
+    "  </object>\n"
+    " </objectgroup>\n"
+    "</map>\n";
+
+static uint32_t TestLayerGid(uint32_t i) {
+    if (i % 29 == 5) /* Leave some tiles empty */
+        return 0;
+    uint32_t gid = 1 + (((i * 7) + (i / TEST_LAYER_SIZE)) % 8);
+    if (i % 13 == 0) /* Flip some tiles horizontally */
+        gid |= 0x80000000;
+    return gid;
+}
+
+static void CaptureTraceLog(int logLevel, const char* text, va_list args) {
+    if (logLevel >= LOG_WARNING)
+        vsnprintf(loggedError, sizeof(loggedError), text, args);
+}
+
+/* Load the test map with the given layer data. 'compression' may be NULL. */
+static TmxMap* LoadTestMap(const char* encoding, const char* compression, const char* data) {
+    static char document[8192];
+    snprintf(document, sizeof(document), testMapFormat, encoding, compression != NULL ? " compression=\"" : "",
+        compression != NULL ? compression : "", compression != NULL ? "\"" : "", data);
+    loggedError[0] = '\0';
+    return LoadTMXFromMemory(document, strlen(document), NULL);
+}
+
+static const TmxLayer* FindLayer(const TmxMap* map, const char* name) {
+    for (uint32_t i = 0; map != NULL && i < map->layersLength; i++) {
+        if (strcmp(map->layers[i].name, name) == 0)
+            return &map->layers[i];
+    }
+    return NULL;
+}
+
+static bool IsTestLayerDecoded(const TmxMap* map) {
+    const TmxLayer* layer = FindLayer(map, "ground");
+    if (layer == NULL || layer->type != LAYER_TYPE_TILE_LAYER)
+        return false;
+    const TmxTileLayer* tileLayer = &layer->exact.tileLayer;
+    if (tileLayer->tiles == NULL || tileLayer->tilesLength != TEST_LAYER_SIZE * TEST_LAYER_SIZE)
+        return false;
+    for (uint32_t i = 0; i < tileLayer->tilesLength; i++) {
+        if (tileLayer->tiles[i] != TestLayerGid(i))
+            return false;
+    }
+    return true;
+}
+
+/* The test layer's GIDs as CSV, one row per line as Tiled writes them */
+static const char* GetTestLayerCsv(void) {
+    static char csv[4096];
+    size_t length = 0;
+    for (uint32_t i = 0; i < TEST_LAYER_SIZE * TEST_LAYER_SIZE; i++) {
+        bool isLast = i == (TEST_LAYER_SIZE * TEST_LAYER_SIZE) - 1;
+        length += (size_t)snprintf(csv + length, sizeof(csv) - length, "%u%s", TestLayerGid(i),
+            isLast ? "" : ((i + 1) % TEST_LAYER_SIZE == 0 ? ",\n" : ","));
+    }
+    return csv;
+}
+
+/* Encode data as Base64, breaking it into lines of the given length, indented, or into one line if zero */
+static void EncodeBase64(const unsigned char* data, size_t length, size_t lineLength, char* encoded) {
+    static const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t encodedLength = 0, lineCharacters = 0;
+    for (size_t i = 0; i < length; i += 3) {
+        uint32_t group = (uint32_t)data[i] << 16;
+        if (i + 1 < length)
+            group |= (uint32_t)data[i + 1] << 8;
+        if (i + 2 < length)
+            group |= data[i + 2];
+        for (size_t j = 0; j < 4; j++) {
+            if (lineLength > 0 && lineCharacters == lineLength) {
+                memcpy(encoded + encodedLength, "\n   ", 4);
+                encodedLength += 4;
+                lineCharacters = 0;
+            }
+            encoded[encodedLength++] = i + j <= length ? alphabet[(group >> (18 - (6 * j))) & 63] : '=';
+            lineCharacters += 1;
+        }
+    }
+    encoded[encodedLength] = '\0';
+}
+
+/* The test layer's GIDs as the little-endian, 32-bit integers that Base64 layer data is made of */
+static const unsigned char* GetTestLayerBytes(void) {
+    static unsigned char bytes[TEST_LAYER_SIZE * TEST_LAYER_SIZE * 4];
+    for (uint32_t i = 0; i < TEST_LAYER_SIZE * TEST_LAYER_SIZE; i++) {
+        uint32_t gid = TestLayerGid(i);
+        bytes[(i * 4) + 0] = (unsigned char)gid;
+        bytes[(i * 4) + 1] = (unsigned char)(gid >> 8);
+        bytes[(i * 4) + 2] = (unsigned char)(gid >> 16);
+        bytes[(i * 4) + 3] = (unsigned char)(gid >> 24);
+    }
+    return bytes;
+}
+
+static bool AreMapsEqual(const TmxMap* a, const TmxMap* b) {
+    if (a->width != b->width || a->height != b->height || a->tileWidth != b->tileWidth ||
+            a->tileHeight != b->tileHeight || a->propertiesLength != b->propertiesLength ||
+            a->tilesetsLength != b->tilesetsLength || a->layersLength != b->layersLength ||
+            a->gidsToTilesLength != b->gidsToTilesLength || a->animatedGidsLength != b->animatedGidsLength)
+        return false;
+    for (uint32_t i = 0; i < a->propertiesLength; i++) {
+        const TmxProperty *propertyA = &a->properties[i], *propertyB = &b->properties[i];
+        if (propertyA->type != propertyB->type || strcmp(propertyA->name, propertyB->name) != 0 ||
+                propertyA->intValue != propertyB->intValue ||
+                (propertyA->stringValue == NULL) != (propertyB->stringValue == NULL) ||
+                (propertyA->stringValue != NULL && strcmp(propertyA->stringValue, propertyB->stringValue) != 0))
+            return false;
+    }
+    for (uint32_t gid = 0; gid < a->gidsToTilesLength; gid++) {
+        const TmxTile *tileA = &a->gidsToTiles[gid], *tileB = &b->gidsToTiles[gid];
+        if (tileA->gid != tileB->gid || memcmp(&tileA->sourceRect, &tileB->sourceRect, sizeof(Rectangle)) != 0 ||
+                tileA->hasAnimation != tileB->hasAnimation || a->displayGids[gid] != b->displayGids[gid])
+            return false;
+    }
+    for (uint32_t i = 0; i < a->layersLength; i++) {
+        const TmxLayer *layerA = &a->layers[i], *layerB = &b->layers[i];
+        if (layerA->type != layerB->type || strcmp(layerA->name, layerB->name) != 0)
+            return false;
+        if (layerA->type == LAYER_TYPE_TILE_LAYER) {
+            const TmxTileLayer *tileLayerA = &layerA->exact.tileLayer, *tileLayerB = &layerB->exact.tileLayer;
+            if (tileLayerA->tilesLength != tileLayerB->tilesLength || memcmp(tileLayerA->tiles, tileLayerB->tiles,
+                    sizeof(uint32_t) * tileLayerA->tilesLength) != 0)
+                return false;
+        } else if (layerA->type == LAYER_TYPE_OBJECT_GROUP) {
+            const TmxObjectGroup *groupA = &layerA->exact.objectGroup, *groupB = &layerB->exact.objectGroup;
+            if (groupA->objectsLength != groupB->objectsLength || memcmp(groupA->ySortedObjects,
+                    groupB->ySortedObjects, sizeof(uint32_t) * groupA->objectsLength) != 0)
+                return false;
+            for (uint32_t j = 0; j < groupA->objectsLength; j++) {
+                const TmxObject *objectA = &groupA->objects[j], *objectB = &groupB->objects[j];
+                if (objectA->id != objectB->id || objectA->type != objectB->type || objectA->gid != objectB->gid ||
+                        objectA->x != objectB->x || objectA->y != objectB->y || strcmp(objectA->name,
+                        objectB->name) != 0)
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool AreFilesEqual(const char* fileNameA, const char* fileNameB) {
+    int lengthA = 0, lengthB = 0;
+    unsigned char* dataA = LoadFileData(fileNameA, &lengthA);
+    unsigned char* dataB = LoadFileData(fileNameB, &lengthB);
+    bool isEqual = dataA != NULL && dataB != NULL && lengthA == lengthB && memcmp(dataA, dataB, lengthA) == 0;
+    UnloadFileData(dataA);
+    UnloadFileData(dataB);
+    return isEqual;
+}
+
+static void TestBinaryRoundTrip(void) {
+    TmxMap* map = LoadTestMap("csv", NULL, GetTestLayerCsv());
+    CHECK(map != NULL);
+    if (map == NULL)
+        return;
+
+    /* Save to an absolute path that doesn't exist yet. Image paths are saved relative to the file's directory so */
+    /* they must resolve, once loaded, to the same images as the map's. */
+    char fileName[TMX_PATH_LENGTH], secondFileName[TMX_PATH_LENGTH];
+    snprintf(fileName, sizeof(fileName), "%s/raytmx-tests.bin", GetWorkingDirectory());
+    snprintf(secondFileName, sizeof(secondFileName), "%s/raytmx-tests-2.bin", GetWorkingDirectory());
+    remove(fileName);
+    remove(secondFileName);
+    CHECK(SaveTMXBinary(map, fileName));
+    TmxMap* binaryMap = LoadTMXBinary(fileName);
+    CHECK(binaryMap != NULL);
+    if (binaryMap != NULL) {
+        CHECK(AreMapsEqual(map, binaryMap));
+        CHECK(IsTestLayerDecoded(binaryMap));
+        char* imagePath = CanonicalizePath(map->tilesets[0].image.path);
+        char* binaryImagePath = CanonicalizePath(binaryMap->tilesets[0].image.path);
+        CHECK(strcmp(imagePath, binaryImagePath) == 0);
+        MemFree(imagePath);
+        MemFree(binaryImagePath);
+
+        /* The same map must produce the same bytes, even when it's the copy that was loaded from the file */
+        CHECK(SaveTMXBinary(binaryMap, secondFileName));
+        CHECK(AreFilesEqual(fileName, secondFileName));
+        UnloadTMX(binaryMap);
+    }
+
+    /* A file cut short must be rejected rather than loaded partially */
+    int length = 0;
+    unsigned char* data = LoadFileData(fileName, &length);
+    if (data != NULL) {
+        CHECK(SaveFileData(secondFileName, data, length / 2));
+        loggedError[0] = '\0';
+        CHECK(LoadTMXBinary(secondFileName) == NULL);
+        CHECK(strstr(loggedError, "truncated or corrupt") != NULL);
+        UnloadFileData(data);
+    }
+
+    remove(fileName);
+    remove(secondFileName);
+    UnloadTMX(map);
+}
+
+static void TestAtlasPacking(void) {
+    /* Tiles of assorted sizes, too many for one small page, plus one too wide and one too tall for any page */
+    const int32_t maxSize = 128;
+    RaytmxAtlasEntry entries[200], shuffledEntries[200];
+    const uint32_t entriesLength = sizeof(entries) / sizeof(entries[0]);
+    uint32_t random = 12345;
+    for (uint32_t i = 0; i < entriesLength; i++) {
+        memset(&entries[i], 0, sizeof(RaytmxAtlasEntry));
+        entries[i].gid = i + 1;
+        random = (random * 1103515245) + 12345;
+        entries[i].width = 4 + (int32_t)((random >> 16) % 29);
+        random = (random * 1103515245) + 12345;
+        entries[i].height = 4 + (int32_t)((random >> 16) % 29);
+    }
+    entries[17].width = maxSize - 1; /* Fits without its border, but not with it */
+    entries[42].height = maxSize;
+
+    /* Pack the same entries in another order. The result must be the same since it depends only on the entries. */
+    for (uint32_t i = 0; i < entriesLength; i++)
+        shuffledEntries[i] = entries[(i * 7) % entriesLength];
+
+    int32_t pagesWidth = 0, pagesHeights[200 + 1];
+    uint32_t pagesLength = PackAtlasEntries(entries, entriesLength, maxSize, &pagesWidth, pagesHeights);
+    CHECK(pagesLength > 1);
+    CHECK(pagesWidth > 0 && pagesWidth <= maxSize);
+
+    bool isInBounds = true, isOverlapping = false;
+    uint32_t unpackedLength = 0;
+    for (uint32_t i = 0; i < entriesLength; i++) {
+        const RaytmxAtlasEntry* entry = &entries[i];
+        if (entry->page == UINT32_MAX) {
+            unpackedLength += 1;
+            continue;
+        }
+        /* Each entry and its one-pixel border must be within its page */
+        if (entry->page >= pagesLength || entry->x < 0 || entry->y < 0 || entry->x + entry->width + 2 > pagesWidth ||
+                entry->y + entry->height + 2 > pagesHeights[entry->page] || pagesHeights[entry->page] > maxSize)
+            isInBounds = false;
+        /* ...and must not share a pixel, border included, with any other entry on the page */
+        for (uint32_t j = i + 1; j < entriesLength; j++) {
+            const RaytmxAtlasEntry* other = &entries[j];
+            if (other->page == entry->page && entry->x < other->x + other->width + 2 &&
+                    other->x < entry->x + entry->width + 2 && entry->y < other->y + other->height + 2 &&
+                    other->y < entry->y + entry->height + 2)
+                isOverlapping = true;
+        }
+    }
+    CHECK(isInBounds);
+    CHECK(!isOverlapping);
+    CHECK(unpackedLength == 2);
+
+    int32_t shuffledPagesWidth = 0, shuffledPagesHeights[200 + 1];
+    uint32_t shuffledPagesLength = PackAtlasEntries(shuffledEntries, entriesLength, maxSize, &shuffledPagesWidth,
+        shuffledPagesHeights);
+    CHECK(shuffledPagesLength == pagesLength && shuffledPagesWidth == pagesWidth);
+    CHECK(memcmp(shuffledPagesHeights, pagesHeights, sizeof(int32_t) * pagesLength) == 0);
+    CHECK(memcmp(shuffledEntries, entries, sizeof(entries)) == 0);
+}
+
+static void TestAnimations(void) {
+    TmxMap* map = LoadTestMap("csv", NULL, GetTestLayerCsv());
+    CHECK(map != NULL);
+    if (map == NULL)
+        return;
+
+    /* GID 3 displays GID 5 for 0.1 seconds then GID 6 for 0.3 seconds, looping every 0.4 seconds */
+    CHECK(map->animatedGidsLength == 1 && map->animatedGids[0] == 3);
+    AnimateTMXAt(map, 0.05);
+    CHECK(map->displayGids[3] == 5);
+    AnimateTMXAt(map, 0.15);
+    CHECK(map->displayGids[3] == 6 && map->gidsToTiles[3].frameIndex == 1);
+    CHECK(fabsf(map->gidsToTiles[3].frameTime - 0.05f) < 0.0001f);
+    AnimateTMXAt(map, 0.45); /* Into the second loop */
+    CHECK(map->displayGids[3] == 5);
+    AnimateTMXAt(map, 1000.15); /* Far into the future, at the same point of a loop */
+    CHECK(map->displayGids[3] == 6);
+    AnimateTMXAt(map, -0.05); /* Before the animation began, which counts back from the end of a loop */
+    CHECK(map->displayGids[3] == 6);
+    CHECK(map->displayGids[4] == 4 && map->displayGids[6] == 6); /* Tiles that aren't animated display themselves */
+
+    /* Stepping by a time must be the same as jumping to the sum of the steps */
+    AnimateTMXAt(map, 0.0);
+    for (int i = 0; i < 3; i++)
+        AnimateTMXDelta(map, 0.25);
+    CHECK(map->animationTime == 0.75);
+    CHECK(map->displayGids[3] == 6 && map->gidsToTiles[3].frameIndex == 1);
+    CHECK(fabsf(map->gidsToTiles[3].frameTime - 0.25f) < 0.0001f);
+
+    UnloadTMX(map);
+}
+
+static void TestBase64(void) {
+    /* Layer data on one line, which can be decoded by SIMD in full, and on indented lines, which can't */
+    static char encoded[4096];
+    const size_t lineLengths[] = { 0, 76, 5 };
+    for (size_t i = 0; i < sizeof(lineLengths) / sizeof(lineLengths[0]); i++) {
+        EncodeBase64(GetTestLayerBytes(), TEST_LAYER_SIZE * TEST_LAYER_SIZE * 4, lineLengths[i], encoded);
+        TmxMap* map = LoadTestMap("base64", NULL, encoded);
+        CHECK(IsTestLayerDecoded(map));
+        CHECK(loggedError[0] == '\0');
+        UnloadTMX(map);
+    }
+
+    /* Every length of data, from none to enough for several SIMD iterations, so that every combination of SIMD */
+    /* and scalar decoding and every amount of padding is decoded */
+    unsigned char data[200], decoded[200];
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (unsigned char)((i * 151) + 7);
+    bool isDecoded = true;
+    for (size_t length = 0; length <= sizeof(data); length++) {
+        EncodeBase64(data, length, 0, encoded);
+        size_t encodedLength = strlen(encoded), decodedLength = 0;
+        if (GetBase64DecodedLength(encoded, encodedLength) != length ||
+                !DecodeBase64(encoded, encodedLength, decoded, length, &decodedLength) || decodedLength != length ||
+                memcmp(decoded, data, length) != 0)
+            isDecoded = false;
+    }
+    CHECK(isDecoded);
+
+    /* A character outside of the alphabet, even deep enough into the data to be seen by SIMD, is an error */
+    EncodeBase64(GetTestLayerBytes(), TEST_LAYER_SIZE * TEST_LAYER_SIZE * 4, 0, encoded);
+    encoded[300] = '!';
+    TmxMap* map = LoadTestMap("base64", NULL, encoded);
+    CHECK(!IsTestLayerDecoded(map));
+    CHECK(strstr(loggedError, "Unable to decode Base64 data for layer \"ground\"") != NULL);
+    UnloadTMX(map);
+}
+
+static void TestCsv(void) {
+    /* Carriage returns, other whitespace, and a trailing comma are all tolerated */
+    static char csv[8192];
+    const char* iterator = GetTestLayerCsv();
+    size_t csvLength = 0;
+    for (; *iterator != '\0'; iterator++) {
+        if (*iterator == '\n') {
+            memcpy(csv + csvLength, " \t\r\n", 4);
+            csvLength += 4;
+        } else
+            csv[csvLength++] = *iterator;
+    }
+    memcpy(csv + csvLength, ",\r\n", 4);
+    csv[csvLength + 4] = '\0';
+    TmxMap* map = LoadTestMap("csv", NULL, csv);
+    CHECK(IsTestLayerDecoded(map));
+    CHECK(loggedError[0] == '\0');
+    UnloadTMX(map);
+
+    /* Malformed data is reported by its line within the document and column within that line. The layer's data */
+    /* begins on line 18 of the test map. An error on its fourth row is far enough in to be found by SIMD. */
+    struct {
+        const char* data;
+        size_t errorRow, errorColumn; /* Where, counted from zero, to put a stray character if 'data' is NULL */
+        const char* error;
+    } malformedCsvs[] = {
+        { NULL, 3, 10, "line 21, column 11" },
+        { NULL, 0, 0, "line 18, column 1" },
+        { "1,2,,3", 0, 0, "line 18, column 5" }, /* A missing value */
+        { "1,2 3", 0, 0, "line 18, column 5" }, /* Values without a comma between them */
+        { "1,\n4294967296", 0, 0, "line 19, column 1" } /* A value too large to be a GID */
+    };
+    for (size_t i = 0; i < sizeof(malformedCsvs) / sizeof(malformedCsvs[0]); i++) {
+        const char* data = malformedCsvs[i].data;
+        if (data == NULL) {
+            strcpy(csv, GetTestLayerCsv());
+            char* row = csv;
+            for (size_t j = 0; j < malformedCsvs[i].errorRow; j++)
+                row = strchr(row, '\n') + 1;
+            row[malformedCsvs[i].errorColumn] = 'x';
+            data = csv;
+        }
+        map = LoadTestMap("csv", NULL, data);
+        CHECK(!IsTestLayerDecoded(map));
+        CHECK(strstr(loggedError, "Malformed CSV data for layer \"ground\"") != NULL);
+        CHECK(strstr(loggedError, malformedCsvs[i].error) != NULL);
+        UnloadTMX(map);
+    }
+}
+
+/* The test layer compressed by zlib with dynamic Huffman codes, the compression level's default, and with fixed */
+/* codes. Stored, i.e. uncompressed, blocks are built by TestDeflate() itself. */
+static const char* testLayerZlib =
+    "eNqVklsKACEMA+O+j52jb2EpiNvUKuRrqiOkDeAD4LZclhPf2S2bpVlGftgd58nM+AYj7jOYeJSj6onewIIn4LyKno4TA696\n"
+    "FFeefgaJo+oR/6SaSXaIUf8zT6V/JB7lqHoKO4SFHeJC/87pHPP+fx7leAEDJw3h";
+static const char* testLayerZlibFixed =
+    "eAFjZGBo4GBgYGAHYjYgZmWAAGYgZgJiRiBGl2cB6oHJ41GDbkYDNnmYGgYC9uCyg1h7sJnBQII9WOQb2Ii0B0m+gQFNnlh7\n"
+    "cMnjsgdZDQMeO4i1B4c7G3CpwZOGGrDFPyF7iIl/Bjz24LKDWHuISEMMJKShBhLiHybfAJNnIBz/GPbgsgMAAycN4Q==";
+static const char* testLayerGzip =
+    "H4sIAAAAAAACA5WSWwoAIQwD476PnaNvYSmI29Qq5GuqI6QN4APgtlyWE9/ZLZulWUZ+2B3nycz4BiPuM5h4lKPqid7Agifg\n"
+    "vIqejhMDr3oUV55+Bomj6hH/pJpJdohR/zNPpX8kHuWoego7hIUd4kL/zukc8/5/HuV4ARGcttEABAAA";
+/* testLayerZlib with the last byte of its Adler-32 checksum changed */
+static const char* testLayerZlibBadChecksum =
+    "eNqVklsKACEMA+O+j52jb2EpiNvUKuRrqiOkDeAD4LZclhPf2S2bpVlGftgd58nM+AYj7jOYeJSj6onewIIn4LyKno4TA696\n"
+    "FFeefgaJo+oR/6SaSXaIUf8zT6V/JB7lqHoKO4SFHeJC/87pHPP+fx7leAEDJw0e";
+
+static void TestDeflate(void) {
+    const char* compressions[] = { "zlib", "zlib", "gzip" };
+    const char* datas[] = { testLayerZlib, testLayerZlibFixed, testLayerGzip };
+    for (size_t i = 0; i < sizeof(datas) / sizeof(datas[0]); i++) {
+        TmxMap* map = LoadTestMap("base64", compressions[i], datas[i]);
+        CHECK(IsTestLayerDecoded(map));
+        CHECK(loggedError[0] == '\0');
+        UnloadTMX(map);
+    }
+
+    /* A zlib stream of stored blocks: a header, blocks of at most 1,000 bytes each with their lengths and the */
+    /* lengths' complements, and then the big-endian Adler-32 checksum of the uncompressed data */
+    const unsigned char* bytes = GetTestLayerBytes();
+    const size_t bytesLength = TEST_LAYER_SIZE * TEST_LAYER_SIZE * 4;
+    static unsigned char stored[8192];
+    static char encoded[16384];
+    size_t storedLength = 0;
+    stored[storedLength++] = 0x78;
+    stored[storedLength++] = 0x01;
+    for (size_t i = 0; i < bytesLength; i += 1000) {
+        size_t blockLength = bytesLength - i < 1000 ? bytesLength - i : 1000;
+        stored[storedLength++] = i + blockLength == bytesLength ? 0x01 : 0x00; /* Whether it's the final block */
+        stored[storedLength++] = (unsigned char)blockLength;
+        stored[storedLength++] = (unsigned char)(blockLength >> 8);
+        stored[storedLength++] = (unsigned char)~blockLength;
+        stored[storedLength++] = (unsigned char)(~blockLength >> 8);
+        memcpy(stored + storedLength, bytes + i, blockLength);
+        storedLength += blockLength;
+    }
+    uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < bytesLength; i++) {
+        a = (a + bytes[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    uint32_t adler = (b << 16) | a;
+    for (int i = 3; i >= 0; i--)
+        stored[storedLength++] = (unsigned char)(adler >> (i * 8));
+    EncodeBase64(stored, storedLength, 76, encoded);
+    SetLoadFlagsTMX(LOAD_HEADLESS | LOAD_VERIFY_CHECKSUMS);
+    TmxMap* map = LoadTestMap("base64", "zlib", encoded);
+    CHECK(IsTestLayerDecoded(map));
+    CHECK(loggedError[0] == '\0');
+    UnloadTMX(map);
+
+    /* A bad checksum drops the layer's data, but only when checksums are verified */
+    map = LoadTestMap("base64", "zlib", testLayerZlibBadChecksum);
+    CHECK(!IsTestLayerDecoded(map));
+    CHECK(strstr(loggedError, "doesn't match the stream's checksum") != NULL);
+    UnloadTMX(map);
+    SetLoadFlagsTMX(LOAD_HEADLESS);
+    map = LoadTestMap("base64", "zlib", testLayerZlibBadChecksum);
+    CHECK(IsTestLayerDecoded(map));
+    UnloadTMX(map);
+
+    /* A stream that isn't zlib at all */
+    map = LoadTestMap("base64", "zlib", testLayerGzip);
+    CHECK(!IsTestLayerDecoded(map));
+    CHECK(strstr(loggedError, "the stream's header is invalid") != NULL);
+    UnloadTMX(map);
+}
+
+/* The test layer compressed by Zstandard at level 19, with and without a checksum, and with a wrong checksum. Raw, */
+/* i.e. uncompressed, blocks are built by TestZstd() itself. */
+static const char* testLayerZstd =
+    "KLUv/WQAAy0DAJLDBgvgLQcAQOnu7u7eKVcyc6XrcfBw8ScvNz8NAiegUWLG+r8BoG4cjQHPuIrCQciFpeJBhla5iM4PQG5p\n"
+    "ch6xjHtlS4XFHRLY8sUllnRwSXwEavms4kog3ucHIQ8ChUA5EFQFFVE94A==";
+static const char* testLayerZstdNoChecksum =
+    "KLUv/WAAAy0DAJLDBgvgLQcAQOnu7u7eKVcyc6XrcfBw8ScvNz8NAiegUWLG+r8BoG4cjQHPuIrCQciFpeJBhla5iM4PQG5p\n"
+    "ch6xjHtlS4XFHRLY8sUllnRwSXwEavms4kog3ucHIQ8ChUA5EFQF";
+static const char* testLayerZstdBadChecksum =
+    "KLUv/WQAAy0DAJLDBgvgLQcAQOnu7u7eKVcyc6XrcfBw8ScvNz8NAiegUWLG+r8BoG4cjQHPuIrCQciFpeJBhla5iM4PQG5p\n"
+    "ch6xjHtlS4XFHRLY8sUllnRwSXwEavms4kog3ucHIQ8ChUA5EFQFFVE9Hw==";
+
+static void TestZstd(void) {
+    SetLoadFlagsTMX(LOAD_HEADLESS | LOAD_VERIFY_CHECKSUMS);
+    const char* datas[] = { testLayerZstd, testLayerZstdNoChecksum };
+    for (size_t i = 0; i < sizeof(datas) / sizeof(datas[0]); i++) {
+        TmxMap* map = LoadTestMap("base64", "zstd", datas[i]);
+        CHECK(IsTestLayerDecoded(map));
+        CHECK(loggedError[0] == '\0');
+        UnloadTMX(map);
+    }
+
+    /* A frame of one raw block: the magic number, a header giving a single segment with a two-byte content size */
+    /* (stored minus 256), and then the block's header, marking it the last and raw with its size, and its data */
+    const unsigned char* bytes = GetTestLayerBytes();
+    const size_t bytesLength = TEST_LAYER_SIZE * TEST_LAYER_SIZE * 4;
+    static unsigned char frame[8192];
+    static char encoded[16384];
+    const unsigned char frameHeader[] = { 0x28, 0xB5, 0x2F, 0xFD, 0x60,
+        (unsigned char)(bytesLength - 256), (unsigned char)((bytesLength - 256) >> 8),
+        (unsigned char)((bytesLength << 3) | 1), (unsigned char)(bytesLength >> 5), (unsigned char)(bytesLength >> 13) };
+    memcpy(frame, frameHeader, sizeof(frameHeader));
+    memcpy(frame + sizeof(frameHeader), bytes, bytesLength);
+    EncodeBase64(frame, sizeof(frameHeader) + bytesLength, 76, encoded);
+    TmxMap* map = LoadTestMap("base64", "zstd", encoded);
+    CHECK(IsTestLayerDecoded(map));
+    CHECK(loggedError[0] == '\0');
+    UnloadTMX(map);
+
+    /* A bad checksum drops the layer's data, but only when checksums are verified */
+    map = LoadTestMap("base64", "zstd", testLayerZstdBadChecksum);
+    CHECK(!IsTestLayerDecoded(map));
+    CHECK(strstr(loggedError, "doesn't match the stream's checksum") != NULL);
+    UnloadTMX(map);
+    SetLoadFlagsTMX(LOAD_HEADLESS);
+    map = LoadTestMap("base64", "zstd", testLayerZstdBadChecksum);
+    CHECK(IsTestLayerDecoded(map));
+    UnloadTMX(map);
+
+    /* Data that isn't a Zstandard frame */
+    map = LoadTestMap("base64", "zstd", testLayerZlib);
+    CHECK(!IsTestLayerDecoded(map));
+    CHECK(strstr(loggedError, "the stream's header is invalid") != NULL);
+    UnloadTMX(map);
+}
+
+int main(void) {
+    SetTraceLogCallback(CaptureTraceLog);
+    SetLoadFlagsTMX(LOAD_HEADLESS);
+
+    TestBinaryRoundTrip();
+    TestAtlasPacking();
+    TestAnimations();
+    TestBase64();
+    TestCsv();
+    TestDeflate();
+    TestZstd();
+
+    printf("%d of %d checks passed\n", checksLength - failedChecksLength, checksLength);
+    return failedChecksLength == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,40 @@
+#include <stddef.h> /* NULL */
+#include <stdlib.h> /* EXIT_FAILURE, EXIT_SUCCESS */
+
+#include "raylib.h"
+
+#define RAYTMX_IMPLEMENTATION
+#include "raytmx.h"
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        TraceLog(LOG_INFO, "Usage: %s <input.tmx> <output.bin>", argc > 0 ? argv[0] : "tmx2bin");
+        return EXIT_FAILURE;
+    }
+
+    /* Text objects are laid out with a font at load time, and fonts require an OpenGL context. A hidden window */
+    /* provides one without anything being shown. */
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(1, 1, "tmx2bin");
+
+    /* Maps with packed atlases can't be saved so make sure the map is loaded with its tilesets' own images. */
+    /* LOAD_PACK_ATLAS may still be used when loading the binary map. */
+    SetLoadFlagsTMX(0);
+    TmxMap* map = LoadTMX(argv[1]);
+    if (map == NULL) {
+        TraceLog(LOG_ERROR, "Failed to load TMX \"%s\"", argv[1]);
+        CloseWindow();
+        return EXIT_FAILURE;
+    }
+
+    bool isSaved = SaveTMXBinary(map, argv[2]);
+    if (isSaved)
+        TraceLog(LOG_INFO, "Converted \"%s\" to \"%s\"", argv[1], argv[2]);
+    else
+        TraceLog(LOG_ERROR, "Failed to save binary map \"%s\"", argv[2]);
+
+    UnloadTMX(map);
+    CloseWindow();
+
+    return isSaved ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -25,17 +25,42 @@ OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
     #define RAYTMX_DEC extern
   to specify raytmx function declarations as static or extern, respectively.
   The default specifier is extern.
+
+  You can define RAYTMX_CHUNK_SIZE with
+    #define RAYTMX_CHUNK_SIZE 16
+  to change the width and height, in tiles, of the chunks tile layers are divided into for drawing. Each chunk caches
+  the geometry of its tiles. The default is 32 and the value must be from 1 to 255.
+
+  You can define RAYTMX_ATLAS_MAX_SIZE with
+    #define RAYTMX_ATLAS_MAX_SIZE 2048
+  to limit the width and height, in pixels, of the atlases created when loading with the LOAD_PACK_ATLAS flag. The
+  default is 4096.
+
+  You can define RAYTMX_NO_SIMD with
+    #define RAYTMX_NO_SIMD
+  to use only portable code in place of the SIMD (e.g. SSE2) code some decoding is accelerated with, where available.
+
+  You can define RAYTMX_NO_THREADS with
+    #define RAYTMX_NO_THREADS
+  to decode tile layer data and images only on the thread calling LoadTMX(). Otherwise, the layers of large maps, and
+  the images of all maps, are decoded concurrently using POSIX threads or, on Windows, Win32 threads. POSIX builds
+  must then link with pthreads.
+
+  You can define RAYTMX_NO_MMAP with
+    #define RAYTMX_NO_MMAP
+  to read documents (TMX, TSX, and TX) from disk into memory with raylib. Otherwise, on POSIX systems, documents are
+  memory-mapped and parsed without being copied.
 */
 
 #ifndef RAYTMX_H
     #define RAYTMX_H
 
 #include <ctype.h> /* isspace() */
-#include <math.h> /* floor(), INFINITY */
+#include <math.h> /* ceilf(), fabsf(), floor(), floorf(), fmaxf(), fminf(), fmod(), sqrtf(), INFINITY */
 #include <stddef.h> /* NULL */
 #include <stdint.h> /* int32_t, uint32_t */
-#include <stdlib.h> /* atoi(), strtoul() */
-#include <string.h> /* memcpy(), memset(), strcpy(), strcpy_s() strlen(), strncpy(), strncpy_s() */
+#include <stdlib.h> /* atoi(), qsort(), strtoul() */
+#include <string.h> /* memcmp(), memcpy(), memset(), strcpy(), strcpy_s() strlen(), strncpy(), strncpy_s() */
 
 #include "raylib.h"
 #include "rlgl.h"
@@ -44,6 +69,13 @@ OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
     #define RAYTMX_DEC
 #endif /* RAYTMX_DEC */
 
+#ifndef RAYTMX_CHUNK_SIZE
+    #define RAYTMX_CHUNK_SIZE 32
+#endif /* RAYTMX_CHUNK_SIZE */
+#if RAYTMX_CHUNK_SIZE < 1 || RAYTMX_CHUNK_SIZE > 255 /* Chunks index their quads with 16-bit row offsets */
+    #error "RAYTMX_CHUNK_SIZE must be from 1 to 255"
+#endif
+
 #ifdef __cplusplus
     extern "C" {
 #endif /* __cpluspus */
@@ -67,6 +99,32 @@ enum tmx_log_flags {
     LOG_SKIP_WANG_TILES = 512 /**< Skip Wang tiles of Wang sets (<wangset>s). */
 };
 
+/**
+ * Bit flags passed to SetLoadFlagsTMX() that optionally change how maps are loaded.
+ */
+enum tmx_load_flags {
+    LOAD_PACK_ATLAS = 1, /**< Pack the images of all tilesets into as few textures (atlases) as possible. Tiles then
+                              share textures, and batches, instead of each image having a texture of its own. Tilesets'
+                              images are left without textures (i.e. with IDs of zero) as the atlases replace them. */
+    LOAD_VERIFY_CHECKSUMS = 2, /**< Verify the checksums of compressed layer data, dropping the data of layers whose
+                                    checksums don't match. These are CRC-32 for GZIP, Adler-32 for ZLIB, and XXH64 for
+                                    Zstandard when the encoder included it. */
+    LOAD_HEADLESS = 4, /**< Skip all texture and font work so that maps can be loaded without a window or graphics
+                            context, as by servers and tools. Images are left without textures and their dimensions,
+                            if not given by the document, are read from their files' headers. Text objects are not
+                            laid out into lines. Maps loaded this way must not be drawn. Overrides LOAD_PACK_ATLAS. */
+    LOAD_SHARE_TEXTURES = 8, /**< Share textures between maps through a process-wide cache keyed by the images'
+                                 canonicalized paths. A texture is uploaded once, no matter how many maps use it, and
+                                 UnloadTMX() releases the map's references to it rather than unloading it outright.
+                                 The texture is unloaded once no map refers to it so, to reuse textures when switching
+                                 maps, load the next map before unloading the previous one. Atlases aren't shared. */
+    LOAD_CACHE_DOCUMENTS = 16 /**< Keep parsed external tilesets (TSX) and object templates (TX) in a process-wide
+                                   cache, keyed by their canonicalized paths and modification times, so that maps
+                                   referencing the same files don't parse them again. Each map is given a copy of its
+                                   own. Files read through SetFileCallbacksTMX() have no modification time and stay
+                                   cached until invalidated. See FlushDocumentCacheTMX(). */
+};
+
 /**
  * Identifiers for the possible layer types.
  */
@@ -183,12 +241,18 @@ typedef struct tmx_object TmxObject;
 typedef struct tmx_text TmxText;
 typedef struct tmx_text_line TmxTextLine;
 typedef struct tmx_map TmxMap;
+typedef struct tmx_draw_stats TmxDrawStats;
+typedef struct tmx_load_progress TmxLoadProgress;
+typedef struct tmx_load_task TmxLoadTask; /* Opaque, defined by the implementation */
+typedef struct tmx_tile_chunk TmxTileChunk; /* Opaque, defined by the implementation */
+typedef struct tmx_object_index TmxObjectIndex; /* Opaque, defined by the implementation */
 
 /**
  * Model of an <image> element. Defines an image and relevant attributes along with a loaded texture.
  */
 typedef struct tmx_image {
     char* source; /**< File name and/or path referencing the image on disk. */
+    char* path; /**< 'source' joined with the directory of the document that referenced it. */
     Color trans; /**< (Optional) color that defines is treated as transparent. Not currently implemented. */
     bool hasTrans; /**< When true, indicates 'trans' has been set with a color to be treated as transparent. */
     uint32_t width; /**< Width of the image in pixels. */
@@ -205,8 +269,15 @@ typedef struct tmx_tile_layer {
     uint32_t height; /**< Height of the layer in tiles. */
     char* encoding; /**< (Optional) encoding used to encode tiles. May be NULL, "base64," or "csv." */
     char* compression; /**< (Optional) compression used to compress tiles. May be NULL, "gzip," "zlib," or "zstd." */
-    uint32_t* tiles; /**< Array of tile Global IDs (GIDs) contained by this tile layer. */
+    uint32_t* tiles; /**< Array of tile Global IDs (GIDs) contained by this tile layer. The geometry drawn for these is
+                          cached in 'chunks' so tiles should be replaced with SetTileTMX(). If the array is written to
+                          directly, InvalidateTileLayerTMX() must be called afterward or the changes may not be drawn. */
     uint32_t tilesLength; /**< Length of the 'tiles' array. */
+    TmxTileChunk* chunks; /**< Array of chunks, areas of RAYTMX_CHUNK_SIZE by RAYTMX_CHUNK_SIZE tiles, in right-down
+                               order. Each caches the geometry of its tiles so it isn't recalculated every frame. The
+                               geometry is built, and kept up to date with animations, when the chunk is drawn. */
+    uint32_t chunksWidth; /**< Number of chunks along the X axis. */
+    uint32_t chunksHeight; /**< Number of chunks along the Y axis. */
 } TmxTileLayer;
 
 /**
@@ -222,6 +293,8 @@ typedef struct tmx_object_group {
     TmxObject* objects; /**< Array of objects contained by this object layer. */
     uint32_t objectsLength; /**< Length of the 'objects' array. */
     uint32_t* ySortedObjects; /**< Array of indexes of 'objects' sorted by the objects' y-coordinates. */
+    TmxObjectIndex* index; /**< Spatial index of the objects' bounds, built when the map is loaded, used to find the
+                                objects within an area without checking every one. See QueryObjectsRecTMX(). */
 } TmxObjectGroup;
 
 /**
@@ -310,6 +383,8 @@ typedef struct tmx_tileset {
 typedef struct tmx_animation {
     TmxAnimationFrame* frames; /**< Array of frames. These frames identify tiles and durations to be displayed. */
     uint32_t framesLength; /**< Length of the 'frames' array. */
+    double* frameEnds; /**< Array, parallel to 'frames', of the times in seconds, relative to the start of the
+                            animation, at which each frame ends. The last is the duration of the whole animation. */
 } TmxAnimation;
 
 /**
@@ -349,10 +424,12 @@ typedef struct tmx_tile {
     Rectangle sourceRect; /**< Sub-rectangle within a tileset to extract that is to be drawn. */
     Texture2D texture; /**< Texture in VRAM to be used to draw. May be used whole or as a source of a sub-rectangle. */
     Vector2 offset; /**< Offset in pixels to be applied to the tile, derived from the tileset. */
+    Vector2 texcoords[4]; /**< 'sourceRect' normalized to the [0.0, 1.0] range of 'texture'. The top-left, bottom-left,
+                               bottom-right, and top-right corners, in that order. */
     TmxAnimation animation; /**< (Optional) animation. */
     bool hasAnimation; /**< When true, indicates 'animation' is set. */
     uint32_t frameIndex; /**< For animations, the current animation frame to draw. */
-    float frameTime; /**< For animations, an accumulator. The time, in seconds, the current frame has been drawn. */
+    float frameTime; /**< For animations, the time, in seconds, the current frame has been drawn. */
 } TmxTile;
 
 /**
@@ -436,8 +513,64 @@ typedef struct tmx_map {
     TmxTile* gidsToTiles; /**< Array of pre-calculated tile metadata with all the values needed to quickly draw a tile
                                given its GID. Allocated such that gidsToTiles[1] returns the data of tile GID 1. */
     uint32_t gidsToTilesLength; /**< Length of the 'gidsToTiles' array. */
+    int32_t* displayGids; /**< Array, also of length 'gidsToTilesLength', of the GIDs whose tiles are currently displayed
+                               in place of each GID. Static tiles map to themselves and animations to their current
+                               frames' tiles. Zero where there's nothing to display. Kept current by AnimateTMX(). */
+    uint32_t* animatedGids; /**< Array of the GIDs of all tiles that are animations. */
+    uint32_t animatedGidsLength; /**< Length of the 'animatedGids' array. */
+    double animationTime; /**< Time, in seconds, at which the map's animations were last evaluated. */
+    Rectangle tileBounds; /**< Union of the areas, in pixels, any tile of this map may cover relative to the top-left
+                               corner of its cell. Accounts for oversized tiles and tileset offsets. Used to determine
+                               the range of cells that may be visible without visiting every cell. */
+    Texture2D* atlases; /**< (Optional) array of textures into which tileset images were packed, may be NULL. Only used
+                             when the map was loaded with the LOAD_PACK_ATLAS flag. */
+    uint32_t atlasesLength; /**< Length of the 'atlases' array. */
 } TmxMap;
 
+/**
+ * Counters describing the work submitted to raylib by the most recent DrawTMX() or DrawTMXLayers() call.
+ */
+typedef struct tmx_draw_stats {
+    uint32_t batches; /**< Number of quad batches begun. A new batch is needed when the texture changes or when
+                           raylib's vertex buffer fills. */
+    uint32_t quads; /**< Number of textured quads (i.e. tiles, including tile objects) submitted. */
+} TmxDrawStats;
+
+/**
+ * Progress of an asynchronous load begun with BeginLoadTMX(). Counts that are only known once parsing is complete are
+ * zero until then.
+ */
+typedef struct tmx_load_progress {
+    size_t bytesParsed; /**< Bytes of the TMX document parsed so far. */
+    size_t bytesTotal; /**< Length of the TMX document, or zero until it has been read. */
+    uint32_t layersDecoded; /**< Number of tile layers whose Base64 or CSV data has been decoded. */
+    uint32_t layersTotal; /**< Number of tile layers with Base64 or CSV data. */
+    uint32_t imagesDecoded; /**< Number of images decoded into RAM. Images are decoded once parsing is complete. */
+    uint32_t imagesTotal; /**< Number of images to be decoded, including those packed into atlases. */
+    uint32_t texturesUploaded; /**< Number of textures uploaded to VRAM by FinalizeLoadTMX(). */
+    uint32_t texturesTotal; /**< Number of textures, including atlases, to be uploaded. Known once 'isLoaded' is true. */
+    bool isLoaded; /**< True once everything but the uploading of textures is done, successfully or not. */
+} TmxLoadProgress;
+
+/**
+ * Callback, set with SetFileCallbacksTMX(), that provides the contents of a file such as a TSX, TX, or image. Images
+ * are decoded concurrently so, unless RAYTMX_NO_THREADS is defined, this may be called from several threads at once.
+ *
+ * @param fileName File name and/or path of the file to be read, joined with the referencing document's directory.
+ * @param length Output for the length, in bytes, of the returned data.
+ * @param userData Pointer given to SetFileCallbacksTMX().
+ * @return The contents of the file, or NULL if it couldn't be read.
+ */
+typedef const unsigned char* (*TmxLoadFileCallback)(const char* fileName, size_t* length, void* userData);
+
+/**
+ * Callback, set with SetFileCallbacksTMX(), that releases the contents of a file returned by a TmxLoadFileCallback.
+ *
+ * @param data Contents previously returned by the load callback.
+ * @param userData Pointer given to SetFileCallbacksTMX().
+ */
+typedef void (*TmxUnloadFileCallback)(const unsigned char* data, void* userData);
+
 /**
  * Given a path to TMX document, parse it and create an equivalent model that can be, among other uses, quickly drawn.
  * This function allocates memory and loads textures into VRAM. To clean up, use UnloadTMX().
@@ -447,6 +580,91 @@ typedef struct tmx_map {
  */
 RAYTMX_DEC TmxMap* LoadTMX(const char* fileName);
 
+/**
+ * Given a TMX document already in memory, parse it and create an equivalent model just as LoadTMX() would. The buffer
+ * is parsed in place and may be freed, or reused, once this function returns. External files referenced by the map
+ * (TSX tilesets, TX templates, and images) are resolved relative to the virtual path and are loaded through the
+ * callbacks set with SetFileCallbacksTMX(), if any.
+ *
+ * @param data Contents of a TMX document. Need not be null-terminated.
+ * @param length Length of the TMX document, in bytes.
+ * @param virtualPath File name and/or path the document is treated as having, or NULL. Used to resolve relative paths.
+ * @return A model of the map as defined by the given TMX document, or NULL if loading failed for any reason.
+ */
+RAYTMX_DEC TmxMap* LoadTMXFromMemory(const char* data, size_t length, const char* virtualPath);
+
+/**
+ * Write a loaded map to a compact, versioned binary file that LoadTMXBinary() can load without parsing XML, decoding
+ * or decompressing tile data, applying templates, sorting objects, or laying out text. The file holds everything the
+ * map was built into, like its GIDs-to-tiles lookup and y-sorted objects, but not textures or fonts. The same map is
+ * always written as the same bytes, wherever it's written from. Images are referenced by paths relative to the binary
+ * file's directory so the file can be moved along with its images, except for images it has no relative path to (e.g.
+ * those on another drive) which are referenced by their full paths. Text objects only have lines to save if the map
+ * was loaded without LOAD_HEADLESS and maps loaded with LOAD_PACK_ATLAS can't be saved at all since their tiles refer
+ * to atlases rather than images.
+ *
+ * @param map The map to be written.
+ * @param fileName File name and/or path of the binary file to be written. An existing file is overwritten.
+ * @return True if the file was written, false otherwise.
+ */
+RAYTMX_DEC bool SaveTMXBinary(const TmxMap* map, const char* fileName);
+
+/**
+ * Load a map written by SaveTMXBinary(). The file is memory-mapped, or read through the callbacks set with
+ * SetFileCallbacksTMX(), and its arrays are copied into place with little more than bounds checks. Images are decoded
+ * and uploaded, and the load flags other than LOAD_VERIFY_CHECKSUMS and LOAD_CACHE_DOCUMENTS apply, just as with
+ * LoadTMX(). Images' paths are resolved against the directory of the binary file. To clean up, use UnloadTMX().
+ *
+ * @param fileName File name and/or path referencing a binary map written by SaveTMXBinary().
+ * @return A model of the map as it was saved, or NULL if loading failed for any reason.
+ */
+RAYTMX_DEC TmxMap* LoadTMXBinary(const char* fileName);
+
+/**
+ * Begin loading a TMX document without blocking the calling thread. The document is read and parsed, its tile layers
+ * are decoded, and its images are decoded on another thread. Textures, which must be created on the thread owning the
+ * graphics context, are then uploaded a few at a time by FinalizeLoadTMX(). File callbacks are called from the other
+ * thread. Load options and callbacks must not be changed until the load is finalized or canceled. If threads aren't
+ * available, as when RAYTMX_NO_THREADS is defined, everything but the uploading is done before this function returns.
+ * A relative file name is resolved against the working directory before this function returns. Paths are otherwise
+ * built in memory owned by each load so any number of loads, synchronous or not, may run at once.
+ *
+ * @param fileName File name and/or path referencing a TMX document to be loaded.
+ * @return A handle to the load to be passed to FinalizeLoadTMX() or CancelLoadTMX(), and GetLoadProgressTMX().
+ */
+RAYTMX_DEC TmxLoadTask* BeginLoadTMX(const char* fileName);
+
+/**
+ * Get the progress of a load begun with BeginLoadTMX(). This function may be called from any thread.
+ *
+ * @param task A load that is yet to be finalized or canceled.
+ * @return Counts of the work done so far.
+ */
+RAYTMX_DEC TmxLoadProgress GetLoadProgressTMX(const TmxLoadTask* task);
+
+/**
+ * Upload the textures of a load begun with BeginLoadTMX(), spending up to the given time doing so, and complete the
+ * load once all of them are uploaded. This is intended to be called once per frame, on the thread owning the graphics
+ * context, until it returns true. It returns false right away while the other thread is still working. At least one
+ * texture is uploaded per call, regardless of the time given, so that every call makes progress.
+ *
+ * @param task A load that is yet to be finalized or canceled. It is freed once this function returns true.
+ * @param timeBudget Time, in seconds, that may be spent uploading textures during this call.
+ * @param map Output for the loaded map, to be unloaded with UnloadTMX(), or NULL if loading failed for any reason. Only
+ *            set when this function returns true.
+ * @return True if the load is complete, successfully or not, or false if this function must be called again.
+ */
+RAYTMX_DEC bool FinalizeLoadTMX(TmxLoadTask* task, double timeBudget, TmxMap** map);
+
+/**
+ * Cancel a load begun with BeginLoadTMX(). The other thread is stopped, as soon as it can be, and waited for before
+ * everything loaded so far is freed along with the task itself. Once FinalizeLoadTMX() has been called, this must be
+ * called on the thread owning the graphics context so that any uploaded textures can be unloaded.
+ *
+ * @param task A load that is yet to be finalized or canceled.
+ */
+RAYTMX_DEC void CancelLoadTMX(TmxLoadTask* task);
+
 /**
  * Unload a given map model by freeing memory allocations and unloading textures. In other words, free the resources
  * reserved by LoadTMX().
@@ -462,6 +680,8 @@ RAYTMX_DEC void UnloadTMX(TmxMap* map);
  * come with it.
  * The given tint is applied to map and its layers. When layers have their own tints, the two colors are combined. If no
  * tint is needed, passing WHITE effectively means no tint is applied.
+ * Although the map is const, the geometry cached by its tile layers' chunks is built, or updated to match animations,
+ * as the chunks come into view. A map must therefore not be drawn while another thread is drawing or modifying it.
  *
  * @param map A loaded map model to be drawn in whole at the given coordinates.
  * @param camera (Optional) camera to be used for parallax and occlusion.
@@ -478,6 +698,7 @@ RAYTMX_DEC void DrawTMX(const TmxMap* map, const Camera2D* camera, int posX, int
  * come with it.
  * The given tint is applied to the layers. When layers have their own tints, the two colors are combined. If no tint is
  * needed, passing WHITE effectively means no tint is applied.
+ * As with DrawTMX(), the geometry cached by tile layers is built or updated while drawing.
  *
  * @param map A loaded map model to be drawn in part at the given coordinates.
  * @param camera (Optional) camera to be used for parallax and occlusion.
@@ -493,11 +714,101 @@ RAYTMX_DEC void DrawTMXLayers(const TmxMap* map, const Camera2D* camera, const T
 /**
  * Progress the animations of the given map in real-time. This is intended to be called once per frame, or once per
  * BeginDrawing() an EndDrawing() call. If called more or less frequently, animation speeds will be affected.
+ * Equivalent to AnimateTMXDelta() given the duration of the last frame, GetFrameTime().
  *
  * @param map A loaded map model to be animated.
  */
 RAYTMX_DEC void AnimateTMX(TmxMap* map);
 
+/**
+ * Progress the animations of the given map by the given amount of time. Unlike AnimateTMX(), this function does not
+ * depend on raylib's window or timing and so can be used without either, e.g. by a server or in a replay.
+ *
+ * @param map A loaded map model to be animated.
+ * @param dt Time, in seconds, by which to progress the animations.
+ */
+RAYTMX_DEC void AnimateTMXDelta(TmxMap* map, double dt);
+
+/**
+ * Set the animations of the given map to the frames they display at the given time. The result depends on nothing
+ * but the map and the time so, given the same times, any two instances of a map animate identically. The cost is the
+ * same no matter how much time has passed since the last call.
+ *
+ * @param map A loaded map model to be animated.
+ * @param timeSeconds Time, in seconds, at which to evaluate the animations. All animations begin at time zero.
+ */
+RAYTMX_DEC void AnimateTMXAt(TmxMap* map, double timeSeconds);
+
+/**
+ * Replace the tile at the given coordinates of a tile layer. The geometry cached for the surrounding chunk is rebuilt
+ * the next time it is drawn. Tile layers' 'tiles' arrays should be modified through this function. If they're written
+ * to directly, InvalidateTileLayerTMX() must be called afterward or the changes may not be drawn.
+ *
+ * @param layer A tile layer of a loaded map.
+ * @param x X coordinate, in tiles, of the tile to replace.
+ * @param y Y coordinate, in tiles, of the tile to replace.
+ * @param rawGid The Global ID (GID) of the new tile, possibly including flip flags, or zero to clear the tile.
+ */
+RAYTMX_DEC void SetTileTMX(TmxLayer* layer, uint32_t x, uint32_t y, uint32_t rawGid);
+
+/**
+ * Discard the geometry cached for a tile layer so that it's rebuilt from the layer's 'tiles' array the next time it is
+ * drawn. This is only needed after writing to the array directly, rather than through SetTileTMX(). Group layers have
+ * all of their tile layers, at any depth, invalidated.
+ *
+ * @param layer A tile or group layer of a loaded map.
+ */
+RAYTMX_DEC void InvalidateTileLayerTMX(TmxLayer* layer);
+
+/**
+ * Update an object group after its objects have moved. The order in which objects are drawn top-down is corrected and
+ * the group's spatial index is updated. Objects' 'aabb' fields should be moved along with their positions. Every
+ * object is checked, but the order and the index are only changed where objects have moved and nothing is allocated
+ * unless many objects have moved, in which case the index is rebuilt to suit their new positions.
+ *
+ * @param map The loaded map containing the layer.
+ * @param layer An object group layer of the map.
+ */
+RAYTMX_DEC void ResortObjectGroupTMX(const TmxMap* map, TmxLayer* layer);
+
+/**
+ * Find the objects of an object group whose bounds overlap the given rectangle. Bounds are the objects' AABBs or, for
+ * tile objects, the areas their tiles are drawn to. The spatial index built when the map was loaded is used so only
+ * objects near the rectangle are checked. The layer isn't modified so queries may be made while the map is drawn and
+ * from several threads at once.
+ *
+ * @param layer An object group layer of a loaded map.
+ * @param rec The area to search, in pixels, relative to the layer (i.e. in the same space as the objects' x and y).
+ * @param objectIndexes Array into which the indexes, within the layer's 'objects' array, of the objects found are
+ *                      written in ascending order. May be NULL to only count the objects.
+ * @param objectIndexesLength Length of the 'objectIndexes' array. No more than this many indexes are written.
+ * @return The number of objects found, which may be greater than 'objectIndexesLength.'
+ */
+RAYTMX_DEC uint32_t QueryObjectsRecTMX(const TmxLayer* layer, Rectangle rec, uint32_t* objectIndexes,
+    uint32_t objectIndexesLength);
+
+/**
+ * Find the objects of an object group whose bounds contain the given point, edges included. Otherwise the same as
+ * QueryObjectsRecTMX().
+ *
+ * @param layer An object group layer of a loaded map.
+ * @param point The point to search for, in pixels, relative to the layer.
+ * @param objectIndexes Array into which the indexes, within the layer's 'objects' array, of the objects found are
+ *                      written in ascending order. May be NULL to only count the objects.
+ * @param objectIndexesLength Length of the 'objectIndexes' array. No more than this many indexes are written.
+ * @return The number of objects found, which may be greater than 'objectIndexesLength.'
+ */
+RAYTMX_DEC uint32_t QueryObjectsPointTMX(const TmxLayer* layer, Vector2 point, uint32_t* objectIndexes,
+    uint32_t objectIndexesLength);
+
+/**
+ * Get counters of the work done by the most recent call to DrawTMX() or DrawTMXLayers(). Tiles sharing a texture are
+ * submitted together so, ideally, the number of batches is close to the number of distinct textures drawn.
+ *
+ * @return The number of quad batches begun and the number of quads submitted by the last draw call.
+ */
+RAYTMX_DEC TmxDrawStats GetDrawStatsTMX(void);
+
 /**
  * Log properties of the given map as a formatted string.
  * SetTraceLogFlagsTMX() may be used to exclude select information.
@@ -515,6 +826,50 @@ RAYTMX_DEC void TraceLogTMX(int logLevel, const TmxMap* map);
  */
 RAYTMX_DEC void SetTraceLogFlagsTMX(int logFlags);
 
+/**
+ * Globally set loading options for LoadTMX() allowing for optional behaviors like the packing of texture atlases.
+ * The flags used by this function are defined in the tmx_load_flags enumeration.
+ *
+ * @param loadFlags Logically OR'd bit flags to be applied to all loading following this call.
+ */
+RAYTMX_DEC void SetLoadFlagsTMX(int loadFlags);
+
+/**
+ * Globally set the number of threads LoadTMX() decodes and decompresses tile layer data, and decodes images, with.
+ * Each layer or image is decoded by one thread so no more threads than layers or images are used. Maps with little
+ * layer data are decoded without any additional threads. This has no effect if RAYTMX_NO_THREADS is defined.
+ *
+ * @param threadsCount Number of threads, including the calling thread, or zero (the default) for one per processor.
+ */
+RAYTMX_DEC void SetLoadThreadsTMX(int threadsCount);
+
+/**
+ * Globally set the callbacks through which LoadTMX() and LoadTMXFromMemory() read files. This includes TMX documents,
+ * external tilesets (TSX), object templates (TX), and images. Data returned by the load callback is only read, never
+ * modified, and is passed to the unload callback once it's no longer needed. Passing NULL for the load callback
+ * restores the default of reading from disk with raylib.
+ *
+ * @param loadFile Function returning the contents and length of the given file, or NULL if it couldn't be read.
+ * @param unloadFile Function releasing data returned by the load callback, or NULL if none is needed.
+ * @param userData Pointer passed through, as is, to both callbacks.
+ */
+RAYTMX_DEC void SetFileCallbacksTMX(TmxLoadFileCallback loadFile, TmxUnloadFileCallback unloadFile, void* userData);
+
+/**
+ * Free every external tileset (TSX) and object template (TX) held by the cache of LOAD_CACHE_DOCUMENTS. Maps already
+ * loaded are unaffected as they have copies of their own. This may be called from any thread.
+ */
+RAYTMX_DEC void FlushDocumentCacheTMX(void);
+
+/**
+ * Remove an external tileset (TSX) or object template (TX) from the cache of LOAD_CACHE_DOCUMENTS so that it's parsed
+ * again the next time a map references it. Files on disk are invalidated automatically when modified so this is
+ * mostly needed for files read through SetFileCallbacksTMX(). This may be called from any thread.
+ *
+ * @param fileName File name and/or path of the TSX or TX file, as it's referenced by maps: joined with their directory.
+ */
+RAYTMX_DEC void InvalidateDocumentCacheTMX(const char* fileName);
+
 #ifdef __cplusplus
     }
 #endif /* __cplusplus */
@@ -526,11 +881,90 @@ RAYTMX_DEC void SetTraceLogFlagsTMX(int logFlags);
 #endif
 #include "hoxml.h"
 
+#if !defined(RAYTMX_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define TMX_SSE2
+    #include <emmintrin.h> /* _mm_*() SSE2 intrinsics */
+#endif
+#if !defined(RAYTMX_NO_SIMD) && defined(__AVX2__)
+    #define TMX_AVX2
+    #include <immintrin.h> /* _mm256_*() AVX2 intrinsics */
+#endif
+#if defined(_MSC_VER)
+    #include <intrin.h> /* _BitScanForward64(), _InterlockedIncrement() */
+#endif
+#if !defined(RAYTMX_NO_THREADS) && defined(_WIN32) && (defined(_MSC_VER) || defined(__GNUC__))
+    #define TMX_THREADS
+    #define TMX_THREADS_WIN32
+    #include <process.h> /* _beginthreadex() */
+    #ifndef _WINDOWS_ /* If windows.h hasn't already been included */
+        /* Declared here rather than by including windows.h, whose names collide with raylib's. The signatures are */
+        /* the SDK's with its typedefs expanded (HANDLE, DWORD, BOOL, WORD, and PSRWLOCK) so that they still match */
+        /* should windows.h be included afterward. */
+        #ifdef __cplusplus
+        extern "C" {
+        #endif
+        struct _RTL_SRWLOCK;
+        __declspec(dllimport) unsigned long __stdcall WaitForSingleObject(void* hHandle, unsigned long dwMilliseconds);
+        __declspec(dllimport) int __stdcall CloseHandle(void* hObject);
+        __declspec(dllimport) unsigned long __stdcall GetActiveProcessorCount(unsigned short GroupNumber);
+        __declspec(dllimport) void __stdcall AcquireSRWLockExclusive(struct _RTL_SRWLOCK* SRWLock);
+        __declspec(dllimport) void __stdcall ReleaseSRWLockExclusive(struct _RTL_SRWLOCK* SRWLock);
+        #ifdef __cplusplus
+        }
+        #endif
+    #endif
+#elif !defined(RAYTMX_NO_THREADS) && (defined(__unix__) || defined(__APPLE__)) && defined(__GNUC__)
+    #define TMX_THREADS
+    #define TMX_THREADS_PTHREADS
+    #include <pthread.h> /* pthread_create(), pthread_join(), pthread_mutex_lock() */
+    #include <unistd.h> /* sysconf() */
+#endif
+#if !defined(RAYTMX_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+    #define TMX_MMAP
+    #include <fcntl.h> /* open() */
+    #include <sys/mman.h> /* mmap(), munmap() */
+    #include <sys/stat.h> /* fstat() */
+    #include <unistd.h> /* close() */
+#endif
+
 /******************/
 /* Implementation */
 
 #define TMX_LINE_THICKNESS 3.0f /* Thickness, in pixels, that outlines of specific objects are drawn with */
 
+#ifndef RAYTMX_ATLAS_MAX_SIZE
+    #define RAYTMX_ATLAS_MAX_SIZE 4096 /* Maximum width and height, in pixels, of packed texture atlases */
+#endif
+#define TMX_ARENA_BLOCK_SIZE 16384 /* Size, in bytes, of the first block parse state is allocated from */
+#define TMX_ARENA_ALIGNMENT 16 /* Alignment, in bytes, of every allocation made from an arena */
+#define TMX_INFLATE_FAST_BITS 10 /* Huffman codes up to this many bits long are decoded with a single table lookup */
+#define TMX_ZSTD_MAX_BLOCK_SIZE 131072 /* Largest decompressed size of a Zstandard block and of its literals */
+#define TMX_ZSTD_MAX_HUFFMAN_BITS 11 /* Longest code of Zstandard's Huffman-coded literals */
+#define TMX_ZSTD_MAX_FSE_ACCURACY 9 /* Largest accuracy log of Zstandard's FSE tables */
+#define TMX_ZSTD_MAX_FSE_SYMBOLS 256
+#define TMX_ROTL64(value, bits) (((value) << (bits)) | ((value) >> (64 - (bits))))
+#define TMX_QUERY_STACK_LENGTH 256 /* Most results an object query holds on the stack before allocating room for more */
+#define TMX_MAX_THREADS 64 /* Most threads layer data or images are decoded with, including the loading thread */
+#define TMX_THREADS_MIN_CONTENT 65536 /* Least layer data, in bytes of Base64 or CSV, worth starting threads for */
+#define TMX_PATH_LENGTH 512 /* Size, in bytes, of the buffers paths are built in */
+#define TMX_XML_NODE_SIZE 32 /* Bytes, at least, hoxml needs for each open element in addition to its strings */
+#define TMX_BINARY_MAGIC "RTMX" /* First four bytes of every binary map written by SaveTMXBinary() */
+#define TMX_BINARY_VERSION 2 /* Incremented whenever the layout of binary maps changes */
+#define TMX_BINARY_MAX_DEPTH 64 /* Deepest nesting of group layers read from a binary map */
+#if defined(_MSC_VER)
+    #define TMX_ATOMIC_INCREMENT(value) ((uint32_t)_InterlockedIncrement((volatile long*)(value)) - 1)
+    /* MSVC gives accesses to volatile variables acquire and release semantics by default */
+    #define TMX_ATOMIC_LOAD(value) (*(value))
+    #define TMX_ATOMIC_STORE(value, newValue) (*(value) = (newValue))
+#elif defined(__GNUC__)
+    #define TMX_ATOMIC_INCREMENT(value) __atomic_fetch_add((value), 1, __ATOMIC_RELAXED)
+    #define TMX_ATOMIC_LOAD(value) __atomic_load_n((value), __ATOMIC_ACQUIRE)
+    #define TMX_ATOMIC_STORE(value, newValue) __atomic_store_n((value), (newValue), __ATOMIC_RELEASE)
+#else /* Threads aren't used with other compilers */
+    #define TMX_ATOMIC_LOAD(value) (*(value))
+    #define TMX_ATOMIC_STORE(value, newValue) (*(value) = (newValue))
+#endif
+
 /* Bit flags that GIDs may be masked with in order to indicate transformations for individual tiles */
 enum tmx_flip_flags {
     FLIP_FLAG_HORIZONTAL = 0x80000000,
@@ -542,23 +976,55 @@ enum tmx_flip_flags {
 /* Declarations of some private stuff used to implement public stuff */
 typedef struct raytmx_external_tileset RaytmxExternalTileset;
 typedef struct raytmx_object_template RaytmxObjectTemplate;
+typedef struct raytmx_external_file RaytmxExternalFile;
+typedef struct raytmx_pending_texture RaytmxPendingTexture;
+typedef struct raytmx_shared_texture RaytmxSharedTexture;
+typedef struct raytmx_cached_document RaytmxCachedDocument;
 typedef struct raytmx_cached_texture RaytmxCachedTextureNode;
 typedef struct raytmx_cached_template RaytmxCachedTemplateNode;
+typedef struct raytmx_hash_slot RaytmxHashSlot;
+typedef struct raytmx_hash_table RaytmxHashTable;
 typedef struct raytmx_property_node RaytmxPropertyNode;
 typedef struct raytmx_tileset_node RaytmxTilesetNode;
 typedef struct raytmx_tileset_tile_node RaytmxTilesetTileNode;
 typedef struct raytmx_animation_frame_node RaytmxAnimationFrameNode;
 typedef struct raytmx_layer_node RaytmxLayerNode;
-typedef struct raytmx_tile_layer_tile_node RaytmxTileLayerTileNode;
+typedef struct raytmx_layer_tiles RaytmxLayerTiles;
+typedef struct raytmx_layer_data_node RaytmxLayerDataNode;
+typedef struct raytmx_layer_data_queue RaytmxLayerDataQueue;
+typedef struct raytmx_image_queue RaytmxImageQueue;
+typedef struct raytmx_thread_work RaytmxThreadWork;
 typedef struct raytmx_object_node RaytmxObjectNode;
-typedef struct raytmx_object_sorting_node RaytmxObjectSortingNode;
+typedef struct raytmx_object_sort_key RaytmxObjectSortKey;
 typedef struct raytmx_poly_point_node RaytmxPolyPointNode;
 typedef struct raytmx_text_line_node RaytmxTextLineNode;
+typedef struct raytmx_tile_quad RaytmxTileQuad;
+typedef struct raytmx_animated_quad RaytmxAnimatedQuad;
+typedef struct raytmx_atlas_entry RaytmxAtlasEntry;
+typedef struct raytmx_arena_block RaytmxArenaBlock;
+typedef struct raytmx_arena RaytmxArena;
+typedef struct raytmx_huffman RaytmxHuffman;
+typedef struct raytmx_inflater RaytmxInflater;
+typedef struct raytmx_fse_entry RaytmxFseEntry;
+typedef struct raytmx_fse_table RaytmxFseTable;
+typedef struct raytmx_zstd_huffman_entry RaytmxZstdHuffmanEntry;
+typedef struct raytmx_zstd_bits RaytmxZstdBits;
+typedef struct raytmx_zstd_decoder RaytmxZstdDecoder;
+typedef struct raytmx_binary_writer RaytmxBinaryWriter;
+typedef struct raytmx_binary_reader RaytmxBinaryReader;
 typedef enum raytmx_document_format {
     FORMAT_TMX = 0, /* Tilemap with tilesets, layers, etc. */
     FORMAT_TSX, /* External tilesets */
     FORMAT_TX /* Object templates */
 } RaytmxDocumentFormat;
+typedef enum raytmx_decompress_result {
+    DECOMPRESS_SUCCESS = 0,
+    DECOMPRESS_OUTPUT_FULL, /* The decompressed data doesn't fit in the given buffer */
+    DECOMPRESS_MALFORMED, /* The compressed data isn't valid or ended early */
+    DECOMPRESS_BAD_HEADER, /* The header of the compressed data is invalid or indicates another format */
+    DECOMPRESS_BAD_CHECKSUM, /* The decompressed data doesn't match the checksum given with the compressed data */
+    DECOMPRESS_UNSUPPORTED /* The compressed data uses a feature that isn't implemented, like Zstandard dictionaries */
+} RaytmxDecompressResult;
 typedef struct raytmx_external_tileset {
     TmxTileset tileset;
     bool isSuccess; /* 'isSuccess' is true when the external tileset was successfully loaded */
@@ -568,6 +1034,67 @@ typedef struct raytmx_object_template {
     TmxObject object;
     bool isSuccess, hasTileset; /* 'isSuccess' is true when the object template was successfully loaded */
 } RaytmxObjectTemplate;
+typedef struct raytmx_external_file {
+    const unsigned char* data;
+    size_t length;
+    bool isMapped; /* 'isMapped' is true when 'data' is a memory-mapped file rather than an allocation */
+} RaytmxExternalFile;
+typedef struct raytmx_hash_slot {
+    uint64_t hash; /* Hash of 'key', compared before the key itself */
+    const char* key; /* File name owned by 'value', or NULL if the slot is empty */
+    void* value;
+} RaytmxHashSlot;
+typedef struct raytmx_hash_table {
+    RaytmxHashSlot* slots; /* Open-addressed with linear probing */
+    uint32_t capacity; /* Number of slots, always a power of two */
+    uint32_t length; /* Number of slots in use, kept to at most three quarters of 'capacity' */
+} RaytmxHashTable; /* Index of a cache's nodes by file name */
+typedef struct raytmx_shared_texture {
+    char* path; /* Canonicalized path of the image the texture was uploaded from, or NULL if private to one map */
+    Texture2D texture;
+    uint32_t referencesCount; /* Tilesets, tiles, and image layers of loaded maps, and loads in progress, using it */
+    RaytmxSharedTexture* next;
+} RaytmxSharedTexture; /* Texture in the process-wide cache of LOAD_SHARE_TEXTURES */
+typedef struct raytmx_cached_document {
+    char* path; /* Canonicalized path of the TSX or TX file */
+    long modTime; /* Modification time of the file when it was parsed, or zero if unknown */
+    bool isHeadless; /* True if parsed with LOAD_HEADLESS, which reads images' dimensions from their files */
+    RaytmxObjectTemplate contents; /* The file's tileset, and object if a TX file, with all textures zeroized */
+    RaytmxCachedDocument* next;
+} RaytmxCachedDocument; /* External tileset or object template in the process-wide cache of LOAD_CACHE_DOCUMENTS */
+typedef struct raytmx_pending_texture {
+    char* path; /* File the image is decoded from, or NULL if the image was given already decoded */
+    char* canonicalPath; /* The path canonicalized, or NULL if the image was given already decoded */
+    RaytmxSharedTexture* sharedTexture; /* Shared texture, referenced by the load, standing in for this one, or NULL */
+    Image image; /* Decoded after parsing and unloaded once uploaded */
+    /* What placeholders of this texture resolve to: the placeholder with the image's dimensions once the image is */
+    /* decoded, the real texture once uploaded, or zeroes if the image couldn't be decoded */
+    Texture2D texture;
+    bool isUploaded;
+    bool isReferenced; /* True once the map is known to use the uploaded texture, making the map its owner */
+    bool isOwned; /* True once a tileset, tile, or image layer of the map has taken the uploaded texture */
+} RaytmxPendingTexture; /* Texture that is to be uploaded, along with all others, once loading is otherwise done */
+struct tmx_load_task {
+    char* fileName;
+    TmxMap* map; /* The map built by the loading thread, or NULL if loading failed */
+    /* Until uploaded, the textures of the map, atlases included, have the indexes of these plus one as their IDs. */
+    /* Synchronous loads use them too, with a task of their own, so that images can be decoded all at once. */
+    RaytmxPendingTexture* pendingTextures;
+    uint32_t pendingTexturesLength, pendingTexturesCapacity;
+    RaytmxHashTable pendingTexturesTable; /* Index of the placeholder IDs of 'pendingTextures' by canonical path */
+    bool isSharingTextures; /* True if LOAD_SHARE_TEXTURES was set when loading began */
+    bool isCachingDocuments; /* True if LOAD_CACHE_DOCUMENTS was set when loading began */
+    /* Progress and signals shared between the loading thread and the thread finalizing or canceling the load */
+    volatile size_t bytesParsed, bytesTotal;
+    volatile uint32_t layersDecoded, layersTotal, imagesDecoded, imagesTotal, texturesUploaded;
+    volatile bool isLoaded, isCanceled;
+#if defined(TMX_THREADS_PTHREADS)
+    pthread_t thread;
+#elif defined(TMX_THREADS_WIN32)
+    uintptr_t thread;
+#endif
+    bool hasThread; /* False once the loading thread has been joined, or if it was never started */
+}; /* An asynchronous load begun with BeginLoadTMX(). Declared publicly as TmxLoadTask. */
 typedef struct raytmx_cached_texture {
     char* fileName;
     Texture2D texture;
@@ -599,19 +1126,48 @@ typedef struct raytmx_layer_node {
     uint32_t childrenLength;
     RaytmxLayerNode *next, *parent, *childrenRoot, *childrenTail;
 } RaytmxLayerNode;
-typedef struct raytmx_tile_layer_tile_node {
-    uint32_t gid;
-    RaytmxTileLayerTileNode* next;
-} RaytmxTileLayerTileNode;
+typedef struct raytmx_layer_tiles {
+    uint32_t* gids;
+    uint32_t length, capacity;
+} RaytmxLayerTiles; /* Growable array of a tile layer's GIDs */
+typedef struct raytmx_layer_data_node {
+    TmxLayer* layer; /* The tile layer the data belongs to */
+    const char* content; /* The <data> element's content, Base64 or CSV */
+    size_t contentLength;
+    bool isContentCopied; /* True if 'content' is a copy, freed once it's decoded, rather than part of the document */
+    uint32_t line; /* Line the <data> element ended on, for reporting where CSV is malformed */
+    RaytmxLayerTiles tiles;
+    bool isDecoded; /* False if the Base64 couldn't be decoded or the CSV couldn't be parsed */
+    RaytmxDecompressResult decompressResult;
+    size_t errorOffset; /* Offset of the first malformed character of CSV content */
+    RaytmxLayerDataNode* next;
+} RaytmxLayerDataNode;
+typedef struct raytmx_layer_data_queue {
+    RaytmxLayerDataNode** nodes; /* The layer data to decode, largest first */
+    uint32_t nodesLength;
+    uint32_t nextNode; /* Index of the next node to be taken by a thread, incremented atomically */
+    TmxLoadTask* task; /* The load to report decoded layers to, or NULL */
+} RaytmxLayerDataQueue;
+typedef struct raytmx_image_queue {
+    const char** paths; /* Files to decode images from */
+    Image* images; /* Decoded images, with NULL data for those that couldn't be decoded, in the order of 'paths' */
+    uint32_t imagesLength;
+    uint32_t nextImage; /* Index of the next image to be taken by a thread, incremented atomically */
+    int format; /* Pixel format images are converted to, or zero to keep the files' formats */
+    TmxLoadTask* task; /* The load to report decoded images to and to stop early if canceled, or NULL */
+} RaytmxImageQueue;
+typedef struct raytmx_thread_work {
+    void (*run)(void* queue); /* Takes from the queue until it's empty */
+    void* queue;
+} RaytmxThreadWork;
 typedef struct raytmx_object_node {
     TmxObject object;
     RaytmxObjectNode* next;
 } RaytmxObjectNode;
-typedef struct raytmx_object_sorting_node {
+typedef struct raytmx_object_sort_key {
     double y;
     uint32_t index;
-    RaytmxObjectSortingNode* next;
-} RaytmxObjectSortingNode;
+} RaytmxObjectSortKey;
 typedef struct raytmx_poly_point_node {
     Vector2 point;
     RaytmxPolyPointNode* next;
@@ -620,14 +1176,118 @@ typedef struct raytmx_text_line_node {
     TmxTextLine line;
     RaytmxTextLineNode* next;
 } RaytmxTextLineNode;
+typedef struct raytmx_tile_quad {
+    Vector2 positions[4]; /* Corners relative to the position of the layer, in the order they're submitted */
+    Vector2 texcoords[4]; /* Normalized texture coordinates corresponding to 'positions' */
+    unsigned int textureId; /* Zero when there is nothing to draw, like an animation frame without a texture */
+} RaytmxTileQuad; /* Pre-calculated values needed to submit one tile to rlgl */
+typedef struct raytmx_animated_quad {
+    uint32_t tileIndex; /* Index of the animated tile within the layer's 'tiles' array */
+    uint32_t quadIndex; /* Index of the quad, within the chunk, drawn for the tile */
+    int32_t gid; /* Display GID, see TmxMap.displayGids, the quad was last built from */
+} RaytmxAnimatedQuad; /* Associates a chunk's quad with an animated tile so the quad can follow the animation */
+struct tmx_tile_chunk {
+    RaytmxTileQuad* quads; /* Quads of the chunk's non-empty tiles in right-down order */
+    uint32_t quadsLength;
+    uint16_t rowStarts[RAYTMX_CHUNK_SIZE + 1]; /* Index of the first quad of each row, plus the end of the last row */
+    RaytmxAnimatedQuad* animatedQuads;
+    uint32_t animatedQuadsLength;
+    Rectangle bounds; /* Area covered by all quads relative to the position of the layer */
+    bool isBuilt; /* False until the quads are built and again whenever a tile of the chunk is replaced */
+    bool isFullyVisible; /* Set while drawing to skip the visibility checks of individual quads */
+}; /* Cached geometry for an area of a tile layer. Declared publicly as TmxTileChunk. */
+struct tmx_object_index {
+    Rectangle* bounds; /* Area each object may be drawn to relative to the position of the layer */
+    float left, top; /* Position of the grid's top-left corner */
+    float cellWidth, cellHeight;
+    uint32_t columns, rows;
+    uint32_t* cellStarts; /* Index of each cell's first entry in 'cellObjects', plus the end of the last cell */
+    uint32_t* cellObjects; /* Indexes of the objects overlapping each cell, in ascending order within a cell */
+    uint32_t* topDownRanks; /* Position of each object within the group's 'ySortedObjects' array */
+    uint32_t* candidates; /* Scratch space, the length of the group's 'objects' array, for drawing. Queries, which may */
+                          /* be made while drawing or from several threads, use their own. */
+}; /* Uniform grid over the objects of an object group. Declared publicly as TmxObjectIndex. */
+typedef struct raytmx_atlas_entry {
+    uint32_t gid; /* GID of the tile whose pixels this entry holds, also used to keep the packing deterministic */
+    uint32_t image; /* Index of the source image */
+    int32_t sourceX, sourceY; /* Position of the tile within the source image */
+    int32_t width, height; /* Dimensions of the tile, not including the extruded border */
+    int32_t x, y; /* Position of the extruded border within the atlas */
+    uint32_t page; /* Index of the atlas the entry was packed into, or UINT32_MAX if it didn't fit in any */
+} RaytmxAtlasEntry; /* One tile's area within a texture atlas */
+typedef struct raytmx_arena_block {
+    RaytmxArenaBlock* next;
+    size_t used, capacity; /* Bytes handed out from, and available in, the memory following the block's header */
+} RaytmxArenaBlock;
+typedef struct raytmx_arena {
+    RaytmxArenaBlock* blocks; /* The most recently allocated, and only partially used, block comes first */
+} RaytmxArena; /* Bump allocator for memory that is freed all at once, like the nodes of the parsing state */
+typedef struct raytmx_huffman {
+    uint16_t fast[1 << TMX_INFLATE_FAST_BITS]; /* Code length << 9 | symbol, indexed by the next bits of input */
+    uint16_t firstCodes[16], firstSymbols[16]; /* First code of each length and the index of its symbol */
+    uint32_t maxCodes[17]; /* One past the last code of each length, left-aligned to 16 bits */
+    uint8_t lengths[288]; /* Code length of each symbol in 'symbols' */
+    uint16_t symbols[288]; /* Symbols sorted by code */
+    uint32_t symbolsLength;
+} RaytmxHuffman; /* Decoding table of a canonical Huffman code used by DEFLATE */
+typedef struct raytmx_inflater {
+    const unsigned char *input, *inputEnd;
+    uint64_t bits; /* Bits read from the input but not yet used, least significant first */
+    uint32_t bitsLength;
+    unsigned char *output, *outputStart, *outputEnd;
+    RaytmxHuffman literals, distances;
+    bool isTruncated; /* Set when more bits are needed than the input has left */
+} RaytmxInflater; /* State of decompressing a single DEFLATE stream into a buffer of known size */
+typedef struct raytmx_fse_entry {
+    uint16_t baseline; /* Added to the next 'bitsLength' bits of input to get the next state */
+    uint8_t symbol, bitsLength;
+} RaytmxFseEntry; /* One state of a Finite State Entropy (FSE) decoding table */
+typedef struct raytmx_fse_table {
+    RaytmxFseEntry entries[1 << TMX_ZSTD_MAX_FSE_ACCURACY];
+    uint32_t accuracyLog; /* The table has 2^accuracyLog states */
+    bool isDefined; /* False until a block defines the table, after which blocks may repeat it */
+} RaytmxFseTable;
+typedef struct raytmx_zstd_huffman_entry {
+    uint8_t symbol, bitsLength;
+} RaytmxZstdHuffmanEntry;
+typedef struct raytmx_zstd_bits {
+    const unsigned char *start, *current; /* The data and where 'container' was last loaded from */
+    uint64_t container;
+    uint32_t consumed; /* Bits of 'container' already read, from the most significant down */
+} RaytmxZstdBits; /* Reader of bits written backward, as Zstandard's entropy-coded streams are */
+typedef struct raytmx_zstd_decoder {
+    RaytmxFseTable literalLengths, offsets, matchLengths;
+    RaytmxZstdHuffmanEntry huffmanTable[1 << TMX_ZSTD_MAX_HUFFMAN_BITS]; /* Indexed by the next 'huffmanBits' bits */
+    uint32_t huffmanBits;
+    bool hasHuffmanTable;
+    uint32_t repeatOffsets[3]; /* The three most recent match offsets, most recent first */
+    const unsigned char* literals; /* Literals of the current block, either within the block or 'literalsBuffer' */
+    size_t literalsLength;
+    unsigned char* literalsBuffer;
+    unsigned char *output, *outputStart, *outputEnd; /* 'outputStart' is the start of the current frame's output */
+} RaytmxZstdDecoder; /* State of decompressing Zstandard frames into a buffer of known size */
+typedef struct raytmx_binary_writer {
+    unsigned char* data;
+    size_t length, capacity;
+    const char* directory; /* Directory of the file being written, which image paths are saved relative to */
+} RaytmxBinaryWriter; /* Growable buffer a map is written into by SaveTMXBinary() */
+typedef struct raytmx_binary_reader {
+    const unsigned char* data;
+    size_t length, offset;
+    bool isValid; /* Cleared, and left cleared, once anything is read past the end of the data or is out of range */
+    const char* directory; /* Directory of the file being read, which saved image paths are relative to */
+} RaytmxBinaryReader; /* Position within a binary map being read by LoadTMXBinary() */
 typedef struct raytmx_state {
     RaytmxDocumentFormat format;
-    char documentDirectory[512];
+    char documentDirectory[TMX_PATH_LENGTH];
     bool isSuccess;
+    TmxLoadTask* task; /* The load the document is parsed for, which holds the textures to be uploaded */
 
     /* Variables intended for TMX (map) parsing */
     RaytmxCachedTextureNode* texturesRoot;
+    RaytmxHashTable texturesTable; /* Index of the nodes of 'texturesRoot' */
     RaytmxCachedTemplateNode* templatesRoot;
+    RaytmxHashTable templatesTable; /* Index of the nodes of 'templatesRoot' */
     TmxOrientation mapOrientation;
     TmxRenderOrder mapRenderOrder;
     uint32_t mapWidth, mapHeight, mapTileWidth, mapTileHeight, mapPropertiesLength;
@@ -651,21 +1311,38 @@ typedef struct raytmx_state {
     TmxObject* object;
 
     /* These variables are linked lists containing various elements where an arbitrary amount are allowed, such as */
-    /* 1+ <object> elements in an <objectgroup>, that will be copied to arrays of known sizes later on */
+    /* 1+ <object> elements in an <objectgroup>, that will be copied to arrays of known sizes later on. Their nodes */
+    /* are allocated from 'arena' and are never freed individually. */
     RaytmxPropertyNode *propertiesRoot, *propertiesTail;
     RaytmxTilesetNode *tilesetsRoot, *tilesetsTail;
     RaytmxTilesetTileNode *tilesetTilesRoot, *tilesetTilesTail;
     RaytmxAnimationFrameNode *animationFramesRoot, *animationFramesTail;
     RaytmxLayerNode *layersRoot, *layersTail, *groupNode;
-    RaytmxTileLayerTileNode *layerTilesRoot, *layerTilesTail;
     RaytmxObjectNode *objectsRoot, *objectsTail;
     uint32_t tilesetsLength, tilesetTilesLength, animationFramesLength, propertiesLength, layersLength,
-        layerTilesLength, objectsLength, propertiesDepth;
+        objectsLength, propertiesDepth;
+    RaytmxArena arena;
+
+    /* GIDs of the current tile layer. Tile layers are usually filled exactly so this array, sized ahead of time by */
+    /* the layer's dimensions, is handed to the layer as its 'tiles' array when the layer ends. */
+    RaytmxLayerTiles layerTiles;
+
+    /* Tile layer data captured during parsing, to be decoded once the whole document has been parsed. Its nodes are */
+    /* allocated from 'arena' but their content and GIDs are not. */
+    RaytmxLayerDataNode *layerDataRoot, *layerDataTail;
+    uint32_t layerDataLength;
+
+    /* Content of the current <data> element when it's taken directly from the document rather than parsed by hoxml */
+    const char* layerDataContent;
+    size_t layerDataContentLength;
 } RaytmxState; /* Intermediate data used internally to parse TMX (map), TSX (tileset), and TX (template) files */
 
-RaytmxExternalTileset LoadTSX(const char* fileName);
-RaytmxObjectTemplate LoadTX(const char* fileName);
-void ParseDocument(RaytmxState* raytmxState, const char* fileName);
+TmxMap* LoadMapFromMemory(const char* data, size_t length, const char* virtualPath, TmxLoadTask* task);
+RaytmxExternalTileset LoadTSX(const char* fileName, TmxLoadTask* task);
+RaytmxObjectTemplate LoadTX(const char* fileName, TmxLoadTask* task);
+void ParseDocumentFile(RaytmxState* raytmxState, const char* fileName);
+void ParseDocument(RaytmxState* raytmxState, const char* content, size_t contentLength, const char* fileName);
+size_t GetXmlBufferLength(const char* content, size_t contentLength);
 void HandleElementBegin(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext);
 void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext);
 void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext);
@@ -675,54 +1352,498 @@ void FreeTileset(TmxTileset tileset);
 void FreeProperty(TmxProperty property);
 void FreeLayer(TmxLayer layer);
 void FreeObject(TmxObject object);
+void DrawTMXLayerList(const TmxMap* map, const Camera2D* camera, const TmxLayer* layers, uint32_t layersLength,
+    int posX, int posY, Color tint);
 void DrawTMXTileLayer(const TmxMap* map, Rectangle screenRect, TmxLayer layer, int posX, int posY, Color tint);
 void DrawTMXLayerTile(const TmxMap* map, Rectangle screenRect, int32_t rawGid, int posX, int posY, Color tint);
+void DrawTextureTile(const TmxTile* tile, Rectangle dest, uint32_t flipIndex, Color tint);
+void GetTextureTileQuad(const TmxTile* tile, Rectangle dest, uint32_t flipIndex, RaytmxTileQuad* quad);
+void UpdateDisplayGids(TmxMap* map);
+void SetTileTexcoords(TmxMap* map);
+bool GetLayerTileQuad(const TmxMap* map, uint32_t rawGid, uint32_t x, uint32_t y, RaytmxTileQuad* quad);
+void SubmitTileQuad(const RaytmxTileQuad* quad, float posX, float posY, Color tint);
+void BuildTileChunk(const TmxMap* map, const TmxTileLayer* tileLayer, TmxTileChunk* chunk, uint32_t chunkX,
+    uint32_t chunkY);
+void UpdateTileChunkAnimations(const TmxMap* map, const TmxTileLayer* tileLayer, TmxTileChunk* chunk);
+void FreeTileChunk(TmxTileChunk* chunk);
+void PackTilesetAtlases(TmxMap* map, const TmxImage** gidsToImages, TmxLoadTask* task);
+uint32_t PackAtlasEntries(RaytmxAtlasEntry* entries, uint32_t entriesLength, int32_t maxSize, int32_t* pagesWidth,
+    int32_t* pagesHeights);
+int CompareAtlasEntries(const void* a, const void* b);
+void BlitAtlasEntry(Image* page, const Image* image, const RaytmxAtlasEntry* entry);
 void DrawTMXObjectTile(const TmxMap* map, Rectangle screenRect, int32_t rawGid, int posX, int posY, float width,
     float height, Color tint);
 void DrawTMXObjectGroup(const TmxMap* map, Rectangle screenRect, TmxLayer layer, int posX, int posY, Color tint);
+void DrawTMXObject(const TmxMap* map, Rectangle screenRect, const TmxObjectGroup* objectGroup, TmxObject object,
+    int posX, int posY, Color tint);
+void BuildObjectIndexes(const TmxMap* map, TmxLayer* layers, uint32_t layersLength);
+TmxObjectIndex* BuildObjectIndex(const TmxMap* map, const TmxObjectGroup* objectGroup);
+bool UpdateObjectIndex(const TmxMap* map, const TmxObjectGroup* objectGroup);
+bool GetObjectIndexBounds(const TmxMap* map, const TmxObject* object, Rectangle* bounds);
+void FillObjectIndexCells(TmxObjectIndex* index, uint32_t objectsLength);
+void GetObjectIndexCells(const TmxObjectIndex* index, Rectangle area, uint32_t* firstColumn, uint32_t* lastColumn,
+    uint32_t* firstRow, uint32_t* lastRow);
+uint32_t QueryObjectIndex(const TmxObjectIndex* index, Rectangle area, bool isPoint, bool isExact,
+    uint32_t* candidates);
+uint32_t QueryObjects(const TmxObjectGroup* objectGroup, Rectangle area, bool isPoint, uint32_t* objectIndexes,
+    uint32_t objectIndexesLength);
+void FreeObjectIndex(TmxObjectIndex* index);
+int CompareIndexes(const void* a, const void* b);
+int CompareObjectSortKeys(const void* a, const void* b);
+void EndTileBatch(void);
 void TraceLogTMXTilesets(int logLevel, TmxOrientation orientation, TmxTileset* tilesets, uint32_t tilesetsLength,
     int numSpaces);
 void TraceLogTMXProperties(int logLevel, TmxProperty* properties, uint32_t propertiesLength, int numSpaces);
 void TraceLogTMXLayers(int logLevel, TmxLayer* layers, uint32_t layersLength, int numSpaces);
 void StringCopy(char* destination, const char* source);
 TmxProperty* AddProperty(RaytmxState* raytmxState);
-void AddTileLayerTile(RaytmxState* raytmxState, uint32_t gid);
+void ReserveTileLayerTiles(RaytmxLayerTiles* layerTiles, uint32_t capacity);
+void AddTileLayerTile(RaytmxLayerTiles* layerTiles, uint32_t gid);
+void AddTileLayerTiles(RaytmxLayerTiles* layerTiles, const uint32_t* gids, uint32_t gidsLength);
+void SetTileLayerTiles(TmxLayer* layer, RaytmxLayerTiles* layerTiles);
+void AddLayerData(RaytmxState* raytmxState, const hoxml_context_t* hoxmlContext);
+const char* FindLayerDataContent(RaytmxState* raytmxState, const hoxml_context_t* hoxmlContext, const char* end);
 TmxTileset* AddTileset(RaytmxState* raytmxState);
 TmxTilesetTile* AddTilesetTile(RaytmxState* raytmxState);
 TmxAnimationFrame* AddAnimationFrame(RaytmxState* raytmxState);
 TmxLayer* AddGenericLayer(RaytmxState* raytmxState, bool isGroup);
 TmxObject* AddObject(RaytmxState* raytmxState);
+void* AllocFromArena(RaytmxArena* arena, size_t size);
+void FreeArena(RaytmxArena* arena);
 void AppendLayerTo(TmxMap* map, RaytmxLayerNode* groupNode, RaytmxLayerNode* layersRoot, uint32_t layersLength);
 RaytmxCachedTextureNode* LoadCachedTexture(RaytmxState* raytmxState, const char* fileName);
+RaytmxExternalFile LoadExternalFile(const char* fileName);
+void UnloadExternalFile(RaytmxExternalFile file);
+Image LoadExternalImage(const char* fileName);
+bool ReadImageFileDimensions(const char* fileName, uint32_t* width, uint32_t* height);
+bool GetImageDimensions(const unsigned char* data, size_t dataLength, uint32_t* width, uint32_t* height);
 RaytmxCachedTemplateNode* LoadCachedTemplate(RaytmxState* raytmxState, const char* fileName);
+void* FindInHashTable(const RaytmxHashTable* table, const char* key, uint64_t hash);
+void AddToHashTable(RaytmxHashTable* table, const char* key, uint64_t hash, void* value);
+void FreeHashTable(RaytmxHashTable* table);
+uint64_t GetStringHash(const char* str);
+void RunLoadTask(TmxLoadTask* task);
+#if defined(TMX_THREADS_PTHREADS)
+void* RunLoadTaskThread(void* task);
+#elif defined(TMX_THREADS_WIN32)
+unsigned __stdcall RunLoadTaskThread(void* task);
+#endif
+void JoinLoadTask(TmxLoadTask* task);
+void FreeLoadTask(TmxLoadTask* task);
+void FreePendingTextures(TmxLoadTask* task);
+bool IsLoadCanceled(TmxLoadTask* task);
+Texture2D AddPendingTexture(TmxLoadTask* task, const char* path);
+Texture2D AddDecodedTexture(TmxLoadTask* task, Image* image);
+void DecodePendingTextures(TmxLoadTask* task);
+void UploadPendingTexture(TmxLoadTask* task);
+void DecodeImages(RaytmxImageQueue* queue);
+void RunImageQueue(void* queue);
+void ResolveTaskTextures(TmxLoadTask* task, TmxMap* map);
+void ResolveTaskLayerTextures(TmxLoadTask* task, TmxLayer* layers, uint32_t layersLength);
+void ResolveTaskTexture(TmxLoadTask* task, Texture2D* texture, bool isOwner);
+void DetachTilesetTextures(TmxTileset* tileset);
+RaytmxSharedTexture* AcquireSharedTexture(const char* canonicalPath);
+RaytmxSharedTexture* AddSharedTexture(const char* canonicalPath, Texture2D texture);
+void ReleaseSharedTexture(RaytmxSharedTexture* sharedTexture);
+void ReleaseTexture(Texture2D texture);
+void LockCaches(void);
+void UnlockCaches(void);
+char* CanonicalizePath(const char* path);
+char* GetRelativePath(const char* path, const char* directory);
+bool CopyCachedDocument(const char* canonicalPath, long modTime, TmxLoadTask* task, RaytmxObjectTemplate* contents);
+void AddCachedDocument(const char* canonicalPath, long modTime, const RaytmxObjectTemplate* contents);
+void FreeCachedDocument(RaytmxCachedDocument* cachedDocument);
+long GetDocumentModTime(const char* fileName);
+TmxTileset CopyTileset(const TmxTileset* tileset, TmxLoadTask* task);
+TmxObject CopyObject(const TmxObject* object);
+TmxProperty* CopyProperties(const TmxProperty* properties, uint32_t propertiesLength);
+char* CopyString(const char* str);
+void AddBinaryMapTextures(TmxMap* map, TmxLoadTask* task, bool isPackingAtlases);
+void AddBinaryLayerTextures(TmxLoadTask* task, RaytmxHashTable* images, TmxLayer* layers, uint32_t layersLength);
+void AddBinaryImageTexture(TmxLoadTask* task, RaytmxHashTable* images, TmxImage* image);
+void GetTileImages(const TmxMap* map, const TmxImage** gidsToImages);
+void WriteBinaryMap(RaytmxBinaryWriter* writer, const TmxMap* map);
+void WriteBinaryTileset(RaytmxBinaryWriter* writer, const TmxTileset* tileset);
+void WriteBinaryLayers(RaytmxBinaryWriter* writer, const TmxLayer* layers, uint32_t layersLength);
+void WriteBinaryObject(RaytmxBinaryWriter* writer, const TmxObject* object);
+void WriteBinaryTile(RaytmxBinaryWriter* writer, const TmxMap* map, const TmxTile* tile);
+void WriteBinaryImage(RaytmxBinaryWriter* writer, const TmxImage* image);
+void WriteBinaryAnimation(RaytmxBinaryWriter* writer, const TmxAnimation* animation);
+void WriteBinaryProperties(RaytmxBinaryWriter* writer, const TmxProperty* properties, uint32_t propertiesLength);
+void WriteBinaryString(RaytmxBinaryWriter* writer, const char* str);
+void WriteBinaryU32s(RaytmxBinaryWriter* writer, const uint32_t* values, uint32_t valuesLength);
+void WriteBinaryU32(RaytmxBinaryWriter* writer, uint32_t value);
+void WriteBinaryU64(RaytmxBinaryWriter* writer, uint64_t value);
+void WriteBinaryFloat(RaytmxBinaryWriter* writer, float value);
+void WriteBinaryDouble(RaytmxBinaryWriter* writer, double value);
+void WriteBinaryBool(RaytmxBinaryWriter* writer, bool value);
+void WriteBinaryColor(RaytmxBinaryWriter* writer, Color value);
+void WriteBinaryBytes(RaytmxBinaryWriter* writer, const void* bytes, size_t bytesLength);
+void ReadBinaryMap(RaytmxBinaryReader* reader, TmxMap* map);
+void ReadBinaryTileset(RaytmxBinaryReader* reader, TmxTileset* tileset);
+void ReadBinaryLayers(RaytmxBinaryReader* reader, const TmxMap* map, TmxLayer** layers, uint32_t* layersLength,
+    uint32_t depth);
+void ReadBinaryObject(RaytmxBinaryReader* reader, TmxObject* object);
+void ReadBinaryTile(RaytmxBinaryReader* reader, const TmxMap* map, TmxTile* tile);
+void ReadBinaryImage(RaytmxBinaryReader* reader, TmxImage* image);
+void ReadBinaryAnimation(RaytmxBinaryReader* reader, TmxAnimation* animation);
+TmxProperty* ReadBinaryProperties(RaytmxBinaryReader* reader, uint32_t* propertiesLength);
+char* ReadBinaryString(RaytmxBinaryReader* reader);
+uint32_t* ReadBinaryU32s(RaytmxBinaryReader* reader, uint32_t valuesLength);
+uint32_t ReadBinaryLength(RaytmxBinaryReader* reader, size_t minElementSize);
+uint32_t ReadBinaryU32(RaytmxBinaryReader* reader);
+uint64_t ReadBinaryU64(RaytmxBinaryReader* reader);
+float ReadBinaryFloat(RaytmxBinaryReader* reader);
+double ReadBinaryDouble(RaytmxBinaryReader* reader);
+bool ReadBinaryBool(RaytmxBinaryReader* reader);
+Color ReadBinaryColor(RaytmxBinaryReader* reader);
+const unsigned char* ReadBinaryBytes(RaytmxBinaryReader* reader, size_t bytesLength);
+bool IsLittleEndian(void);
+void DecodeTileLayers(RaytmxState* raytmxState);
+uint32_t GetLoadThreadsLength(void);
+void RunOnLoadThreads(RaytmxThreadWork* work, uint32_t threadsLength);
+#if defined(TMX_THREADS_PTHREADS)
+void* RunLoadThread(void* work);
+#elif defined(TMX_THREADS_WIN32)
+unsigned __stdcall RunLoadThread(void* work);
+#endif
+void RunLayerDataQueue(void* queue);
+void DecodeLayerData(RaytmxLayerDataNode* node);
+void LogLayerDataErrors(const RaytmxLayerDataNode* node);
+int CompareLayerDataSizes(const void* a, const void* b);
 Color GetColorFromHexString(const char* hex);
+size_t GetBase64DecodedLength(const char* encoded, size_t encodedLength);
+bool DecodeBase64(const char* encoded, size_t encodedLength, unsigned char* decoded, size_t decodedCapacity,
+    size_t* decodedLength);
+#ifdef TMX_SSE2
+size_t DecodeBase64SSE2(const char* encoded, size_t encodedLength, unsigned char* decoded, size_t decodedCapacity);
+#endif
+#ifdef TMX_AVX2
+size_t DecodeBase64AVX2(const char* encoded, size_t encodedLength, unsigned char* decoded, size_t decodedCapacity);
+#endif
+bool ParseCsvGids(RaytmxLayerTiles* layerTiles, const char* csv, size_t csvLength, size_t* errorOffset);
+uint64_t GetCsvWindowMasks(const char* window, uint32_t windowLength, uint64_t* digits, uint64_t* commas);
+uint32_t CountTrailingZeros64(uint64_t value);
+RaytmxDecompressResult DecompressLayerData(RaytmxLayerTiles* layerTiles, const char* compression,
+    const unsigned char* data, size_t dataLength);
+size_t GetGzipHeaderLength(const unsigned char* data, size_t dataLength);
+size_t GetZlibHeaderLength(const unsigned char* data, size_t dataLength);
+RaytmxDecompressResult InflateData(const unsigned char* compressed, size_t compressedLength,
+    unsigned char* decompressed, size_t decompressedCapacity, size_t* decompressedLength, size_t* compressedUsed);
+bool IsChecksumValid(const unsigned char* trailer, size_t trailerLength, const unsigned char* data, size_t dataLength,
+    bool isGzip);
+RaytmxDecompressResult InflateStoredBlock(RaytmxInflater* inflater);
+RaytmxDecompressResult InflateFixedBlock(RaytmxInflater* inflater);
+RaytmxDecompressResult InflateDynamicBlock(RaytmxInflater* inflater);
+RaytmxDecompressResult InflateHuffmanBlock(RaytmxInflater* inflater);
+bool BuildHuffmanTable(RaytmxHuffman* huffman, const uint8_t* codeLengths, uint32_t codeLengthsLength);
+int32_t DecodeHuffmanSymbol(RaytmxInflater* inflater, const RaytmxHuffman* huffman);
+uint32_t GetInflaterBits(RaytmxInflater* inflater, uint32_t bitsLength);
+void RefillInflaterBits(RaytmxInflater* inflater);
+uint32_t ReverseBits16(uint32_t value);
+unsigned char* CopyMatch(unsigned char* output, const unsigned char* outputEnd, size_t distance, size_t length);
+uint32_t GetCrc32(const unsigned char* data, size_t dataLength);
+uint32_t GetAdler32(const unsigned char* data, size_t dataLength);
+RaytmxDecompressResult DecompressZstd(const unsigned char* compressed, size_t compressedLength,
+    unsigned char* decompressed, size_t decompressedCapacity, size_t* decompressedLength, bool isChecksumVerified);
+RaytmxDecompressResult DecompressZstdFrame(RaytmxZstdDecoder* decoder, const unsigned char** input,
+    const unsigned char* inputEnd, bool isChecksumVerified);
+RaytmxDecompressResult DecompressZstdBlock(RaytmxZstdDecoder* decoder, const unsigned char* block,
+    size_t blockLength);
+bool DecodeZstdLiterals(RaytmxZstdDecoder* decoder, const unsigned char* block, size_t blockLength,
+    size_t* sectionLength);
+bool ReadZstdHuffmanTable(RaytmxZstdDecoder* decoder, const unsigned char* data, size_t dataLength,
+    size_t* descriptionLength);
+bool DecodeZstdHuffmanStream(const RaytmxZstdDecoder* decoder, const unsigned char* stream, size_t streamLength,
+    unsigned char* output, size_t outputLength);
+RaytmxDecompressResult DecodeZstdSequences(RaytmxZstdDecoder* decoder, const unsigned char* section,
+    size_t sectionLength);
+bool ReadZstdSequenceTable(RaytmxFseTable* table, uint32_t mode, const int16_t* defaultDistribution,
+    uint32_t defaultSymbolsLength, uint32_t defaultAccuracyLog, uint32_t maxSymbol, uint32_t maxAccuracyLog,
+    const unsigned char** iterator, const unsigned char* end);
+size_t ReadFseDistribution(const unsigned char* data, size_t dataLength, int16_t* probabilities, uint32_t maxSymbol,
+    uint32_t maxAccuracyLog, uint32_t* symbolsLength, uint32_t* accuracyLog);
+uint32_t PeekFseDistributionBits(const unsigned char* data, size_t dataLength, size_t bitPosition);
+bool BuildFseTable(RaytmxFseTable* table, const int16_t* probabilities, uint32_t symbolsLength, uint32_t accuracyLog);
+bool InitZstdBits(RaytmxZstdBits* bits, const unsigned char* data, size_t dataLength);
+uint64_t PeekZstdBits(const RaytmxZstdBits* bits, uint32_t bitsLength);
+uint64_t ReadZstdBits(RaytmxZstdBits* bits, uint32_t bitsLength);
+void ReloadZstdBits(RaytmxZstdBits* bits);
+uint32_t GetHighestBit(uint32_t value);
+uint64_t GetXxHash64(const unsigned char* data, size_t dataLength);
 int32_t GetGid(int32_t rawGid, bool* isFlippedHorizontally, bool* isFlippedVertically, bool* isFlippedDiagonally,
     bool* isRotatedHexagonal120);
+uint32_t GetFlipIndex(int32_t rawGid);
 void* MemAllocZero(unsigned int size);
-char* GetDirectoryPath2(const char* filePath);
-char* JoinPath(const char* prefix, const char* suffix);
+bool IsPathAbsolute(const char* path);
+char* GetDocumentDirectory(const char* fileName, char* directory, size_t directorySize);
+char* JoinPath(const char* prefix, const char* suffix, char* joinedPath, size_t joinedPathSize);
 void StringCopyN(char* destination, const char* source, size_t number);
 void StringConcatenate(char* destination, const char* source);
 
 /**********************************************************************************************************************/
 /* Public implementation.                                                                                             */
 
+static int tmxLoadFlags = 0;
+static int tmxLoadThreads = 0;
+static TmxLoadFileCallback tmxLoadFile = NULL;
+static TmxUnloadFileCallback tmxUnloadFile = NULL;
+static void* tmxFileUserData = NULL;
+static RaytmxSharedTexture* tmxSharedTextures = NULL; /* Textures shared by maps loaded with LOAD_SHARE_TEXTURES */
+static RaytmxCachedDocument* tmxCachedDocuments = NULL; /* Documents parsed for maps loaded with LOAD_CACHE_DOCUMENTS */
+#if defined(TMX_THREADS_PTHREADS)
+static pthread_mutex_t tmxCachesMutex = PTHREAD_MUTEX_INITIALIZER;
+#elif defined(TMX_THREADS_WIN32)
+static void* tmxCachesLock = NULL; /* An SRWLOCK, which is a single pointer initialized to NULL (SRWLOCK_INIT) */
+#endif
+
 RAYTMX_DEC TmxMap* LoadTMX(const char* fileName) {
+    RaytmxExternalFile file = LoadExternalFile(fileName);
+    if (file.data == NULL) {
+        TraceLog(LOG_ERROR, "RAYTMX: Failed to open \"%s\"", fileName);
+        return NULL;
+    }
+
+    TmxMap* map = LoadTMXFromMemory((const char*)file.data, file.length, fileName);
+    UnloadExternalFile(file);
+    return map;
+}
+
+RAYTMX_DEC TmxMap* LoadTMXFromMemory(const char* data, size_t length, const char* virtualPath) {
+    return LoadMapFromMemory(data, length, virtualPath, NULL);
+}
+
+RAYTMX_DEC bool SaveTMXBinary(const TmxMap* map, const char* fileName) {
+    if (map == NULL || fileName == NULL)
+        return false;
+    if (map->atlasesLength > 0) {
+        TraceLog(LOG_ERROR, "RAYTMX: Unable to save \"%s\" because the map's tiles were packed into atlases",
+            fileName);
+        return false;
+    }
+
+    /* The map is written field by field, little-endian, and without textures or pointers so the same map always */
+    /* produces the same bytes. Image paths are made relative to the file's directory, found the way a document's is. */
+    char directory[TMX_PATH_LENGTH];
+    RaytmxBinaryWriter writer;
+    memset(&writer, 0, sizeof(RaytmxBinaryWriter));
+    writer.directory = GetDocumentDirectory(fileName, directory, sizeof(directory));
+    WriteBinaryBytes(&writer, TMX_BINARY_MAGIC, 4);
+    WriteBinaryU32(&writer, TMX_BINARY_VERSION);
+    WriteBinaryMap(&writer, map);
+
+    bool isSaved = writer.length <= 0x7FFFFFFF && SaveFileData(fileName, writer.data, (int)writer.length);
+    if (!isSaved)
+        TraceLog(LOG_ERROR, "RAYTMX: Unable to save \"%s\"", fileName);
+    MemFree(writer.data);
+    return isSaved;
+}
+
+RAYTMX_DEC TmxMap* LoadTMXBinary(const char* fileName) {
+    RaytmxExternalFile file = LoadExternalFile(fileName);
+    if (file.data == NULL) {
+        TraceLog(LOG_ERROR, "RAYTMX: Failed to open \"%s\"", fileName);
+        return NULL;
+    }
+
+    char directory[TMX_PATH_LENGTH];
+    RaytmxBinaryReader reader;
+    memset(&reader, 0, sizeof(RaytmxBinaryReader));
+    reader.data = file.data;
+    reader.length = file.length;
+    reader.isValid = true;
+    reader.directory = GetDocumentDirectory(fileName, directory, sizeof(directory));
+    const unsigned char* magic = ReadBinaryBytes(&reader, 4);
+    uint32_t version = ReadBinaryU32(&reader);
+    if (magic == NULL || memcmp(magic, TMX_BINARY_MAGIC, 4) != 0) {
+        TraceLog(LOG_ERROR, "RAYTMX: \"%s\" is not a binary map", fileName);
+        UnloadExternalFile(file);
+        return NULL;
+    }
+    if (version != TMX_BINARY_VERSION) {
+        TraceLog(LOG_ERROR, "RAYTMX: \"%s\" is a version %u binary map but only version %d is supported", fileName,
+            version, TMX_BINARY_VERSION);
+        UnloadExternalFile(file);
+        return NULL;
+    }
+
+    /* Copy the map out of the file. Nothing has a texture yet so, if the file turns out to be corrupt, the partially */
+    /* read map is simply unloaded. */
+    TmxMap* map = (TmxMap*)MemAllocZero(sizeof(TmxMap));
+    ReadBinaryMap(&reader, map);
+    UnloadExternalFile(file);
+    if (!reader.isValid) {
+        TraceLog(LOG_ERROR, "RAYTMX: \"%s\" is truncated or corrupt", fileName);
+        UnloadTMX(map);
+        return NULL;
+    }
+
+    /* What's left is what LoadTMX() does once the map is built: give the images, and then the tiles, textures */
+    TmxLoadTask task;
+    memset(&task, 0, sizeof(TmxLoadTask));
+    task.isSharingTextures = (tmxLoadFlags & LOAD_SHARE_TEXTURES) != 0;
+    bool isPackingAtlases = (tmxLoadFlags & LOAD_PACK_ATLAS) && !(tmxLoadFlags & LOAD_HEADLESS);
+    if (!(tmxLoadFlags & LOAD_HEADLESS))
+        AddBinaryMapTextures(map, &task, isPackingAtlases);
+    DecodePendingTextures(&task);
+    ResolveTaskTextures(&task, map);
+
+    if (map->gidsToTilesLength > 0) {
+        const TmxImage** gidsToImages = (const TmxImage**)MemAllocZero(sizeof(TmxImage*) * map->gidsToTilesLength);
+        GetTileImages(map, gidsToImages);
+        if (isPackingAtlases)
+            PackTilesetAtlases(map, gidsToImages, &task);
+        else {
+            for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++) {
+                if (gidsToImages[gid] != NULL)
+                    map->gidsToTiles[gid].texture = gidsToImages[gid]->texture;
+            }
+        }
+        MemFree((void*)gidsToImages);
+        SetTileTexcoords(map);
+    }
+
+    /* The object indexes aren't saved as they're quick to build and, unlike everything else, their layout is private */
+    BuildObjectIndexes(map, map->layers, map->layersLength);
+
+    while (task.texturesUploaded < task.pendingTexturesLength)
+        UploadPendingTexture(&task);
+    ResolveTaskTextures(&task, map);
+    FreePendingTextures(&task);
+    return map;
+}
+
+RAYTMX_DEC TmxLoadTask* BeginLoadTMX(const char* fileName) {
+    TmxLoadTask* task = (TmxLoadTask*)MemAllocZero(sizeof(TmxLoadTask));
+    /* A relative file name is made absolute here, on the calling thread, because raylib's GetWorkingDirectory() */
+    /* returns a buffer shared by the whole process. Paths are otherwise built in buffers owned by the load. */
+    char path[TMX_PATH_LENGTH];
+    if (tmxLoadFile == NULL && !IsPathAbsolute(fileName))
+        fileName = JoinPath(GetWorkingDirectory(), fileName, path, sizeof(path));
+    task->fileName = (char*)MemAllocZero((unsigned int)strlen(fileName) + 1);
+    StringCopy(task->fileName, fileName);
+
+#if defined(TMX_THREADS_PTHREADS)
+    task->hasThread = pthread_create(&task->thread, NULL, RunLoadTaskThread, task) == 0;
+#elif defined(TMX_THREADS_WIN32)
+    task->thread = _beginthreadex(NULL, 0, RunLoadTaskThread, task, 0, NULL);
+    task->hasThread = task->thread != 0;
+#endif
+    if (!task->hasThread) /* If there are no threads or the thread failed to start, load on this thread instead */
+        RunLoadTask(task);
+
+    return task;
+}
+
+RAYTMX_DEC TmxLoadProgress GetLoadProgressTMX(const TmxLoadTask* task) {
+    TmxLoadProgress progress;
+    memset(&progress, 0, sizeof(TmxLoadProgress));
+    if (task == NULL)
+        return progress;
+
+    progress.bytesParsed = TMX_ATOMIC_LOAD(&task->bytesParsed);
+    progress.bytesTotal = TMX_ATOMIC_LOAD(&task->bytesTotal);
+    progress.layersDecoded = TMX_ATOMIC_LOAD(&task->layersDecoded);
+    progress.layersTotal = TMX_ATOMIC_LOAD(&task->layersTotal);
+    progress.imagesDecoded = TMX_ATOMIC_LOAD(&task->imagesDecoded);
+    progress.imagesTotal = TMX_ATOMIC_LOAD(&task->imagesTotal);
+    progress.texturesUploaded = TMX_ATOMIC_LOAD(&task->texturesUploaded);
+    progress.isLoaded = TMX_ATOMIC_LOAD(&task->isLoaded);
+    if (progress.isLoaded) /* If the loading thread is done adding textures */
+        progress.texturesTotal = task->pendingTexturesLength;
+    return progress;
+}
+
+RAYTMX_DEC bool FinalizeLoadTMX(TmxLoadTask* task, double timeBudget, TmxMap** map) {
+    *map = NULL;
+    if (task == NULL)
+        return true;
+    if (!TMX_ATOMIC_LOAD(&task->isLoaded)) /* If the loading thread is still working */
+        return false;
+    JoinLoadTask(task);
+
+    if (task->map != NULL) { /* If loading succeeded */
+        /* Upload the decoded images, in the order they were referenced, until they're all uploaded or time is up */
+        double startTime = GetTime();
+        while (task->texturesUploaded < task->pendingTexturesLength) {
+            UploadPendingTexture(task);
+            if (GetTime() - startTime >= timeBudget)
+                break;
+        }
+        if (task->texturesUploaded < task->pendingTexturesLength)
+            return false; /* Continue with the next call */
+
+        /* Swap the placeholder textures throughout the map with the uploaded textures */
+        ResolveTaskTextures(task, task->map);
+        *map = task->map;
+        task->map = NULL;
+    }
+
+    FreeLoadTask(task);
+    return true;
+}
+
+RAYTMX_DEC void CancelLoadTMX(TmxLoadTask* task) {
+    if (task == NULL)
+        return;
+
+    /* Signal the loading thread, which checks for cancellation as it parses and decodes images, and wait for it */
+    TMX_ATOMIC_STORE(&task->isCanceled, true);
+    JoinLoadTask(task);
+
+    if (task->map != NULL) { /* If the loading thread finished the map before noticing */
+        /* Textures that were uploaded are resolved so they're unloaded with the map while the rest are resolved to */
+        /* no texture at all */
+        for (uint32_t i = task->texturesUploaded; i < task->pendingTexturesLength; i++)
+            memset(&task->pendingTextures[i].texture, 0, sizeof(Texture2D));
+        ResolveTaskTextures(task, task->map);
+        UnloadTMX(task->map);
+        task->map = NULL;
+    }
+    FreeLoadTask(task);
+}
+
+TmxMap* LoadMapFromMemory(const char* data, size_t length, const char* virtualPath, TmxLoadTask* task) {
+    if (data == NULL)
+        return NULL;
+    const char* fileName = virtualPath != NULL ? virtualPath : "";
+
+    /* Textures are uploaded once everything else is done. A synchronous load holds them with a task of its own and */
+    /* uploads them before returning whereas an asynchronous load leaves them to FinalizeLoadTMX(). */
+    TmxLoadTask syncTask;
+    if (task == NULL) {
+        memset(&syncTask, 0, sizeof(TmxLoadTask));
+        task = &syncTask;
+    }
+
+    task->isSharingTextures = (tmxLoadFlags & LOAD_SHARE_TEXTURES) != 0;
+    task->isCachingDocuments = (tmxLoadFlags & LOAD_CACHE_DOCUMENTS) != 0;
+
     RaytmxState raytmxState[1];
     memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
     raytmxState->format = FORMAT_TMX;
+    raytmxState->task = task;
 
     /* Initialize the map object */
     TmxMap* map = (TmxMap*)MemAllocZero(sizeof(TmxMap));
 
     /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
     /* equivalent TMX, TSX, and/or TX elements. */
-    ParseDocument(raytmxState, fileName);
+    ParseDocument(raytmxState, data, length, fileName);
     if (!raytmxState->isSuccess) {
+        FreeState(raytmxState);
         UnloadTMX(map);
+        if (task == &syncTask)
+            FreePendingTextures(task);
         return NULL;
     }
 
+    /* Decode the tile layers' data, captured during parsing, and hand the GIDs to the layers */
+    DecodeTileLayers(raytmxState);
+
+    /* Decode the images referenced during parsing, at the same time, which gives their placeholders dimensions */
+    DecodePendingTextures(task);
+
     /* Copy some top-level map properties */
     map->fileName = (char*)MemAllocZero((unsigned int)strlen(fileName) + 1);
     StringCopy(map->fileName, GetFileName(fileName));
@@ -768,8 +1889,16 @@ RAYTMX_DEC TmxMap* LoadTMX(const char* fileName) {
     } else
         TraceLog(LOG_WARNING, "RAYTMX: The map does not contain any layers");
 
+    /* Give the placeholder textures of the tilesets and image layers the dimensions of their now-decoded images. The */
+    /* tiles then copy the placeholders, dimensions included, from the tilesets. */
+    ResolveTaskTextures(task, map);
+
     if (gidsToTilesLength > 0) {
         TmxTile* gidsToTiles = (TmxTile*)MemAllocZero(sizeof(TmxTile) * gidsToTilesLength);
+        /* When packing atlases, remember which image each tile is extracted from */
+        const TmxImage** gidsToImages = NULL;
+        if ((tmxLoadFlags & LOAD_PACK_ATLAS) && !(tmxLoadFlags & LOAD_HEADLESS))
+            gidsToImages = (const TmxImage**)MemAllocZero(sizeof(TmxImage*) * gidsToTilesLength);
 
         for (uint32_t i = 0; i < map->tilesetsLength; i++) {
             TmxTileset* tileset = &map->tilesets[i];
@@ -822,6 +1951,8 @@ RAYTMX_DEC TmxMap* LoadTMX(const char* fileName) {
                             gidsToTiles[gid].sourceRect.height = (float)tileset->tileHeight;
                         }
                         gidsToTiles[gid].texture = tileset->image.texture;
+                        if (gidsToImages != NULL)
+                            gidsToImages[gid] = &tileset->image;
                         gidsToTiles[gid].offset.x = (float)tileset->tileOffsetX;
                         gidsToTiles[gid].offset.y = (float)tileset->tileOffsetY;
                     }
@@ -848,17 +1979,88 @@ RAYTMX_DEC TmxMap* LoadTMX(const char* fileName) {
                     else
                         gidsToTiles[gid].sourceRect.height = (float)tilesetTile.image.height;
                     gidsToTiles[gid].texture = tilesetTile.image.texture;
+                    if (gidsToImages != NULL)
+                        gidsToImages[gid] = &tileset->tiles[j].image;
                 }
             }
         }
 
         map->gidsToTiles = gidsToTiles;
         map->gidsToTilesLength = gidsToTilesLength;
+
+        if (gidsToImages != NULL) {
+            /* Load the images, pack them, and point the tiles to their areas within the resulting atlases */
+            if (!IsLoadCanceled(task))
+                PackTilesetAtlases(map, gidsToImages, task);
+            MemFree((void*)gidsToImages);
+        }
+
+        /* Normalize each tile's source rectangle to its texture once, now, so drawing doesn't need to divide */
+        SetTileTexcoords(map);
+
+        /* List the animations so that animating doesn't need to search for them, and then resolve which tile each GID */
+        /* displays initially */
+        map->displayGids = (int32_t*)MemAllocZero(sizeof(int32_t) * gidsToTilesLength);
+        for (int32_t gid = 0; gid < gidsToTilesLength; gid++) {
+            const TmxTile* tile = &gidsToTiles[gid];
+            if (tile->gid <= 0) /* If the GID is unused */
+                continue;
+            if (!tile->hasAnimation)
+                map->displayGids[gid] = gid; /* A static tile always displays itself */
+            else if (tile->animation.framesLength > 0)
+                map->animatedGidsLength += 1;
+        }
+        if (map->animatedGidsLength > 0) {
+            map->animatedGids = (uint32_t*)MemAllocZero(sizeof(uint32_t) * map->animatedGidsLength);
+            uint32_t animatedGidsIndex = 0;
+            for (int32_t gid = 0; gid < gidsToTilesLength; gid++) {
+                const TmxTile* tile = &gidsToTiles[gid];
+                if (tile->gid > 0 && tile->hasAnimation && tile->animation.framesLength > 0)
+                    map->animatedGids[animatedGidsIndex++] = (uint32_t)gid;
+            }
+            UpdateDisplayGids(map);
+        }
     } /* gidsToTilesLength > 0 */
 
+    /* Determine the area any one tile may cover relative to its cell. Most tiles exactly fill their cells but larger */
+    /* tiles extend up and to the right, and tileset offsets can push tiles in any direction. Knowing the extremes */
+    /* lets drawing skip straight to the cells that could possibly be on screen. */
+    float boundsLeft = 0.0f, boundsTop = 0.0f;
+    float boundsRight = (float)map->tileWidth, boundsBottom = (float)map->tileHeight;
+    for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++) {
+        TmxTile* tile = &map->gidsToTiles[gid];
+        if (tile->gid <= 0 || tile->hasAnimation) /* If unused or an animation (whose frames are checked themselves) */
+            continue;
+
+        /* This matches the destination rectangle calculated by DrawTMXLayerTile() for a cell at (0, 0) */
+        float left = tile->offset.x, top = tile->offset.y + (float)map->tileHeight - tile->sourceRect.height;
+        if (left < boundsLeft)
+            boundsLeft = left;
+        if (top < boundsTop)
+            boundsTop = top;
+        if (left + tile->sourceRect.width > boundsRight)
+            boundsRight = left + tile->sourceRect.width;
+        if (top + tile->sourceRect.height > boundsBottom)
+            boundsBottom = top + tile->sourceRect.height;
+    }
+    map->tileBounds.x = boundsLeft;
+    map->tileBounds.y = boundsTop;
+    map->tileBounds.width = boundsRight - boundsLeft;
+    map->tileBounds.height = boundsBottom - boundsTop;
+
+    /* With the tiles' dimensions known, and so the bounds of tile objects, index the objects of every object group */
+    BuildObjectIndexes(map, map->layers, map->layersLength);
+
     /* Free the linked lists and zeroize related values */
     FreeState(raytmxState);
 
+    if (task == &syncTask) { /* If loading synchronously, upload the textures in one pass and swap them in */
+        while (task->texturesUploaded < task->pendingTexturesLength)
+            UploadPendingTexture(task);
+        ResolveTaskTextures(task, map);
+        FreePendingTextures(task);
+    }
+
     return map;
 }
 
@@ -889,6 +2091,18 @@ RAYTMX_DEC void UnloadTMX(TmxMap* map) {
 
     if (map->gidsToTiles != NULL)
         MemFree(map->gidsToTiles);
+    if (map->displayGids != NULL)
+        MemFree(map->displayGids);
+    if (map->animatedGids != NULL)
+        MemFree(map->animatedGids);
+
+    if (map->atlases != NULL) {
+        for (uint32_t i = 0; i < map->atlasesLength; i++) {
+            if (map->atlases[i].id != 0) /* If the atlas was uploaded, as it may not be when a load is canceled */
+                UnloadTexture(map->atlases[i]);
+        }
+        MemFree(map->atlases);
+    }
 
     MemFree(map);
 }
@@ -905,85 +2119,169 @@ RAYTMX_DEC void DrawTMX(const TmxMap* map, const Camera2D* camera, int posX, int
     DrawTMXLayers(map, camera, map->layers, map->layersLength, posX, posY, tint);
 }
 
+static TmxDrawStats tmxDrawStats; /* Counters of the work done by the most recent draw call */
+static bool tmxIsBatchOpen = false; /* Whether a batch of tile quads has been begun and not yet ended */
+static unsigned int tmxBatchTextureId = 0; /* ID of the texture of the open quad batch, if there is one */
+
 RAYTMX_DEC void DrawTMXLayers(const TmxMap* map, const Camera2D* camera, const TmxLayer* layers, uint32_t layersLength,
         int posX, int posY, Color tint) {
+    memset(&tmxDrawStats, 0, sizeof(TmxDrawStats));
     if (map == NULL || layers == NULL || layersLength == 0)
         return;
 
-    for (uint32_t i = 0; i < layersLength; i++) {
-        TmxLayer layer = layers[i];
-        if (!layers[i].visible) /* If the layer is not visible */
-            continue; /* Skip it - it's literally invisible */
+    DrawTMXLayerList(map, camera, layers, layersLength, posX, posY, tint);
+    /* Tiles are accumulated in a batch that may still be open. Close it so the application's subsequent draws, which */
+    /* know nothing of it, begin with a clean slate. */
+    EndTileBatch();
+}
 
-        /* All types of layers can have a couple attributes that affect color: 'opacity' and 'tintcolor' */
-        Color layerTint = tint;
-        layerTint.a = (unsigned char)((double)layerTint.a * layer.opacity);
-        if (layer.hasTintColor)
-            layerTint = ColorTint(layerTint, layer.tintColor);
+RAYTMX_DEC TmxDrawStats GetDrawStatsTMX(void) {
+    return tmxDrawStats;
+}
 
-        Rectangle screenRect;
-        if (camera != NULL) {
-            screenRect.width = GetScreenWidth() / camera->zoom;
-            screenRect.height = GetScreenHeight() / camera->zoom;
-            screenRect.x = camera->target.x - (screenRect.width / 2.0f);
-            screenRect.y = camera->target.y - (screenRect.height / 2.0f);
-        } else {
-            screenRect.x = 0.0f;
-            screenRect.y = 0.0f;
-            screenRect.width = (float)GetScreenWidth();
-            screenRect.height = (float)GetScreenHeight();
-        }
+RAYTMX_DEC void SetTileTMX(TmxLayer* layer, uint32_t x, uint32_t y, uint32_t rawGid) {
+    if (layer == NULL || layer->type != LAYER_TYPE_TILE_LAYER)
+        return;
 
-        int32_t parallaxOffsetX = 0, parallaxOffsetY = 0;
-        if (camera != NULL) {
-            parallaxOffsetX = (int32_t)((double)(camera->target.x - map->parallaxOriginX) * (layer.parallaxX - 1.0));
-            parallaxOffsetY = (int32_t)((double)(camera->target.y - map->parallaxOriginY) * (layer.parallaxY - 1.0));
-        }
+    TmxTileLayer* tileLayer = &layer->exact.tileLayer;
+    uint32_t index = (y * tileLayer->width) + x;
+    if (x >= tileLayer->width || y >= tileLayer->height || index >= tileLayer->tilesLength)
+        return;
 
-        switch (layer.type) {
-        case LAYER_TYPE_TILE_LAYER:
-            DrawTMXTileLayer(map, screenRect, layer, posX + layer.offsetX + parallaxOffsetX,
-                posY + layer.offsetY + parallaxOffsetY, layerTint);
-            break;
-        case LAYER_TYPE_OBJECT_GROUP:
-            DrawTMXObjectGroup(map, screenRect, layer, posX + layer.offsetX + parallaxOffsetX,
-                posY + layer.offsetY + parallaxOffsetY, layerTint);
-            break;
-        case LAYER_TYPE_IMAGE_LAYER:
-            if (layer.exact.imageLayer.hasImage) {
-                DrawTexture(/* texture: */ layer.exact.imageLayer.image.texture,
-                    /* posX: */ posX + layer.offsetX + parallaxOffsetX,
-                    /* posY: */ posY + layer.offsetY + parallaxOffsetY, /* tint: */ layerTint);
-            } break;
-        case LAYER_TYPE_GROUP:
-            DrawTMXLayers(map, camera, layer.layers, layer.layersLength, posX + layer.offsetX + parallaxOffsetX,
-                posY + layer.offsetY + parallaxOffsetY, layerTint);
-            break;
-        }
-    }
+    tileLayer->tiles[index] = rawGid;
+    /* Flag the chunk containing the tile so its geometry is rebuilt before it's drawn again */
+    uint32_t chunkX = x / RAYTMX_CHUNK_SIZE, chunkY = y / RAYTMX_CHUNK_SIZE;
+    if (tileLayer->chunks != NULL && chunkX < tileLayer->chunksWidth && chunkY < tileLayer->chunksHeight)
+        tileLayer->chunks[(chunkY * tileLayer->chunksWidth) + chunkX].isBuilt = false;
 }
 
-RAYTMX_DEC void AnimateTMX(TmxMap* map) {
+RAYTMX_DEC void InvalidateTileLayerTMX(TmxLayer* layer) {
+    if (layer == NULL)
+        return;
+
+    if (layer->type == LAYER_TYPE_GROUP) {
+        for (uint32_t i = 0; i < layer->layersLength; i++)
+            InvalidateTileLayerTMX(&layer->layers[i]);
+    } else if (layer->type == LAYER_TYPE_TILE_LAYER && layer->exact.tileLayer.chunks != NULL) {
+        /* Flag every chunk rather than freeing them so that the chunks are rebuilt, as they come into view, just as */
+        /* those flagged by SetTileTMX() are */
+        TmxTileLayer* tileLayer = &layer->exact.tileLayer;
+        for (uint32_t i = 0; i < tileLayer->chunksWidth * tileLayer->chunksHeight; i++)
+            tileLayer->chunks[i].isBuilt = false;
+    }
+}
+
+RAYTMX_DEC void ResortObjectGroupTMX(const TmxMap* map, TmxLayer* layer) {
+    if (map == NULL || layer == NULL || layer->type != LAYER_TYPE_OBJECT_GROUP)
+        return;
+
+    TmxObjectGroup* objectGroup = &layer->exact.objectGroup;
+    if (objectGroup->objects == NULL || objectGroup->ySortedObjects == NULL)
+        return;
+
+    /* The previous order is likely to be nearly, if not entirely, correct. Insertion sort makes the most of that: */
+    /* it's linear when the order is already correct and each out-of-place object only moves as far as it must. The */
+    /* order is that of CompareObjectSortKeys(), ascending y-coordinates with equals ordered last to first. */
+    /* The index's ranks of objects within the order are updated along with the objects that move. */
+    uint32_t* ySortedObjects = objectGroup->ySortedObjects;
+    TmxObjectIndex* index = objectGroup->index;
+    for (uint32_t i = 1; i < objectGroup->objectsLength; i++) {
+        uint32_t objectIndex = ySortedObjects[i];
+        double y = objectGroup->objects[objectIndex].y;
+        uint32_t j = i;
+        while (j > 0) {
+            uint32_t previousIndex = ySortedObjects[j - 1];
+            double previousY = objectGroup->objects[previousIndex].y;
+            if (previousY < y || (previousY == y && previousIndex > objectIndex)) /* If already in order */
+                break;
+            ySortedObjects[j] = previousIndex; /* Shift the previous object down to make room */
+            j--;
+        }
+        ySortedObjects[j] = objectIndex;
+        if (index != NULL) { /* The objects it passed, if any, moved along with it */
+            for (uint32_t k = j; k <= i; k++)
+                index->topDownRanks[ySortedObjects[k]] = k;
+        }
+    }
+
+    /* Update the bounds, and the cells if need be, of the objects that moved. Rebuild the index if many did. */
+    if (index == NULL || !UpdateObjectIndex(map, objectGroup)) {
+        if (index != NULL)
+            FreeObjectIndex(index);
+        objectGroup->index = BuildObjectIndex(map, objectGroup);
+    }
+}
+
+RAYTMX_DEC uint32_t QueryObjectsRecTMX(const TmxLayer* layer, Rectangle rec, uint32_t* objectIndexes,
+        uint32_t objectIndexesLength) {
+    if (layer == NULL || layer->type != LAYER_TYPE_OBJECT_GROUP || layer->exact.objectGroup.index == NULL)
+        return 0;
+
+    return QueryObjects(&layer->exact.objectGroup, rec, false, objectIndexes, objectIndexesLength);
+}
+
+RAYTMX_DEC uint32_t QueryObjectsPointTMX(const TmxLayer* layer, Vector2 point, uint32_t* objectIndexes,
+        uint32_t objectIndexesLength) {
+    if (layer == NULL || layer->type != LAYER_TYPE_OBJECT_GROUP || layer->exact.objectGroup.index == NULL)
+        return 0;
+
+    Rectangle area;
+    area.x = point.x;
+    area.y = point.y;
+    area.width = 0.0f;
+    area.height = 0.0f;
+    return QueryObjects(&layer->exact.objectGroup, area, true, objectIndexes, objectIndexesLength);
+}
+
+RAYTMX_DEC void AnimateTMX(TmxMap* map) {
     if (map == NULL)
         return;
 
-    float dt = GetFrameTime(); /* Returns the duration, in seconds, of the last frame drawn */
-    /* Iterate through the tiles, searching for those that are animations */
-    for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++) {
-        TmxTile* tile = &map->gidsToTiles[gid]; /* A pointer is used in case the frame time needs to be reassigned */
-        if (tile->gid > 0 && tile->hasAnimation) { /* If the GID maps to a valid tile and that tile is an animation */
-            tile->frameTime += dt;
-            /* If the current frame has been displayed for its whole duration, or longer */
-            if (tile->frameTime > tile->animation.frames[tile->frameIndex].duration) {
-                tile->frameTime -= tile->animation.frames[tile->frameIndex].duration;
-                /* Increment the frame index to display the next one... */
-                tile->frameIndex += 1;
-                /* ...unless the last frame was "last" in both senses */
-                if (tile->frameIndex == tile->animation.framesLength)
-                    tile->frameIndex = 0; /* Wrap around to the first frame */
-            }
+    AnimateTMXDelta(map, GetFrameTime()); /* GetFrameTime() returns the duration, in seconds, of the last frame drawn */
+}
+
+RAYTMX_DEC void AnimateTMXDelta(TmxMap* map, double dt) {
+    if (map == NULL)
+        return;
+
+    AnimateTMXAt(map, map->animationTime + dt);
+}
+
+RAYTMX_DEC void AnimateTMXAt(TmxMap* map, double timeSeconds) {
+    if (map == NULL)
+        return;
+
+    map->animationTime = timeSeconds;
+    /* Iterate through only the tiles that are animations, as listed when the map was loaded */
+    for (uint32_t i = 0; i < map->animatedGidsLength; i++) {
+        TmxTile* tile = &map->gidsToTiles[map->animatedGids[i]]; /* A pointer is used because the tile is modified */
+        const TmxAnimation* animation = &tile->animation;
+        double duration = animation->frameEnds[animation->framesLength - 1];
+        if (duration <= 0.0) { /* If the animation has no duration to speak of */
+            tile->frameIndex = 0;
+            tile->frameTime = 0.0f;
+            continue;
+        }
+
+        /* Animations loop so only the time into the current loop matters */
+        double time = fmod(timeSeconds, duration);
+        if (time < 0.0) /* If the time is negative, i.e. before the animation began */
+            time += duration;
+        /* Binary search for the first frame that ends after that time */
+        uint32_t low = 0, high = animation->framesLength - 1;
+        while (low < high) {
+            uint32_t middle = low + ((high - low) / 2);
+            if (animation->frameEnds[middle] > time)
+                high = middle;
+            else
+                low = middle + 1;
         }
+        tile->frameIndex = low;
+        tile->frameTime = (float)(time - (low > 0 ? animation->frameEnds[low - 1] : 0.0));
     }
+
+    /* With every animation on its new frame, update which tiles they display */
+    UpdateDisplayGids(map);
 }
 
 static int tmxLogFlags = 0;
@@ -1027,23 +2325,87 @@ RAYTMX_DEC void SetTraceLogFlagsTMX(int logFlags) {
     tmxLogFlags = logFlags;
 }
 
+RAYTMX_DEC void SetLoadFlagsTMX(int loadFlags) {
+    tmxLoadFlags = loadFlags;
+}
+
+RAYTMX_DEC void SetLoadThreadsTMX(int threadsCount) {
+    tmxLoadThreads = threadsCount > 0 ? threadsCount : 0;
+}
+
+RAYTMX_DEC void SetFileCallbacksTMX(TmxLoadFileCallback loadFile, TmxUnloadFileCallback unloadFile, void* userData) {
+    tmxLoadFile = loadFile;
+    tmxUnloadFile = loadFile != NULL ? unloadFile : NULL;
+    tmxFileUserData = loadFile != NULL ? userData : NULL;
+}
+
+RAYTMX_DEC void FlushDocumentCacheTMX(void) {
+    LockCaches();
+    RaytmxCachedDocument* cachedDocuments = tmxCachedDocuments;
+    tmxCachedDocuments = NULL;
+    UnlockCaches();
+    while (cachedDocuments != NULL) {
+        RaytmxCachedDocument* next = cachedDocuments->next;
+        FreeCachedDocument(cachedDocuments);
+        cachedDocuments = next;
+    }
+}
+
+RAYTMX_DEC void InvalidateDocumentCacheTMX(const char* fileName) {
+    if (fileName == NULL)
+        return;
+
+    char* canonicalPath = CanonicalizePath(fileName);
+    LockCaches();
+    RaytmxCachedDocument** link = &tmxCachedDocuments;
+    while (*link != NULL) {
+        RaytmxCachedDocument* cachedDocument = *link;
+        if (strcmp(cachedDocument->path, canonicalPath) == 0) { /* If a copy, headless or not, of the file */
+            *link = cachedDocument->next;
+            FreeCachedDocument(cachedDocument);
+        } else
+            link = &cachedDocument->next;
+    }
+    UnlockCaches();
+    MemFree(canonicalPath);
+}
+
 /**********************************************************************************************************************/
 /* Private implementation.                                                                                            */
 
-RaytmxExternalTileset LoadTSX(const char* fileName) {
+RaytmxExternalTileset LoadTSX(const char* fileName, TmxLoadTask* task) {
     RaytmxState raytmxState[1];
     memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
     raytmxState->format = FORMAT_TSX;
+    raytmxState->task = task;
 
     /* Initialize an external tileset object */
     RaytmxExternalTileset externalTileset;
     memset(&externalTileset, 0, sizeof(RaytmxExternalTileset));
 
+    /* If this TSX was already parsed and cached, copy the cached tileset instead of parsing it again */
+    RaytmxObjectTemplate cachedContents;
+    char* canonicalPath = NULL;
+    long modTime = 0;
+    if (task->isCachingDocuments) {
+        canonicalPath = CanonicalizePath(fileName);
+        modTime = GetDocumentModTime(fileName);
+        if (CopyCachedDocument(canonicalPath, modTime, task, &cachedContents)) {
+            MemFree(canonicalPath);
+            externalTileset.tileset = cachedContents.tileset;
+            externalTileset.isSuccess = true;
+            return externalTileset;
+        }
+    }
+
     /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
     /* equivalent TMX, TSX, and/or TX elements. */
-    ParseDocument(raytmxState, fileName);
-    if (!raytmxState->isSuccess)
+    ParseDocumentFile(raytmxState, fileName);
+    if (!raytmxState->isSuccess) {
+        FreeState(raytmxState);
+        FreeString(canonicalPath);
         return externalTileset; /* Will have 'isSuccess' set to false to indicate a failure */
+    }
 
     if (raytmxState->tilesetsRoot != NULL) { /* If there is at least one tileset */
         /* Copy the root tileset so it can be returned */
@@ -1052,32 +2414,60 @@ RaytmxExternalTileset LoadTSX(const char* fileName) {
         /* TSX files should have only one tileset so any others will be freed/unloaded immediately */
         RaytmxTilesetNode* tilesetIterator = raytmxState->tilesetsRoot->next;
         while (tilesetIterator != NULL) {
+            DetachTilesetTextures(&tilesetIterator->tileset); /* Textures are placeholders until loading is done */
             FreeTileset(tilesetIterator->tileset);
             tilesetIterator = tilesetIterator->next;
         }
     } else
         TraceLog(LOG_WARNING, "RAYTMX: TSX file (external tileset) \"%s\" does not contain any tilesets", fileName);
 
+    if (canonicalPath != NULL) { /* If the tileset is to be cached */
+        if (externalTileset.isSuccess) {
+            memset(&cachedContents, 0, sizeof(RaytmxObjectTemplate));
+            cachedContents.tileset = externalTileset.tileset;
+            cachedContents.hasTileset = true;
+            cachedContents.isSuccess = true;
+            AddCachedDocument(canonicalPath, modTime, &cachedContents);
+        }
+        MemFree(canonicalPath);
+    }
+
     /* Free the linked lists and zeroize related values */
     FreeState(raytmxState);
 
     return externalTileset;
 }
 
-RaytmxObjectTemplate LoadTX(const char* fileName) {
+RaytmxObjectTemplate LoadTX(const char* fileName, TmxLoadTask* task) {
     RaytmxState raytmxState[1];
     memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
     raytmxState->format = FORMAT_TX;
+    raytmxState->task = task;
 
     /* Initialize an object template object */
     RaytmxObjectTemplate objectTemplate;
     memset(&objectTemplate, 0, sizeof(RaytmxObjectTemplate));
 
+    /* If this TX was already parsed and cached, copy the cached template instead of parsing it again */
+    char* canonicalPath = NULL;
+    long modTime = 0;
+    if (task->isCachingDocuments) {
+        canonicalPath = CanonicalizePath(fileName);
+        modTime = GetDocumentModTime(fileName);
+        if (CopyCachedDocument(canonicalPath, modTime, task, &objectTemplate)) {
+            MemFree(canonicalPath);
+            return objectTemplate;
+        }
+    }
+
     /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
     /* equivalent TMX, TSX, and/or TX elements. */
-    ParseDocument(raytmxState, fileName);
-    if (!raytmxState->isSuccess)
+    ParseDocumentFile(raytmxState, fileName);
+    if (!raytmxState->isSuccess) {
+        FreeState(raytmxState);
+        FreeString(canonicalPath);
         return objectTemplate; /* Will have 'isSuccess' set to false to indicate a failure */
+    }
 
     if (raytmxState->objectsRoot != NULL) { /* If there is at least one object */
         /* Copy the root object so it can be returned */
@@ -1100,6 +2490,7 @@ RaytmxObjectTemplate LoadTX(const char* fileName) {
         /* TX files should have at most one tileset so any others will be freed/unloaded immediately */
         RaytmxTilesetNode* tilesetsIterator = raytmxState->tilesetsRoot->next;
         while (tilesetsIterator != NULL) {
+            DetachTilesetTextures(&tilesetsIterator->tileset); /* Textures are placeholders until loading is done */
             FreeTileset(tilesetsIterator->tileset);
             tilesetsIterator = tilesetsIterator->next;
         }
@@ -1108,35 +2499,90 @@ RaytmxObjectTemplate LoadTX(const char* fileName) {
     /* Free the linked lists and zeroize related values */
     FreeState(raytmxState);
 
+    if (canonicalPath != NULL) { /* If the template is to be cached */
+        if (objectTemplate.isSuccess)
+            AddCachedDocument(canonicalPath, modTime, &objectTemplate);
+        MemFree(canonicalPath);
+    }
+
     return objectTemplate;
 }
 
-void ParseDocument(RaytmxState* raytmxState, const char* fileName) {
-    char* content = LoadFileText(fileName);
-    if (content == NULL) {
+void ParseDocumentFile(RaytmxState* raytmxState, const char* fileName) {
+    RaytmxExternalFile file = LoadExternalFile(fileName);
+    if (file.data == NULL) {
         TraceLog(LOG_ERROR, "RAYTMX: Failed to open \"%s\"", fileName);
         return;
     }
-    size_t contentLength = strlen(content);
 
-    StringCopy(raytmxState->documentDirectory, GetDirectoryPath2(fileName));
+    ParseDocument(raytmxState, (const char*)file.data, file.length, fileName);
+    UnloadExternalFile(file);
+}
+
+void ParseDocument(RaytmxState* raytmxState, const char* content, size_t contentLength, const char* fileName) {
+    GetDocumentDirectory(fileName, raytmxState->documentDirectory, sizeof(raytmxState->documentDirectory));
 
     hoxml_context_t hoxmlContext[1];
-    size_t bufferLength = contentLength;
+    size_t bufferLength = GetXmlBufferLength(content, contentLength);
     char* buffer = (char*)MemAlloc((unsigned int)bufferLength);
     hoxml_init(hoxmlContext, buffer, bufferLength);
 
+    /* hoxml is handed the document in pieces when the content of <data> elements is skipped over */
+    const char* input = content;
+    size_t inputLength = contentLength;
+    const char* resumedInput = NULL; /* Where parsing resumes once hoxml has parsed the end of a <data> tag */
+
     hoxml_code_t code;
-    while ((code = hoxml_parse(hoxmlContext, content, contentLength)) != HOXML_END_OF_DOCUMENT) {
+    while ((code = hoxml_parse(hoxmlContext, input, inputLength)) != HOXML_END_OF_DOCUMENT) {
         if (code > HOXML_END_OF_DOCUMENT) { /* If there's information about an element, attribute, whatever */
             switch (code) {
             case HOXML_ELEMENT_BEGIN: HandleElementBegin(raytmxState, hoxmlContext); break;
             case HOXML_ELEMENT_END: HandleElementEnd(raytmxState, hoxmlContext); break;
-            case HOXML_ATTRIBUTE: HandleAttribute(raytmxState, hoxmlContext);
+            case HOXML_ATTRIBUTE: {
+                HandleAttribute(raytmxState, hoxmlContext);
+                /* Base64 and CSV layer data is taken straight from the document so that hoxml needn't copy what may */
+                /* be megabytes of content into its buffer. hoxml is given only the rest of the <data> tag, which */
+                /* ends with an unexpected EOF, after which it's given the document from the end of the content. */
+                const char* tagEnd = FindLayerDataContent(raytmxState, hoxmlContext, content + contentLength);
+                if (tagEnd != NULL) {
+                    input = hoxmlContext->iterator;
+                    inputLength = (size_t)(tagEnd - input) + 1; /* Up to and including the '>' */
+                    resumedInput = raytmxState->layerDataContent + raytmxState->layerDataContentLength;
+                }
+            } break;
             case HOXML_PROCESSING_INSTRUCTION_BEGIN: break;
             case HOXML_PROCESSING_INSTRUCTION_END: break;
             default: break; /* No other cases to handle but compilers like to complain */
             }
+
+            if (code == HOXML_ELEMENT_END && raytmxState->task != NULL) {
+                /* Report how much of the map has been parsed and stop, without error, if the load was canceled. Every */
+                /* load has a task, synchronous ones included, but only BeginLoadTMX()'s are read or canceled. */
+                if (raytmxState->format == FORMAT_TMX)
+                    TMX_ATOMIC_STORE(&raytmxState->task->bytesParsed, (size_t)(hoxmlContext->iterator - content));
+                if (IsLoadCanceled(raytmxState->task)) {
+                    MemFree(buffer);
+                    return;
+                }
+            }
+        } else if (code == HOXML_ERROR_UNEXPECTED_EOF && resumedInput != NULL) {
+            /* The end of the <data> tag was parsed. Count the lines of the skipped content, as hoxml would have, so */
+            /* that lines reported from here on are still correct. */
+            char newline = hoxmlContext->newline_character == '\r' ? '\r' : '\n';
+            const char* lineStart = raytmxState->layerDataContent;
+            for (const char* iterator = lineStart; iterator < resumedInput; iterator++) {
+                if (*iterator == newline) {
+                    hoxmlContext->line += 1;
+                    lineStart = iterator + 1;
+                }
+            }
+            if (lineStart == raytmxState->layerDataContent) /* If the content is all on the tag's line */
+                hoxmlContext->column += (uint32_t)(resumedInput - lineStart);
+            else
+                hoxmlContext->column = (uint32_t)(resumedInput - lineStart);
+            input = resumedInput;
+            inputLength = (size_t)(content + contentLength - resumedInput);
+            resumedInput = NULL;
         } else if (code < HOXML_END_OF_DOCUMENT) { /* If there was an error, recoverable or not */
             switch (code) {
             case HOXML_ERROR_INSUFFICIENT_MEMORY: {
@@ -1170,16 +2616,148 @@ void ParseDocument(RaytmxState* raytmxState, const char* fileName) {
             break;
             default: break; /* Keep the compiler happy */
             }
-            UnloadFileText(content);
+            MemFree(buffer);
             return;
         }
     }
 
-    UnloadFileText(content);
     MemFree(buffer);
     raytmxState->isSuccess = true;
 }
 
+const char* FindLayerDataContent(RaytmxState* raytmxState, const hoxml_context_t* hoxmlContext, const char* end) {
+    /* Only Base64 and CSV content is taken from the document. XML-encoded data is made of elements hoxml must parse. */
+    const TmxTileLayer* tileLayer = raytmxState->tileLayer;
+    if (strcmp(hoxmlContext->tag, "data") != 0 || tileLayer == NULL || tileLayer->encoding == NULL ||
+            (strcmp(tileLayer->encoding, "base64") != 0 && strcmp(tileLayer->encoding, "csv") != 0) ||
+            hoxmlContext->encoding == HOXML_ENC_UTF_16_LE || hoxmlContext->encoding == HOXML_ENC_UTF_16_BE)
+        return NULL;
+
+    /* The content begins once the open tag ends. If this attribute was the tag's last, only whitespace and a '>' */
+    /* follow where hoxml left off. */
+    const char* tagEnd = hoxmlContext->iterator;
+    while (tagEnd < end && isspace((unsigned char)*tagEnd))
+        tagEnd++;
+    if (tagEnd >= end || *tagEnd != '>')
+        return NULL;
+
+    /* The content must run up to the </data> tag, with no comments or CDATA sections, and must not have any */
+    /* references (e.g. "&#10;") as only hoxml resolves them */
+    const char* contentStart = tagEnd + 1;
+    const char* contentEnd = (const char*)memchr(contentStart, '<', (size_t)(end - contentStart));
+    if (contentEnd == NULL || end - contentEnd < 2 || contentEnd[1] != '/' ||
+            memchr(contentStart, '&', (size_t)(contentEnd - contentStart)) != NULL)
+        return NULL;
+
+    raytmxState->layerDataContent = contentStart;
+    raytmxState->layerDataContentLength = (size_t)(contentEnd - contentStart);
+    return tagEnd;
+}
+
+size_t GetXmlBufferLength(const char* content, size_t contentLength) {
+    /* hoxml keeps the name, attributes, and content of every open element in its buffer. None of those strings are */
+    /* longer than the markup or character data they were parsed from so a pass over the document that totals the */
+    /* bytes of the open elements gives an upper bound on the buffer needed. The content of encoded <data> elements */
+    /* isn't counted as it's normally taken from the document directly (see FindLayerDataContent()). */
+    size_t* elementsLengths = NULL; /* Stack of the bytes held by each open element */
+    size_t elementsLength = 0, elementsCapacity = 0;
+    size_t dataDepth = 0; /* Depth of the open, encoded <data> element, if any, with 1 being the root element */
+    size_t openLength = 0; /* Sum of the bytes held by all open elements */
+    size_t maxLength = 0;
+    const char* iterator = content;
+    const char* end = content + contentLength;
+    while (iterator < end) {
+        /* Character data up to the next markup is content of the innermost open element */
+        const char* markup = (const char*)memchr(iterator, '<', (size_t)(end - iterator));
+        if (markup == NULL)
+            markup = end;
+        if (elementsLength > 0 && elementsLength != dataDepth) {
+            elementsLengths[elementsLength - 1] += (size_t)(markup - iterator);
+            openLength += (size_t)(markup - iterator);
+        }
+        if (markup == end || end - markup < 2) /* If there's no more markup, or only a stray '<' */
+            break;
+
+        size_t remaining = (size_t)(end - markup);
+        const char* markupEnd = markup + 1;
+        bool isComment = remaining >= 4 && memcmp(markup, "<!--", 4) == 0;
+        bool isCdata = remaining >= 9 && memcmp(markup, "<![CDATA[", 9) == 0;
+        bool isProcessingInstruction = remaining >= 2 && markup[1] == '?';
+        if (isComment || isCdata || isProcessingInstruction) {
+            /* These end with "-->", "]]>", or "?>" and may contain '>' otherwise */
+            char terminator = isComment ? '-' : (isCdata ? ']' : '?');
+            size_t terminatorLength = isProcessingInstruction ? 1 : 2;
+            markupEnd += isComment ? 3 : (isCdata ? 8 : 1);
+            while (markupEnd < end) {
+                markupEnd = (const char*)memchr(markupEnd, '>', (size_t)(end - markupEnd));
+                if (markupEnd == NULL) {
+                    markupEnd = end;
+                    break;
+                }
+                if ((size_t)(markupEnd - markup) >= terminatorLength + 1 && markupEnd[-1] == terminator &&
+                        (terminatorLength == 1 || markupEnd[-2] == terminator))
+                    break;
+                markupEnd += 1;
+            }
+        } else { /* Elements' tags, whose attributes' values may contain '>' */
+            char quote = '\0';
+            while (markupEnd < end && (quote != '\0' || *markupEnd != '>')) {
+                if (quote == '\0' && (*markupEnd == '"' || *markupEnd == '\''))
+                    quote = *markupEnd;
+                else if (*markupEnd == quote)
+                    quote = '\0';
+                markupEnd += 1;
+            }
+        }
+        if (markupEnd < end)
+            markupEnd += 1; /* Include the '>' */
+        size_t markupLength = (size_t)(markupEnd - markup) + TMX_XML_NODE_SIZE;
+
+        /* Close tags, empty elements, and the like are held only while being parsed */
+        size_t transientLength = markupLength;
+        if (isCdata) { /* CDATA sections are content of the innermost open element */
+            if (elementsLength > 0) {
+                elementsLengths[elementsLength - 1] += markupLength;
+                openLength += markupLength;
+                transientLength = 0;
+            }
+        } else if (!isComment && !isProcessingInstruction && markup[1] != '/' && markup[1] != '!' &&
+                markupEnd[-2] != '/') { /* If an open tag that isn't also a close tag (e.g. "<tag/>") */
+            if (elementsLength == elementsCapacity) {
+                elementsCapacity = elementsCapacity > 0 ? elementsCapacity * 2 : 16;
+                elementsLengths = (size_t*)MemRealloc(elementsLengths, (unsigned int)(sizeof(size_t) *
+                    elementsCapacity));
+            }
+            elementsLengths[elementsLength++] = markupLength;
+            openLength += markupLength;
+            transientLength = 0;
+            if (markupEnd - markup > 6 && memcmp(markup, "<data", 5) == 0 && isspace((unsigned char)markup[5])) {
+                for (const char* attribute = markup + 5; markupEnd - attribute >= 9; attribute++) {
+                    if (memcmp(attribute, "encoding=", 9) == 0) {
+                        dataDepth = elementsLength;
+                        break;
+                    }
+                }
+            }
+        }
+        if (openLength + transientLength > maxLength)
+            maxLength = openLength + transientLength;
+        if (markup[1] == '/' && elementsLength > 0) {
+            if (elementsLength == dataDepth)
+                dataDepth = 0;
+            openLength -= elementsLengths[--elementsLength];
+        }
+
+        iterator = markupEnd;
+    }
+    if (openLength > maxLength) /* If the document ended with character data of still-open elements */
+        maxLength = openLength;
+
+    if (elementsLengths != NULL)
+        MemFree(elementsLengths);
+    return maxLength + TMX_XML_NODE_SIZE;
+}
+
 void HandleElementBegin(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
     if (raytmxState == NULL || hoxmlContext == NULL)
         return;
@@ -1236,6 +2814,14 @@ void HandleElementBegin(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext)
         raytmxState->layer = AddGenericLayer(raytmxState, /* isGroup: */ false);
         raytmxState->layer->type = LAYER_TYPE_TILE_LAYER;
         raytmxState->tileLayer = &raytmxState->layer->exact.tileLayer;
+    } else if (strcmp(hoxmlContext->tag, "data") == 0) {
+        /* The <layer>'s 'width' and 'height' attributes have been handled by now. There will be a GID for each cell */
+        /* so make room for all of them up front. */
+        if (raytmxState->tileLayer != NULL && raytmxState->tileLayer->tiles == NULL) {
+            uint64_t cellsLength = (uint64_t)raytmxState->tileLayer->width * raytmxState->tileLayer->height;
+            if (cellsLength <= UINT32_MAX)
+                ReserveTileLayerTiles(&raytmxState->layerTiles, (uint32_t)cellsLength);
+        }
     } else if (strcmp(hoxmlContext->tag, "objectgroup") == 0) {
         /* Allocate a new layer with 'objectGroup' allocated and append it to the current group, if it exists */
         raytmxState->layer = AddGenericLayer(raytmxState, /* isGroup: */ false);
@@ -1373,8 +2959,9 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 raytmxState->tileset->source = (char*)MemAlloc((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->tileset->source, hoxmlContext->value);
                 /* 'source' points to an external TSX file that defines the majority of the tileset. Try to load it. */
+                char path[TMX_PATH_LENGTH];
                 RaytmxExternalTileset externalTileset = LoadTSX(JoinPath(raytmxState->documentDirectory,
-                    hoxmlContext->value));
+                    hoxmlContext->value, path, sizeof(path)), raytmxState->task);
                 if (externalTileset.isSuccess) {
                     /* A <tileset> within a <map> will have two attributes: 'firstgid' and 'source.' The rest of */
                     /* the tileset's details are in the external TSX that 'source' points to. They need to be merged. */
@@ -1443,9 +3030,20 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             if (strcmp(hoxmlContext->attribute, "source") == 0) {
                 raytmxState->image->source = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->image->source, hoxmlContext->value);
-                RaytmxCachedTextureNode* cachedTexture = LoadCachedTexture(raytmxState, hoxmlContext->value);
-                if (cachedTexture != NULL)
-                     raytmxState->image->texture = cachedTexture->texture;
+                char path[TMX_PATH_LENGTH];
+                JoinPath(raytmxState->documentDirectory, hoxmlContext->value, path, sizeof(path));
+                raytmxState->image->path = (char*)MemAllocZero((unsigned int)strlen(path) + 1);
+                StringCopy(raytmxState->image->path, path);
+                /* When packing atlases, tilesets' images are loaded once all of them are known. Until then, the */
+                /* images of tilesets and tileset tiles are left without textures. */
+                /* When loading headlessly, no images get textures. */
+                bool isDeferred = (tmxLoadFlags & LOAD_PACK_ATLAS) &&
+                    (raytmxState->tilesetTile != NULL || raytmxState->tileset != NULL);
+                if (!isDeferred && !(tmxLoadFlags & LOAD_HEADLESS)) {
+                    RaytmxCachedTextureNode* cachedTexture = LoadCachedTexture(raytmxState, hoxmlContext->value);
+                    if (cachedTexture != NULL)
+                         raytmxState->image->texture = cachedTexture->texture;
+                }
             } else if (strcmp(hoxmlContext->attribute, "trans") == 0) {
                 raytmxState->image->trans = GetColorFromHexString(hoxmlContext->value);
                 raytmxState->image->hasTrans = true;
@@ -1471,7 +3069,7 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 raytmxState->tilesetTile->height = atoi(hoxmlContext->value);
         } else { /* If the <tile> corresponds to a layer tile */
             if (strcmp(hoxmlContext->attribute, "gid") == 0)
-                AddTileLayerTile(raytmxState, atoi(hoxmlContext->value));
+                AddTileLayerTile(&raytmxState->layerTiles, atoi(hoxmlContext->value));
         }
     } /* strcmp(hoxmlContext->tag, "tile") == 0 */
     else if (strcmp(hoxmlContext->tag, "frame") == 0) {
@@ -1596,7 +3194,8 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 StringCopyN(y, iterator, terminator - iterator); /* Copy 'iterator' up to but excluding 'terminator' */
                 y[terminator - iterator] = '\0';
                 /* Create a linked list node to hold the point and append it to the linked list */
-                RaytmxPolyPointNode* node = (RaytmxPolyPointNode*)MemAllocZero(sizeof(RaytmxPolyPointNode));
+                RaytmxPolyPointNode* node = (RaytmxPolyPointNode*)AllocFromArena(&raytmxState->arena,
+                    sizeof(RaytmxPolyPointNode));
                 node->point.x = (float)(raytmxState->object->x + atof(x));
                 node->point.y = (float)(raytmxState->object->y + atof(y));
                 vertexSum.x += node->point.x;
@@ -1629,15 +3228,13 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                     points[0].x = vertexSum.x / (pointsLength - 2);
                     points[0].y = vertexSum.y / (pointsLength - 2);
                 }
-                /* Copy the points as Vector2s into the array and free the nodes while we're at it */
+                /* Copy the points as Vector2s into the array */
                 RaytmxPolyPointNode* iteratorNode = pointsRoot;
                 uint32_t i = isPolygon ? 1 : 0; /* Skip over the first element, the centroid, for polygons only */
                 while (iteratorNode != NULL) {
                     points[i] = iteratorNode->point;
-                    RaytmxPolyPointNode* parent = iteratorNode;
                     iteratorNode = iteratorNode->next;
                     i += 1;
-                    MemFree(parent);
                 }
                 /* End the list with the first point. Both polygons and polylines use this when drawing. */
                 points[pointsLength - 1].x = points[1].x;
@@ -1771,13 +3368,11 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             return;
         /* Allocate the array and assign NULL to every index to be safe */
         TmxProperty* properties = (TmxProperty*)MemAllocZero(sizeof(TmxProperty) * raytmxState->propertiesLength);
-        /* Copy the TmxProperty pointers into the array and free the nodes while we're at it */
+        /* Copy the TmxProperty pointers into the array */
         RaytmxPropertyNode* iterator = raytmxState->propertiesRoot;
         for (uint32_t i = 0; i < raytmxState->propertiesLength; i++) {
             properties[i] = iterator->property;
-            RaytmxPropertyNode* parent = iterator;
             iterator = iterator->next;
-            MemFree(parent);
         }
         /* Add the properties array to the element it applies to */
         /* A <property>, or rather its parent <properties>, can be within 10+ other elements. The order of the checks */
@@ -1904,13 +3499,11 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 /* Allocate the array and zeroize every index as initialization */
                 TmxTilesetTile* tiles = (TmxTilesetTile*)MemAllocZero(sizeof(TmxTilesetTile) *
                     raytmxState->tilesetTilesLength);
-                /* Copy the TmxTilesetTile pointers into the array and free the nodes while we're at it */
+                /* Copy the TmxTilesetTile pointers into the array */
                 RaytmxTilesetTileNode* iterator = raytmxState->tilesetTilesRoot;
                 for (uint32_t i = 0; i < raytmxState->tilesetTilesLength; i++) {
                     tiles[i] = iterator->tile;
-                    RaytmxTilesetTileNode* parent = iterator;
                     iterator = iterator->next;
-                    MemFree(parent);
                 }
                 /* Add the tiles array to the tileset */
                 raytmxState->tileset->tiles = tiles;
@@ -1923,8 +3516,17 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
         }
         raytmxState->tileset = NULL;
     } /* strcmp(hoxmlContext->tag, "tileset") == 0 */
-    else if (strcmp(hoxmlContext->tag, "image") == 0)
+    else if (strcmp(hoxmlContext->tag, "image") == 0) {
+        /* Without a texture to go by, the dimensions of images are needed for tiles' source rectangles. Documents */
+        /* written by Tiled have them but they're optional. */
+        TmxImage* image = raytmxState->image;
+        if (image != NULL && (tmxLoadFlags & LOAD_HEADLESS) && (image->width == 0 || image->height == 0) &&
+                image->path != NULL) {
+            if (!ReadImageFileDimensions(image->path, &image->width, &image->height))
+                TraceLog(LOG_WARNING, "RAYTMX: Unable to read the dimensions of image \"%s\"", image->path);
+        }
         raytmxState->image = NULL;
+    }
     else if (strcmp(hoxmlContext->tag, "animation") == 0) {
         if (raytmxState->tilesetTile != NULL && raytmxState->tilesetTile->hasAnimation) {
             if (raytmxState->animationFramesRoot == NULL)
@@ -1932,17 +3534,26 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             /* Allocate the array and zeroize every index as initialization */
             TmxAnimationFrame* frames = (TmxAnimationFrame*)MemAllocZero(sizeof(TmxAnimationFrame) *
                 raytmxState->animationFramesLength);
-            /* Copy the TmxAnimationFrame pointers into the array and free the nodes while we're at it */
+            /* Copy the TmxAnimationFrame pointers into the array */
             RaytmxAnimationFrameNode* iterator = raytmxState->animationFramesRoot;
             for (uint32_t i = 0; i < raytmxState->animationFramesLength; i++) {
                 frames[i] = iterator->frame;
-                RaytmxAnimationFrameNode* parent = iterator;
                 iterator = iterator->next;
-                MemFree(parent);
+            }
+            /* Sum the frames' durations so the frame displayed at any given time can be found with a binary search */
+            /* Note: The durations are summed as the whole milliseconds they were written as. Summing their (inexact) */
+            /* floating point equivalents in seconds would put frames' ends ever so slightly off of, for example, */
+            /* 0.1 or 0.2. */
+            double* frameEnds = (double*)MemAllocZero(sizeof(double) * raytmxState->animationFramesLength);
+            double frameEndMilliseconds = 0.0;
+            for (uint32_t i = 0; i < raytmxState->animationFramesLength; i++) {
+                frameEndMilliseconds += floor(((double)frames[i].duration * 1000.0) + 0.5);
+                frameEnds[i] = frameEndMilliseconds / 1000.0;
             }
             /* Add the frames array to the tile's animation */
             raytmxState->tilesetTile->animation.frames = frames;
             raytmxState->tilesetTile->animation.framesLength = raytmxState->animationFramesLength;
+            raytmxState->tilesetTile->animation.frameEnds = frameEnds;
             /* Clean up the state object */
             raytmxState->animationFramesRoot = NULL;
             raytmxState->animationFramesTail = NULL;
@@ -1953,36 +3564,8 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
         raytmxState->animationFrame = NULL;
     else if (strcmp(hoxmlContext->tag, "layer") == 0) {
         if (raytmxState->tileLayer != NULL) {
-            /* If there were 1+ <tile>s within this <layer> but this <layer> already has tiles (from a <data>?) */
-            if (raytmxState->layerTilesRoot != NULL && raytmxState->tileLayer->tiles != NULL) {
-                TraceLog(LOG_WARNING, "RAYTMX: layer \"%s\" has more than one source of tile data - the latter tiles "
-                    "for this layer will be dropped", raytmxState->layer->name);
-                /* Free the nodes and tiles therein */
-                RaytmxTileLayerTileNode* iterator = raytmxState->layerTilesRoot;
-                while (iterator != NULL) {
-                    RaytmxTileLayerTileNode* parent = iterator;
-                    iterator = iterator->next;
-                    MemFree(parent);
-                }
-            } else {
-                /* Allocate the array and zeroize every index as initialization */
-                uint32_t* tiles = (uint32_t*)MemAllocZero(sizeof(uint32_t) * raytmxState->layerTilesLength);
-                /* Copy the GID into the array and free the nodes while we're at it */
-                RaytmxTileLayerTileNode* iterator = raytmxState->layerTilesRoot;
-                for (uint32_t i = 0; i < raytmxState->layerTilesLength; i++) {
-                    tiles[i] = iterator->gid;
-                    RaytmxTileLayerTileNode* parent = iterator;
-                    iterator = iterator->next;
-                    MemFree(parent);
-                }
-                /* Add the tiles array to the tile layer */
-                raytmxState->tileLayer->tiles = tiles;
-                raytmxState->tileLayer->tilesLength = raytmxState->layerTilesLength;
-            }
-            /* Clean up the state object */
-            raytmxState->layerTilesRoot = NULL;
-            raytmxState->layerTilesTail = NULL;
-            raytmxState->layerTilesLength = 0;
+            /* Hand any GIDs given by <tile>s to the layer. Those of Base64 or CSV data are handed over later. */
+            SetTileLayerTiles(raytmxState->layer, &raytmxState->layerTiles);
         }
         raytmxState->tileLayer = NULL;
         raytmxState->layer = NULL;
@@ -2004,136 +3587,26 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
         if (raytmxState->image != NULL) {
             /* TODO (?): The TMX map format documentation says an <image> can contain a <data> element but doesn't */
             /* provide any more information than that. Tiled doesn't seem to have a feature for this either. */
-        } else if (raytmxState->tileLayer != NULL && raytmxState->tileLayer->tiles != NULL) {
+        } else if (raytmxState->tileLayer != NULL && (raytmxState->tileLayer->tiles != NULL ||
+                (raytmxState->layerDataTail != NULL && raytmxState->layerDataTail->layer == raytmxState->layer))) {
             TraceLog(LOG_WARNING, "RAYTMX: layer \"%s\" has more than one source of tile data - the latter tiles for "
                 "this layer will be dropped", raytmxState->layer->name);
         } else if (raytmxState->tileLayer != NULL && raytmxState->tileLayer->encoding != NULL) {
-            RaytmxTileLayerTileNode* tiles = NULL;
-            if (strcmp(raytmxState->tileLayer->encoding, "base64") == 0) {
-                /* The layer's data is a series of unsigned, 32-bit integers encoded as a Base64 string. But, XML */
-                /* considers everything between <data> and </data> to be content meaning there is probably some */
-                /* whitespace on both ends of the content we need to ignore. So, find the actual start and stop: */
-                char *encodedStart = hoxmlContext->content, *encodedEnd;
-                while (isspace(*encodedStart))
-                    encodedStart++;
-                encodedEnd = encodedStart + strlen(encodedStart) - 1;
-                while (encodedEnd > encodedStart && isspace(*encodedEnd))
-                    encodedEnd--;
-
-                /* With the string of encoded Base64 data trimmed, decode it */
-                int decodedLength;
-                unsigned char* decoded = DecodeDataBase64((const unsigned char*)encodedStart, &decodedLength);
-                if (decoded != NULL) {
-                    if (raytmxState->tileLayer->compression == NULL) { /* If the Base64-encoded data is uncompressed */
-                        /* Iterate through N bytes ('decodedLength') with every four bytes being a single GID */
-                        /* resulting in N / 4 tiles */
-                        uint32_t* iterator = (uint32_t*)decoded;
-                        for (int i = 0; i < decodedLength / 4; i++) {
-                            AddTileLayerTile(raytmxState, *iterator);
-                            iterator += 1; /* Point to the next unsigned, 32-bit integer in the decoded data */
-                        }
-                    } else { /* If the Base-64encoded data is also compressed */
-                        if (strcmp(raytmxState->tileLayer->compression, "gzip") == 0 ||
-                                strcmp(raytmxState->tileLayer->compression, "zlib") == 0) {
-                            unsigned char* postHeaderDecoded = NULL;
-                            if (strcmp(raytmxState->tileLayer->compression, "gzip") == 0) {
-                                /* The first two bytes of a GZIP header are expected to be a magic number, 0x1F8B, */
-                                /* identifying the format and the third is expected to indicate the compression */
-                                /* method where 0x08 is DEFLATE. */
-                                /* If these values are found, decompression can continue */
-                                if (decoded[0] == 0x1F && decoded[1] == 0x8B && decoded[2] == 0x08) {
-                                    /* Skip past the GZIP header. The header is typically ten bytes. The bytes not */
-                                    /* checked are unimportant things like a timestamp and OS ID. Additional optional */
-                                    /* headers are possible but not used by Tiled so they are assumed to be missing. */
-                                    postHeaderDecoded = decoded + 10;
-                                } else { /* If the GZIP header doesn't match a decompressable one */
-                                    TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" uses GZIP compression but the stream's "
-                                        "header doesn't indicate DEFLATE compression", raytmxState->layer->name);
-                                }
-                            } else /* if (strcmp(raytmxState->tileLayer->compression, "zlib") == 0) */ {
-                                /* The first byte of a ZLIB header is expected to be 0x78 where the 8 indicates the */
-                                /* DEFLATE compression method and the 7 is "compression info" that indicates a 32K */
-                                /* LZ77 window size and, in practice, cannot be anything else. */
-                                /* If these values are found, decompression can continue */
-                                if (decoded[0] == 0x78) {
-                                    /* Skip past the ZLIB header. The header is two bytes. */
-                                    postHeaderDecoded = decoded + 2;
-                                } else { /* If the ZLIB header doesn't match a decompressable one */
-                                    TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" uses ZLIB compression but the stream's "
-                                        "header doesn't indicate DEFLATE compression", raytmxState->layer->name);
-                                }
-                            }
-
-                            if (postHeaderDecoded != NULL) {
-                                /* "zlib" and "gzip" both use the DEFLATE algorithm and raylib provides a */
-                                /* decompression function when it's built with SUPPORT_COMPRESSION_API (default) */
-                                int decompressedLength;
-                                unsigned char* decompressed = DecompressData(postHeaderDecoded, decodedLength,
-                                    &decompressedLength);
-                                if (decompressed != NULL && decompressedLength > 0) {
-                                    uint32_t* iterator = (uint32_t*)decompressed;
-                                    for (int i = 0; i < decompressedLength / 4; i++) {
-                                        AddTileLayerTile(raytmxState, *iterator);
-                                        iterator += 1; /* Point to the next unsigned integer in the decompressed data */
-                                    }
-                                    MemFree(decompressed); /* Free the memory allocated by DecompressData() */
-                                } else { /* raylib wasn't built with compression or allocation failed */
-                                    TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" compressed with \"%s\" cannot be parsed "
-                                        "because DEFLATE decompression failed - either raylib was not built with "
-                                        "SUPPORT_COMPRESSION_API or memory allocation failed", raytmxState->layer->name,
-                                        raytmxState->tileLayer->compression);
-                                }
-                            }
-                        } else {
-                            TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" cannot be parsed because the compression method "
-                                "\"%s\" is unsupported", raytmxState->layer->name, raytmxState->tileLayer->compression);
-                        }
-                    }
-                    MemFree(decoded); /* Free the memory allocated by DecodeDataBase64() */
-                } else {
-                    TraceLog(LOG_ERROR, "RAYTMX: Unable to decode Base64 data for layer \"%s\"",
-                        raytmxState->layer->name);
-                }
-            } /* strcmp(raytmxState->tileLayer->encoding, "base64") == 0 */
-            else if (strcmp(raytmxState->tileLayer->encoding, "csv") == 0) {
-                /* The Comma-Separated Value (CSV) list herein is a series of Global IDs (GIDs) of tiles in the form */
-                /* "31,32,33" where 31, 32, and 33 are GIDs */
-                char valueAsString[16]; /* Needs to fit all digits of a single value - should be more than enough */
-                char* iterator = hoxmlContext->content;
-                while (*iterator != '\0') { /* While not pointing to the end of the end of the string */
-                    memset(valueAsString, '\0', 16); /* Reset the value-as-a-string buffer with all zeroes */
-                    /* Copy each character into the buffer until either a comma or the terminator is reached */
-                    for (int i = 0; *iterator != ',' && *iterator != '\0'; i++) {
-                        valueAsString[i] = *iterator;
-                        iterator++;
-                    }
-                    if (*iterator == ',') /* If iteration was paused by a comma */
-                        iterator++; /* Advance one character so the comma isn't parsed with the value next iteration */
-                    AddTileLayerTile(raytmxState, atoi(valueAsString)); /* Read the value as an integer GID */
-                }
-            } /* strcmp(raytmxState->tileLayer->encoding, "csv") == 0 */
-
-            if (tiles != NULL) { /* If there was no error in parsing the data and there's a linked list of tiles */
-                /* Allocate the array and assign 0 to every index to be safe */
-                uint32_t* tiles = (uint32_t*)MemAlloc(sizeof(uint32_t) * raytmxState->layerTilesLength);
-                memset(tiles, 0, sizeof(uint32_t) * raytmxState->layerTilesLength);
-                /* Copy the GIDs into the array and free the nodes while we're at it */
-                RaytmxTileLayerTileNode* layerTilesIterator = raytmxState->layerTilesRoot;
-                for (uint32_t i = 0; i < raytmxState->layerTilesLength; i++) {
-                    tiles[i] = layerTilesIterator->gid;
-                    RaytmxTileLayerTileNode* layerTilesTemp = layerTilesIterator;
-                    layerTilesIterator = layerTilesIterator->next;
-                    MemFree(layerTilesTemp);
-                }
-                /* Add the tiles array to the element it applies to */
-                raytmxState->tileLayer->tiles = tiles;
-                raytmxState->tileLayer->tilesLength = raytmxState->layerTilesLength;
-                /* Clean up the state object */
-                raytmxState->layerTilesRoot = NULL;
-                raytmxState->layerTilesTail = NULL;
-                raytmxState->layerTilesLength = 0;
+            const char* compression = raytmxState->tileLayer->compression;
+            if (strcmp(raytmxState->tileLayer->encoding, "base64") == 0 && compression != NULL &&
+                    strcmp(compression, "gzip") != 0 && strcmp(compression, "zlib") != 0 &&
+                    strcmp(compression, "zstd") != 0) {
+                TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" cannot be parsed because the compression method \"%s\" is "
+                    "unsupported", raytmxState->layer->name, compression);
+            } else if (strcmp(raytmxState->tileLayer->encoding, "base64") == 0 ||
+                    strcmp(raytmxState->tileLayer->encoding, "csv") == 0) {
+                /* Decoding, and decompressing, the data waits until the whole document has been parsed so that */
+                /* every layer's data can be decoded at once, on as many threads as there are layers or cores */
+                AddLayerData(raytmxState, hoxmlContext);
             }
         } /* raytmxState->tileLayer != NULL && raytmxState->tileLayer->encoding != NULL */
+        raytmxState->layerDataContent = NULL;
+        raytmxState->layerDataContentLength = 0;
     } /* strcmp(hoxmlContext->tag, "data") == 0 */
     else if (strcmp(hoxmlContext->tag, "objectgroup") == 0) {
         if (raytmxState->objectGroup != NULL) {
@@ -2142,42 +3615,23 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             /* Allocate the arrays and zeroize every index as initialization */
             TmxObject* objects = (TmxObject*)MemAllocZero(sizeof(TmxObject) * raytmxState->objectsLength);
             uint32_t* ySortedObjects = (uint32_t*)MemAllocZero(sizeof(uint32_t) * raytmxState->objectsLength);
-            /* Create a contiguous array of TmxObjects, create a sorted linked list of indexes within that array of */
-            /* TmxObjects (sorted by ascending y-coordinate), and free the object linked list */
-            RaytmxObjectNode *objectsIterator = raytmxState->objectsRoot, *objectsTemp;
-            RaytmxObjectSortingNode *sortingRoot = NULL, *sortingIterator, *sortingTemp, *newSortingNode;
+            RaytmxObjectSortKey* sortKeys = (RaytmxObjectSortKey*)MemAllocZero(sizeof(RaytmxObjectSortKey) *
+                raytmxState->objectsLength);
+            /* Create a contiguous array of TmxObjects along with an array of their y-coordinates and indexes, the */
+            /* keys to sort them by */
+            RaytmxObjectNode* objectsIterator = raytmxState->objectsRoot;
             for (uint32_t i = 0; objectsIterator != NULL; i++) {
                 objects[i] = objectsIterator->object;
-                /* Add a new node into the sorted list */
-                newSortingNode = (RaytmxObjectSortingNode*)MemAllocZero(sizeof(RaytmxObjectSortingNode));
-                newSortingNode->y = objects[i].y;
-                newSortingNode->index = i;
-                if (sortingRoot == NULL) /* If this is the first node */
-                    sortingRoot = newSortingNode;
-                else if (sortingRoot->y >= newSortingNode->y) { /* If replacing the root node */
-                    newSortingNode->next = sortingRoot;
-                    sortingRoot = newSortingNode;
-                } else { /* If inserting at some location after the root */
-                    sortingIterator = sortingRoot;
-                    while (sortingIterator->next != NULL && newSortingNode->y > sortingIterator->next->y)
-                        sortingIterator = sortingIterator->next;
-                    newSortingNode->next = sortingIterator->next;
-                    sortingIterator->next = newSortingNode;
-                }
-                /* Free the object node */
-                objectsTemp = objectsIterator;
+                sortKeys[i].y = objects[i].y;
+                sortKeys[i].index = i;
                 objectsIterator = objectsIterator->next;
-                MemFree(objectsTemp);
-            }
-            /* Create a contiguous array from the sorted linked list such that index 0 of this array points to the */
-            /* TmxObject (via its index in 'objects') with the lowest (visually, highest) y-coordinate */
-            sortingIterator = sortingRoot;
-            for (uint32_t i = 0; sortingIterator != NULL; i++) {
-                ySortedObjects[i] = sortingIterator->index;
-                sortingTemp = sortingIterator;
-                sortingIterator = sortingIterator->next;
-                MemFree(sortingTemp);
             }
+            /* Sort the keys and create an array from them such that index 0 of this array points to the TmxObject */
+            /* (via its index in 'objects') with the lowest (visually, highest) y-coordinate */
+            qsort(sortKeys, raytmxState->objectsLength, sizeof(RaytmxObjectSortKey), CompareObjectSortKeys);
+            for (uint32_t i = 0; i < raytmxState->objectsLength; i++)
+                ySortedObjects[i] = sortKeys[i].index;
+            MemFree(sortKeys);
             /* Add the objects and ySortedObjects array to the object layer */
             raytmxState->objectGroup->objects = objects;
             raytmxState->objectGroup->objectsLength = raytmxState->objectsLength;
@@ -2261,7 +3715,8 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                             uint32_t propertiesLength = 0;
                             /* Add the properties from the instanced <object> */
                             for (uint32_t i = 0; i < raytmxState->object->propertiesLength; i++) {
-                                node = (RaytmxPropertyNode*)MemAllocZero(sizeof(RaytmxPropertyNode));
+                                node = (RaytmxPropertyNode*)AllocFromArena(&raytmxState->arena,
+                                    sizeof(RaytmxPropertyNode));
                                 node->property = raytmxState->object->properties[i];
                                 if (propertiesRoot == NULL)
                                     propertiesRoot = node;
@@ -2283,7 +3738,8 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                                     propertiesIterator = propertiesIterator->next;
                                 }
                                 if (isNew) {
-                                    node = (RaytmxPropertyNode*)MemAllocZero(sizeof(RaytmxPropertyNode));
+                                    node = (RaytmxPropertyNode*)AllocFromArena(&raytmxState->arena,
+                                        sizeof(RaytmxPropertyNode));
                                     node->property = objectTemplate.object.properties[i];
                                     if (propertiesRoot == NULL)
                                         propertiesRoot = node;
@@ -2299,13 +3755,11 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                             raytmxState->object->properties =
                                 (TmxProperty*)MemAllocZero(sizeof(TmxProperty) * propertiesLength);
                             raytmxState->object->propertiesLength = propertiesLength;
-                            /* Copy the TmxProperty entires into the array and free the nodes while we're at it */
+                            /* Copy the TmxProperty entires into the array */
                             RaytmxPropertyNode* propertiesIterator = propertiesRoot;
                             for (uint32_t i = 0; propertiesIterator != NULL; i++) {
                                 raytmxState->object->properties[i] = propertiesIterator->property;
-                                RaytmxPropertyNode* propertiesTemp = propertiesIterator;
                                 propertiesIterator = propertiesIterator->next;
-                                MemFree(propertiesTemp);
                             }
                         }
                     }
@@ -2379,7 +3833,8 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 StringCopy(objectText->fontFamily, "sans-serif");
             }
 
-            if (objectText->content != NULL) { /* If there's text to be drawn */
+            /* Laying out text needs raylib's default font, which is a texture, so it's skipped when loading headlessly */
+            if (objectText->content != NULL && !(tmxLoadFlags & LOAD_HEADLESS)) { /* If there's text to be drawn */
                 RaytmxTextLineNode *linesRoot = NULL, *linesTail = NULL;
                 uint32_t linesLength = 0;
 
@@ -2468,7 +3923,8 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                         line.spacing = spacing;
                         /* Note: The number of lines is not yet known but needs to be for Y positioning */
 
-                        RaytmxTextLineNode* node = (RaytmxTextLineNode*)MemAllocZero(sizeof(RaytmxTextLineNode));
+                        RaytmxTextLineNode* node = (RaytmxTextLineNode*)AllocFromArena(&raytmxState->arena,
+                            sizeof(RaytmxTextLineNode));
                         node->line = line;
                         if (linesRoot == NULL)
                             linesRoot = node;
@@ -2499,7 +3955,7 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 if (linesRoot != NULL) {
                     /* Allocate the array and zero out every value as initialization */
                     TmxTextLine* lines = (TmxTextLine*)MemAllocZero(sizeof(TmxTextLine) * linesLength);
-                    /* Copy the TmxTextLines into the array and free the nodes while we're at it */
+                    /* Copy the TmxTextLines into the array */
                     RaytmxTextLineNode* iterator = linesRoot;
                     for (uint32_t i = 0; i < linesLength; i++) {
                         lines[i] = iterator->line;
@@ -2575,9 +4031,7 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                         } else /* if (objectText->valign == VERTICAL_ALIGNMENT_TOP) */
                             lines[i].position.y = (float)object->y + (float)(objectText->pixelSize * i);
 
-                        RaytmxTextLineNode* parent = iterator;
                         iterator = iterator->next;
-                        MemFree(parent);
                     }
                     /* Add the lines array to the text object */
                     objectText->lines = lines;
@@ -2596,18 +4050,6 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
     }
 }
 
-void FreeStateLayers(RaytmxLayerNode* layers) {
-    RaytmxLayerNode *layersIterator = layers, *layersTemp;
-    while (layersIterator != NULL) {
-        /* Group layers may have children, forming a tree-like structure. Free the children. */
-        FreeStateLayers(layersIterator->childrenRoot);
-        /* Iterate to the next node and free this one */
-        layersTemp = layersIterator;
-        layersIterator = layersIterator->next;
-        MemFree(layersTemp);
-    }
-}
-
 void FreeState(RaytmxState* raytmxState) {
     if (raytmxState == NULL)
         return;
@@ -2623,6 +4065,7 @@ void FreeState(RaytmxState* raytmxState) {
         MemFree(cachedTextureTemp);
     }
     raytmxState->texturesRoot = NULL;
+    FreeHashTable(&raytmxState->texturesTable);
     RaytmxCachedTemplateNode *cachedTemplateIterator = raytmxState->templatesRoot, *cachedTemplateTemp;
     while (cachedTemplateIterator != NULL) {
         cachedTemplateTemp = cachedTemplateIterator;
@@ -2633,6 +4076,7 @@ void FreeState(RaytmxState* raytmxState) {
         MemFree(cachedTemplateTemp);
     }
     raytmxState->templatesRoot = NULL;
+    FreeHashTable(&raytmxState->templatesTable);
 
     raytmxState->property = NULL;
     raytmxState->tileset = NULL;
@@ -2647,85 +4091,46 @@ void FreeState(RaytmxState* raytmxState) {
     raytmxState->imageLayer = NULL;
     raytmxState->object = NULL;
 
-    /* Free each property in the linked list of properties */
-    RaytmxPropertyNode *propertiesIterator = raytmxState->propertiesRoot, *propertiesTemp;
-    while (propertiesIterator != NULL) {
-        propertiesTemp = propertiesIterator;
-        propertiesIterator = propertiesIterator->next;
-        MemFree(propertiesTemp);
-    }
-    /* Zeroize this linked list's properties */
+    /* Zeroize the linked lists' properties. Their nodes, including those of the layers' tree-like structure, are */
+    /* all freed at once along with the arena they were allocated from. */
     raytmxState->propertiesRoot = NULL;
     raytmxState->propertiesTail = NULL;
     raytmxState->propertiesLength = 0;
-
-    /* Free each node in the linked list of tilesets */
-    RaytmxTilesetNode *tilesetsIterator = raytmxState->tilesetsRoot, *tilesetsTemp;
-    while (tilesetsIterator != NULL) {
-        tilesetsTemp = tilesetsIterator;
-        tilesetsIterator = tilesetsIterator->next;
-        MemFree(tilesetsTemp);
-    }
-    /* Zeroize this linked list's properties */
     raytmxState->tilesetsRoot = NULL;
     raytmxState->tilesetsTail = NULL;
     raytmxState->tilesetsLength = 0;
-
-    /* Free each node in the linked list of tileset tiles */
-    RaytmxTilesetTileNode *tilesetTilesIterator = raytmxState->tilesetTilesRoot, *tilesetTilesTemp;
-    while (tilesetTilesIterator != NULL) {
-        tilesetTilesTemp = tilesetTilesIterator;
-        tilesetTilesIterator = tilesetTilesIterator->next;
-        MemFree(tilesetTilesTemp);
-    }
-    /* Zeroize this linked list's properties */
     raytmxState->tilesetTilesRoot = NULL;
     raytmxState->tilesetTilesTail = NULL;
     raytmxState->tilesetTilesLength = 0;
-
-    /* Free each node in the linked list of animation frames */
-    RaytmxAnimationFrameNode *animationFramesIterator = raytmxState->animationFramesRoot, *animationFramesTemp;
-    while (animationFramesIterator != NULL) {
-        animationFramesTemp = animationFramesIterator;
-        animationFramesIterator = animationFramesIterator->next;
-        MemFree(animationFramesTemp);
-    }
-    /* Zeroize this linked list's properties */
     raytmxState->animationFramesRoot = NULL;
     raytmxState->animationFramesTail = NULL;
     raytmxState->animationFramesLength = 0;
-
-    /* Layers may be groups. The resulting collection isn't a link list as much as it is a tree. So freeing layers is */
-    /* best done with a recursive approach. */
-    FreeStateLayers(raytmxState->layersRoot);
-    /* Zeroize this linked list's properties */
     raytmxState->layersRoot = NULL;
     raytmxState->layersTail = NULL;
+    raytmxState->groupNode = NULL;
     raytmxState->layersLength = 0;
-
-    /* Free each node in the linked list of layer tiles */
-    RaytmxTileLayerTileNode *layerTilesIterator = raytmxState->layerTilesRoot, *layerTilesTemp;
-    while (layerTilesIterator != NULL) {
-        layerTilesTemp = layerTilesIterator;
-        layerTilesIterator = layerTilesIterator->next;
-        MemFree(layerTilesTemp);
-    }
-    /* Zeroize this linked list's properties */
-    raytmxState->layerTilesRoot = NULL;
-    raytmxState->layerTilesTail = NULL;
-    raytmxState->layerTilesLength = 0;
-
-    /* Free each node in the linked list of objects */
-    RaytmxObjectNode *objectsIterator = raytmxState->objectsRoot, *objectsTemp;
-    while (objectsIterator != NULL) {
-        objectsTemp = objectsIterator;
-        objectsIterator = objectsIterator->next;
-        MemFree(objectsTemp);
-    }
-    /* Zeroize this linked list's properties */
     raytmxState->objectsRoot = NULL;
     raytmxState->objectsTail = NULL;
     raytmxState->objectsLength = 0;
+
+    /* Free the content and GIDs of any layer data that was never decoded, as happens when parsing fails */
+    for (RaytmxLayerDataNode* node = raytmxState->layerDataRoot; node != NULL; node = node->next) {
+        if (node->content != NULL && node->isContentCopied)
+            MemFree((void*)node->content);
+        if (node->tiles.gids != NULL)
+            MemFree(node->tiles.gids);
+    }
+    raytmxState->layerDataRoot = NULL;
+    raytmxState->layerDataTail = NULL;
+    raytmxState->layerDataLength = 0;
+    FreeArena(&raytmxState->arena);
+
+    /* Free the GIDs of a tile layer that never ended */
+    if (raytmxState->layerTiles.gids != NULL)
+        MemFree(raytmxState->layerTiles.gids);
+    raytmxState->layerTiles.gids = NULL;
+    raytmxState->layerTiles.length = 0;
+    raytmxState->layerTiles.capacity = 0;
 }
 
 void inline FreeString(char* str) {
@@ -2739,7 +4144,9 @@ void FreeTileset(TmxTileset tileset) {
     FreeString(tileset.classString);
     if (tileset.hasImage) {
         FreeString(tileset.image.source);
-        UnloadTexture(tileset.image.texture);
+        FreeString(tileset.image.path);
+        if (tileset.image.texture.id != 0) /* If the texture was loaded, as opposed to packed in an atlas */
+            ReleaseTexture(tileset.image.texture);
     }
     if (tileset.properties != NULL) {
         for (uint32_t i = 0; i < tileset.propertiesLength; i++)
@@ -2750,7 +4157,9 @@ void FreeTileset(TmxTileset tileset) {
         TmxTilesetTile tile = tileset.tiles[i];
         if (tile.hasImage) {
             FreeString(tile.image.source);
-            UnloadTexture(tile.image.texture);
+            FreeString(tile.image.path);
+            if (tile.image.texture.id != 0) /* If the texture was loaded, as opposed to packed in an atlas */
+                ReleaseTexture(tile.image.texture);
             if (tile.properties != NULL) {
                 for (uint32_t j = 0; j < tile.propertiesLength; j++)
                     FreeProperty(tile.properties[j]);
@@ -2759,6 +4168,8 @@ void FreeTileset(TmxTileset tileset) {
         }
         if (tile.hasAnimation && tile.animation.frames != NULL)
             MemFree(tile.animation.frames);
+        if (tile.hasAnimation && tile.animation.frameEnds != NULL)
+            MemFree(tile.animation.frameEnds);
     }
 }
 
@@ -2780,15 +4191,28 @@ void FreeLayer(TmxLayer layer) {
         FreeString(layer.exact.tileLayer.encoding);
         FreeString(layer.exact.tileLayer.compression);
         MemFree(layer.exact.tileLayer.tiles);
+        if (layer.exact.tileLayer.chunks != NULL) {
+            for (uint32_t i = 0; i < layer.exact.tileLayer.chunksWidth * layer.exact.tileLayer.chunksHeight; i++)
+                FreeTileChunk(&layer.exact.tileLayer.chunks[i]);
+            MemFree(layer.exact.tileLayer.chunks);
+        }
     break;
     case LAYER_TYPE_OBJECT_GROUP:
         for (uint32_t j = 0; j < layer.exact.objectGroup.objectsLength; j++)
             FreeObject(layer.exact.objectGroup.objects[j]);
         MemFree(layer.exact.objectGroup.objects);
+        if (layer.exact.objectGroup.ySortedObjects != NULL)
+            MemFree(layer.exact.objectGroup.ySortedObjects);
+        if (layer.exact.objectGroup.index != NULL)
+            FreeObjectIndex(layer.exact.objectGroup.index);
     break;
     case LAYER_TYPE_IMAGE_LAYER:
-        if (layer.exact.imageLayer.hasImage)
-            UnloadTexture(layer.exact.imageLayer.image.texture);
+        if (layer.exact.imageLayer.hasImage) {
+            FreeString(layer.exact.imageLayer.image.source);
+            FreeString(layer.exact.imageLayer.image.path);
+            if (layer.exact.imageLayer.image.texture.id != 0) /* If the texture was loaded */
+                ReleaseTexture(layer.exact.imageLayer.image.texture);
+        }
     break;
     case LAYER_TYPE_GROUP: break; /* Nothing to do for this case but compilers like to complain */
     }
@@ -2813,200 +4237,469 @@ void FreeObject(TmxObject object) {
     } /* object.text != NULL */
 }
 
-void DrawTMXTileLayer(const TmxMap* map, Rectangle screenRect, TmxLayer layer, int posX, int posY, Color tint) {
-    if (map == NULL || layer.type != LAYER_TYPE_TILE_LAYER || layer.exact.tileLayer.tilesLength == 0)
+void DrawTMXLayerList(const TmxMap* map, const Camera2D* camera, const TmxLayer* layers, uint32_t layersLength,
+        int posX, int posY, Color tint) {
+    if (map == NULL || layers == NULL || layersLength == 0)
         return;
 
-    TmxTileLayer tileLayer = layer.exact.tileLayer;
-    switch (map->renderOrder) {
-    case RENDER_ORDER_RIGHT_DOWN:
-        for (int32_t y = 0; y < (int32_t)map->height; y++) {
-            for (int32_t x = 0; x < (int32_t)map->width; x++) {
-                /* Note: Layers have a one-dimensional list of GIDs. The order they're in implies their coordinates. */
-                /* The GIDs are stored in right-down order meaning index zero is the top-left tile, index <map width> */
-                /* is the top-right tile, and <length - 1> is the bottom-right tile. So, the index in that list can */
-                /* be calculated from X and Y: (<Y> * <map width>) + <X>. */
-                /* Note: 'x' and 'y' use tiles as units, not pixels. The (pixel) X position is straightforward: */
-                /* <X> * <tile width>. The (pixel) Y position is similarly simple: <Y> * <tile height>. */
-                DrawTMXLayerTile(/* map: */ map,
-                                 /* screenRect: */ screenRect,
-                                 /* rawGid: */ tileLayer.tiles[(y * map->width) + x],
-                                 /* posX: */ posX + (x * map->tileWidth),
-                                 /* posY: */ posY + (y * map->tileHeight),
-                                 /* tint: */ tint);
-            }
+    for (uint32_t i = 0; i < layersLength; i++) {
+        TmxLayer layer = layers[i];
+        if (!layers[i].visible) /* If the layer is not visible */
+            continue; /* Skip it - it's literally invisible */
+
+        /* All types of layers can have a couple attributes that affect color: 'opacity' and 'tintcolor' */
+        Color layerTint = tint;
+        layerTint.a = (unsigned char)((double)layerTint.a * layer.opacity);
+        if (layer.hasTintColor)
+            layerTint = ColorTint(layerTint, layer.tintColor);
+
+        Rectangle screenRect;
+        if (camera != NULL) {
+            screenRect.width = GetScreenWidth() / camera->zoom;
+            screenRect.height = GetScreenHeight() / camera->zoom;
+            screenRect.x = camera->target.x - (screenRect.width / 2.0f);
+            screenRect.y = camera->target.y - (screenRect.height / 2.0f);
+        } else {
+            screenRect.x = 0.0f;
+            screenRect.y = 0.0f;
+            screenRect.width = (float)GetScreenWidth();
+            screenRect.height = (float)GetScreenHeight();
         }
-    break;
-    case RENDER_ORDER_RIGHT_UP:
-        for (int32_t y = (int32_t)map->height - 1; y >= 0; y--) {
-            for (int32_t x = 0; x < (int32_t)map->width; x++) {
-                DrawTMXLayerTile(map, screenRect, tileLayer.tiles[(y * map->width) + x], posX + (x * map->tileWidth),
-                    posY + (y * map->tileHeight), tint);
-            }
+
+        int32_t parallaxOffsetX = 0, parallaxOffsetY = 0;
+        if (camera != NULL) {
+            parallaxOffsetX = (int32_t)((double)(camera->target.x - map->parallaxOriginX) * (layer.parallaxX - 1.0));
+            parallaxOffsetY = (int32_t)((double)(camera->target.y - map->parallaxOriginY) * (layer.parallaxY - 1.0));
         }
-    break;
-    case RENDER_ORDER_LEFT_DOWN:
-        for (int32_t y = 0; y < (int32_t)map->height; y++) {
-            for (int32_t x = (int32_t)map->width - 1; x >= 0; x--) {
-                DrawTMXLayerTile(map, screenRect, tileLayer.tiles[(y * map->width) + x], posX + (x * map->tileWidth),
-                    posY + (y * map->tileHeight), tint);
-            }
+
+        switch (layer.type) {
+        case LAYER_TYPE_TILE_LAYER:
+            DrawTMXTileLayer(map, screenRect, layer, posX + layer.offsetX + parallaxOffsetX,
+                posY + layer.offsetY + parallaxOffsetY, layerTint);
+            break;
+        case LAYER_TYPE_OBJECT_GROUP:
+            DrawTMXObjectGroup(map, screenRect, layer, posX + layer.offsetX + parallaxOffsetX,
+                posY + layer.offsetY + parallaxOffsetY, layerTint);
+            break;
+        case LAYER_TYPE_IMAGE_LAYER:
+            if (layer.exact.imageLayer.hasImage) {
+                EndTileBatch(); /* DrawTexture() begins its own batch */
+                DrawTexture(/* texture: */ layer.exact.imageLayer.image.texture,
+                    /* posX: */ posX + layer.offsetX + parallaxOffsetX,
+                    /* posY: */ posY + layer.offsetY + parallaxOffsetY, /* tint: */ layerTint);
+            } break;
+        case LAYER_TYPE_GROUP:
+            DrawTMXLayerList(map, camera, layer.layers, layer.layersLength, posX + layer.offsetX + parallaxOffsetX,
+                posY + layer.offsetY + parallaxOffsetY, layerTint);
+            break;
         }
-    break;
-    case RENDER_ORDER_LEFT_UP:
-        for (int32_t y = (int32_t)map->height - 1; y >= 0; y--) {
-            for (int32_t x = (int32_t)map->width - 1; x >= 0; x--) {
-                DrawTMXLayerTile(map, screenRect, tileLayer.tiles[(y * map->width) + x], posX + (x * map->tileWidth),
-                    posY + (y * map->tileHeight), tint);
+    }
+}
+
+void DrawTMXTileLayer(const TmxMap* map, Rectangle screenRect, TmxLayer layer, int posX, int posY, Color tint) {
+    if (map == NULL || layer.type != LAYER_TYPE_TILE_LAYER || layer.exact.tileLayer.tilesLength == 0 || tint.a == 0)
+        return;
+
+    /* Determine the range of cells that may be visible. A cell at column <X> is drawn at <posX> + <X> * <tile width> */
+    /* and its tile may cover any part of the map's tile bounds relative to that position. Solving for the columns */
+    /* (and rows) that could overlap the screen rectangle gives a conservative range. Each tile within it still gets */
+    /* an exact visibility check but the cells outside of it, potentially the vast majority, are never visited. */
+    int32_t firstX = 0, firstY = 0, lastX = (int32_t)map->width - 1, lastY = (int32_t)map->height - 1;
+    if (map->tileWidth > 0 && map->tileHeight > 0) {
+        Rectangle bounds = map->tileBounds;
+        float minX = floorf((screenRect.x - (float)posX - (bounds.x + bounds.width)) / (float)map->tileWidth);
+        float maxX = ceilf((screenRect.x + screenRect.width - (float)posX - bounds.x) / (float)map->tileWidth);
+        float minY = floorf((screenRect.y - (float)posY - (bounds.y + bounds.height)) / (float)map->tileHeight);
+        float maxY = ceilf((screenRect.y + screenRect.height - (float)posY - bounds.y) / (float)map->tileHeight);
+        /* Clamp while still floating point so that extreme camera positions or zooms can't overflow the integers */
+        if (minX > (float)firstX)
+            firstX = minX <= (float)lastX ? (int32_t)minX : lastX + 1;
+        if (maxX < (float)lastX)
+            lastX = maxX >= (float)firstX ? (int32_t)maxX : firstX - 1;
+        if (minY > (float)firstY)
+            firstY = minY <= (float)lastY ? (int32_t)minY : lastY + 1;
+        if (maxY < (float)lastY)
+            lastY = maxY >= (float)firstY ? (int32_t)maxY : firstY - 1;
+    }
+    if (firstX > lastX || firstY > lastY) /* If no part of this layer can be on the screen */
+        return;
+
+    TmxTileLayer tileLayer = layer.exact.tileLayer;
+    if (tileLayer.chunks == NULL)
+        return;
+
+    /* Prepare the chunks in view. Those drawn for the first time, or whose tiles were replaced, have their geometry */
+    /* built and those already built have any animated quads brought up to date with the current frames. */
+    int32_t firstChunkX = firstX / RAYTMX_CHUNK_SIZE, lastChunkX = lastX / RAYTMX_CHUNK_SIZE;
+    int32_t firstChunkY = firstY / RAYTMX_CHUNK_SIZE, lastChunkY = lastY / RAYTMX_CHUNK_SIZE;
+    for (int32_t chunkY = firstChunkY; chunkY <= lastChunkY; chunkY++) {
+        for (int32_t chunkX = firstChunkX; chunkX <= lastChunkX; chunkX++) {
+            TmxTileChunk* chunk = &tileLayer.chunks[(chunkY * tileLayer.chunksWidth) + chunkX];
+            if (!chunk->isBuilt)
+                BuildTileChunk(map, &tileLayer, chunk, (uint32_t)chunkX, (uint32_t)chunkY);
+            else if (chunk->animatedQuadsLength > 0)
+                UpdateTileChunkAnimations(map, &tileLayer, chunk);
+
+            /* When the whole chunk is on the screen, its quads can be submitted without checking each one */
+            Rectangle bounds = chunk->bounds;
+            bounds.x += (float)posX;
+            bounds.y += (float)posY;
+            chunk->isFullyVisible = bounds.x > screenRect.x && bounds.y > screenRect.y &&
+                bounds.x + bounds.width < screenRect.x + screenRect.width &&
+                bounds.y + bounds.height < screenRect.y + screenRect.height;
+        }
+    }
+
+    /* Tiles are drawn row by row, in the map's render order, with each row being the concatenation of the visible */
+    /* chunks' rows. Drawing whole chunks one after another would be simpler but tiles that extend beyond their cells */
+    /* would then overlap in a different order than the one Tiled uses. */
+    bool isLeftToRight = map->renderOrder == RENDER_ORDER_RIGHT_DOWN || map->renderOrder == RENDER_ORDER_RIGHT_UP;
+    bool isTopToBottom = map->renderOrder == RENDER_ORDER_RIGHT_DOWN || map->renderOrder == RENDER_ORDER_LEFT_DOWN;
+    for (int32_t i = 0; i <= lastY - firstY; i++) {
+        int32_t y = isTopToBottom ? firstY + i : lastY - i, row = y % RAYTMX_CHUNK_SIZE;
+        for (int32_t j = 0; j <= lastChunkX - firstChunkX; j++) {
+            int32_t chunkX = isLeftToRight ? firstChunkX + j : lastChunkX - j;
+            const TmxTileChunk* chunk = &tileLayer.chunks[((y / RAYTMX_CHUNK_SIZE) * tileLayer.chunksWidth) + chunkX];
+            uint32_t rowStart = chunk->rowStarts[row], rowLength = chunk->rowStarts[row + 1] - rowStart;
+            for (uint32_t k = 0; k < rowLength; k++) {
+                const RaytmxTileQuad* quad = &chunk->quads[isLeftToRight ? rowStart + k : rowStart + rowLength - 1 - k];
+                if (quad->textureId == 0) /* If this is an animation whose current frame has nothing to draw */
+                    continue;
+                if (!chunk->isFullyVisible) {
+                    /* Note: The first and third corners are always opposites regardless of any flipping */
+                    Rectangle destRect;
+                    destRect.x = (float)posX + fminf(quad->positions[0].x, quad->positions[2].x);
+                    destRect.y = (float)posY + fminf(quad->positions[0].y, quad->positions[2].y);
+                    destRect.width = fabsf(quad->positions[2].x - quad->positions[0].x);
+                    destRect.height = fabsf(quad->positions[2].y - quad->positions[0].y);
+                    if (!CheckCollisionRecs(screenRect, destRect)) /* If the tile is not visible */
+                        continue;
+                }
+                SubmitTileQuad(quad, (float)posX, (float)posY, tint);
             }
         }
-    break;
     }
 }
 
-void DrawTextureTile(Texture2D texture, Rectangle source, Rectangle dest, bool flipX, bool flipY, bool flipDiag,
-        Color tint) {
-    if (texture.id == 0) /* If the texture is invalid */
+void DrawTextureTile(const TmxTile* tile, Rectangle dest, uint32_t flipIndex, Color tint) {
+    if (tile->texture.id == 0) /* If the texture is invalid */
         return;
 
-    float textureWidth = (float)texture.width;
-    float textureHeight = (float)texture.height;
-
-    /* Determine the area within the texture to be drawn */
-    /* Note: The coordinates here are in the [0.0, 1.0] range where (0.0, 0.0) is the bottom-left corner of the */
-    /* texture, (1.0, 0.0) is the bottom-right, and (1.0, 1.0) is the top-right. In other words, the coordinates are */
-    /* a ratio of the dimensions making (0.5, 0.5) the center of the texture regardless of its aspect ratio. */
-    Vector2 sourceTopLeft, sourceTopRight, sourceBottomLeft, sourceBottomRight;
-    sourceTopLeft.x = source.x / textureWidth;
-    sourceTopLeft.y = source.y / textureHeight;
-    sourceTopRight.x = (source.x + source.width) / textureWidth;
-    sourceTopRight.y = source.y / textureHeight;
-    sourceBottomLeft.x = source.x / textureWidth;
-    sourceBottomLeft.y = (source.y + source.height) / textureHeight;
-    sourceBottomRight.x = (source.x + source.width) / textureWidth;
-    sourceBottomRight.y = (source.y + source.height) / textureHeight;
-    if (flipDiag) { /* If the tile uses a diagonal flip */
-        /* "The diagonal flip should flip the bottom left and top right corners of the tile..." */
-        Vector2 temp = sourceBottomLeft;
-        sourceBottomLeft = sourceTopRight;
-        sourceTopRight = temp;
-    }
+    RaytmxTileQuad quad;
+    GetTextureTileQuad(tile, dest, flipIndex, &quad);
+    SubmitTileQuad(&quad, 0.0f, 0.0f, tint);
+}
+
+/* For each combination of flip flags, as indexed by GetFlipIndex(), the corners of the source and destination */
+/* rectangles assigned to the quad's four vertices. Corners are numbered as in TmxTile's 'texcoords': top-left (0), */
+/* bottom-left (1), bottom-right (2), and top-right (3). */
+/* Note: "The diagonal flip should flip the bottom left and top right corners of the tile..." which is applied to */
+/* the source corners before any horizontal or vertical flip. A horizontal and vertical flip combined rotate the */
+/* destination corners instead. */
+static const uint8_t tmxFlipTexcoords[8][4] = {
+    { 0, 1, 2, 3 }, /* None */
+    { 0, 3, 2, 1 }, /* Diagonal */
+    { 1, 0, 3, 2 }, /* Vertical */
+    { 3, 0, 1, 2 }, /* Vertical and diagonal */
+    { 3, 2, 1, 0 }, /* Horizontal */
+    { 1, 2, 3, 0 }, /* Horizontal and diagonal */
+    { 0, 1, 2, 3 }, /* Horizontal and vertical */
+    { 0, 3, 2, 1 }  /* Horizontal, vertical, and diagonal */
+};
+static const uint8_t tmxFlipPositions[8][4] = {
+    { 0, 1, 2, 3 }, { 0, 1, 2, 3 }, { 0, 1, 2, 3 }, { 0, 1, 2, 3 },
+    { 0, 1, 2, 3 }, { 0, 1, 2, 3 }, { 2, 3, 0, 1 }, { 2, 3, 0, 1 }
+};
 
+void GetTextureTileQuad(const TmxTile* tile, Rectangle dest, uint32_t flipIndex, RaytmxTileQuad* quad) {
     /* Determine the area on the screen to be drawn to */
-    Vector2 destTopLeft, destTopRight, destBottomLeft, destBottomRight;
-    destTopLeft.x = dest.x;
-    destTopLeft.y = dest.y;
-    destTopRight.x = dest.x + dest.width;
-    destTopRight.y = dest.y;
-    destBottomLeft.x = dest.x;
-    destBottomLeft.y = dest.y + dest.height;
-    destBottomRight.x = dest.x + dest.width;
-    destBottomRight.y = dest.y + dest.height;
-
-    rlSetTexture(texture.id);
-    rlBegin(RL_QUADS);
-    {
-        rlColor4ub(tint.r, tint.g, tint.b, tint.a);
-        rlNormal3f(0.0f, 0.0f, 1.0f); /* Normal vector pointing towards viewer */
-
-        /* Top-left corner of the quad */
-        if (flipX && !flipY)
-            rlTexCoord2f(sourceTopRight.x, sourceTopRight.y);
-        else if (flipY && !flipX)
-            rlTexCoord2f(sourceBottomLeft.x, sourceBottomLeft.y);
-        else
-            rlTexCoord2f(sourceTopLeft.x, sourceTopLeft.y);
-        if (flipX && flipY)
-            rlVertex2f(destBottomRight.x, destBottomRight.y);
-        else
-            rlVertex2f(destTopLeft.x, destTopLeft.y);
+    Vector2 destCorners[4];
+    destCorners[0].x = dest.x; /* Top-left */
+    destCorners[0].y = dest.y;
+    destCorners[1].x = dest.x; /* Bottom-left */
+    destCorners[1].y = dest.y + dest.height;
+    destCorners[2].x = dest.x + dest.width; /* Bottom-right */
+    destCorners[2].y = dest.y + dest.height;
+    destCorners[3].x = dest.x + dest.width; /* Top-right */
+    destCorners[3].y = dest.y;
+
+    /* The vertices are, in order, the top-left, bottom-left, bottom-right, and top-right corners of the quad. The */
+    /* tables say which corners of the source and destination each one takes given the flip flags. */
+    quad->textureId = tile->texture.id;
+    for (int i = 0; i < 4; i++) {
+        quad->texcoords[i] = tile->texcoords[tmxFlipTexcoords[flipIndex][i]];
+        quad->positions[i] = destCorners[tmxFlipPositions[flipIndex][i]];
+    }
+}
 
-        /* Bottom-left corner of the quad */
-        if (flipX && !flipY)
-            rlTexCoord2f(sourceBottomRight.x, sourceBottomRight.y);
-        else if (flipY && !flipX)
-            rlTexCoord2f(sourceTopLeft.x, sourceTopLeft.y);
-        else
-            rlTexCoord2f(sourceBottomLeft.x, sourceBottomLeft.y);
-        if (flipX && flipY)
-            rlVertex2f(destTopRight.x, destTopRight.y);
-        else
-            rlVertex2f(destBottomLeft.x, destBottomLeft.y);
+void SubmitTileQuad(const RaytmxTileQuad* quad, float posX, float posY, Color tint) {
+    /* Rather than beginning and ending a batch per tile, tiles are appended to an open batch for as long as they */
+    /* share a texture. Only when the texture changes is the batch ended and a new one begun. */
+    if (!tmxIsBatchOpen || tmxBatchTextureId != quad->textureId) {
+        EndTileBatch();
+        rlSetTexture(quad->textureId);
+        rlBegin(RL_QUADS);
+        tmxIsBatchOpen = true;
+        tmxBatchTextureId = quad->textureId;
+        tmxDrawStats.batches += 1;
+    }
+    /* raylib's vertex buffer has a fixed size. When this quad wouldn't fit, raylib draws the buffer's contents and */
+    /* starts over. The texture and mode are retained so the open batch simply continues in the fresh buffer. */
+    if (rlCheckRenderBatchLimit(4))
+        tmxDrawStats.batches += 1;
+    tmxDrawStats.quads += 1;
+
+    rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+    rlNormal3f(0.0f, 0.0f, 1.0f); /* Normal vector pointing towards viewer */
+    for (int i = 0; i < 4; i++) {
+        rlTexCoord2f(quad->texcoords[i].x, quad->texcoords[i].y);
+        rlVertex2f(posX + quad->positions[i].x, posY + quad->positions[i].y);
+    }
+}
 
-        /* Bottom-right corner of the quad */
-        if (flipX && !flipY)
-            rlTexCoord2f(sourceBottomLeft.x, sourceBottomLeft.y);
-        else if (flipY && !flipX)
-            rlTexCoord2f(sourceTopRight.x, sourceTopRight.y);
-        else
-            rlTexCoord2f(sourceBottomRight.x, sourceBottomRight.y);
-        if (flipX && flipY)
-            rlVertex2f(destTopLeft.x, destTopLeft.y);
-        else
-            rlVertex2f(destBottomRight.x, destBottomRight.y);
+void EndTileBatch(void) {
+    if (!tmxIsBatchOpen)
+        return;
 
-        /* Top-right corner of the quad */
-        if (flipX && !flipY)
-            rlTexCoord2f(sourceTopLeft.x, sourceTopLeft.y);
-        else if (flipY && !flipX)
-            rlTexCoord2f(sourceBottomRight.x, sourceBottomRight.y);
-        else
-            rlTexCoord2f(sourceTopRight.x, sourceTopRight.y);
-        if (flipX && flipY)
-            rlVertex2f(destBottomLeft.x, destBottomLeft.y);
-        else
-            rlVertex2f(destTopRight.x, destTopRight.y);
-    }
     rlEnd();
     rlSetTexture(0);
+    tmxIsBatchOpen = false;
 }
 
-void DrawTMXLayerTile(const TmxMap* map, Rectangle screenRect, int32_t rawGid, int posX, int posY, Color tint) {
-    if (map == NULL || tint.a == 0)
-        return;
+void UpdateDisplayGids(TmxMap* map) {
+    for (uint32_t i = 0; i < map->animatedGidsLength; i++) {
+        uint32_t animatedGid = map->animatedGids[i];
+        /* Animations aren't really tiles. Instead, they contain frames that identify a tile to draw for the duration */
+        /* of that frame. Follow them to the tile currently being displayed. A frame may itself be an animation so */
+        /* the depth is limited in case an animation, directly or indirectly, references itself. */
+        int32_t gid = (int32_t)animatedGid;
+        for (int depth = 0; ; depth++) {
+            const TmxTile* tile = &map->gidsToTiles[gid];
+            if (!tile->hasAnimation) /* If the tile currently displayed has been found */
+                break;
+            if (depth == 8 || tile->animation.framesLength == 0) {
+                gid = 0;
+                break;
+            }
+            /* The 'gid' of an animation tile is assigned with the first GID of the tileset and the frames have local */
+            /* IDs within that tileset. The GID of the frame, then, can be calculated by adding them together. */
+            gid = tile->gid + tile->animation.frames[tile->frameIndex].id;
+            /* If the GID is outside the range of known GIDs or isn't known to exist in any tilesets within the map */
+            if (gid <= 0 || gid >= (int32_t)map->gidsToTilesLength || map->gidsToTiles[gid].gid <= 0) {
+                gid = 0;
+                break;
+            }
+        }
+        map->displayGids[animatedGid] = gid;
+    }
+}
+
+void SetTileTexcoords(TmxMap* map) {
+    for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++) {
+        TmxTile* tile = &map->gidsToTiles[gid];
+        if (tile->texture.width <= 0 || tile->texture.height <= 0) /* If unused, an animation, or textureless */
+            continue;
+
+        float textureWidth = (float)tile->texture.width, textureHeight = (float)tile->texture.height;
+        float left = tile->sourceRect.x / textureWidth;
+        float top = tile->sourceRect.y / textureHeight;
+        float right = (tile->sourceRect.x + tile->sourceRect.width) / textureWidth;
+        float bottom = (tile->sourceRect.y + tile->sourceRect.height) / textureHeight;
+        tile->texcoords[0].x = left; /* Top-left */
+        tile->texcoords[0].y = top;
+        tile->texcoords[1].x = left; /* Bottom-left */
+        tile->texcoords[1].y = bottom;
+        tile->texcoords[2].x = right; /* Bottom-right */
+        tile->texcoords[2].y = bottom;
+        tile->texcoords[3].x = right; /* Top-right */
+        tile->texcoords[3].y = top;
+    }
+}
 
-    bool isFlippedHorizontally, isFlippedVertically, isFlippedDiagonally, isRotatedHexagonal120;
-    /* Tile Global IDs (GIDs) can have several bit flags that indicate transforms. This function is used to both get */
-    /* those possible transform flags as well as the actual GID value without those bit flags. */
-    int32_t gid = GetGid(rawGid, &isFlippedHorizontally, &isFlippedVertically, &isFlippedDiagonally,
-        &isRotatedHexagonal120);
+bool GetLayerTileQuad(const TmxMap* map, uint32_t rawGid, uint32_t x, uint32_t y, RaytmxTileQuad* quad) {
+    /* Tile Global IDs (GIDs) can have several bit flags that indicate transforms. Separate the actual GID value */
+    /* from those flags, the latter of which become an index into the precalculated corner tables. */
+    int32_t gid = GetGid((int32_t)rawGid, NULL, NULL, NULL, NULL);
     if (gid >= (int32_t)map->gidsToTilesLength) /* If the GID is outside the range of known GIDs */
-        return; /* Do not attempt to draw this time */
-    /* With the GID, grab the relevant tile information (texture, animation, etc.) from the global mapping */
-    TmxTile tile = map->gidsToTiles[gid];
-    if (tile.gid <= 0) /* If the GID is not known to exist in any tilesets within the map */
-        return; /* Do not attempt to draw this tile */
+        return false;
+    /* Look up the tile actually displayed which, for an animation, is that of its current frame */
+    gid = map->displayGids[gid];
+    if (gid <= 0) /* If the GID is not known to exist in any tilesets within the map, or has nothing to display */
+        return false;
+
+    const TmxTile* tile = &map->gidsToTiles[gid];
+    if (tile->texture.id == 0 || tile->sourceRect.width <= 0.0f || tile->sourceRect.height <= 0.0f)
+        return false;
+
+    /* Determine where the tile will be drawn relative to the layer. TMX considers a tile's [x, y] to be its */
+    /* bottom-left corner where raylib considers it the top-left so tiles taller than the map's tile height extend */
+    /* further up. See DrawTMXLayerTile() for more. */
+    Rectangle destRect;
+    destRect.x = (float)(x * map->tileWidth) + tile->offset.x;
+    destRect.y = (float)(y * map->tileHeight) + tile->offset.y + (float)map->tileHeight - tile->sourceRect.height;
+    destRect.width = tile->sourceRect.width;
+    destRect.height = tile->sourceRect.height;
+    GetTextureTileQuad(tile, destRect, GetFlipIndex((int32_t)rawGid), quad);
+    return true;
+}
 
-    if (tile.hasAnimation) {
-        /* Animations aren't really tiles. Instead, they contain frames that identify a tile to draw for the duration */
-        /* of that frame. */
-        /* The 'gid' of an animation tile is assigned with the first GID of the tileset and the frames have local IDs */
-        /* within that tileset. The GID of the frame, then, can be calculated by adding them together. */
-        gid = tile.gid + tile.animation.frames[tile.frameIndex].id;
-        /* Copy any flip flags that may be present in the layer data. */
-        gid |= rawGid & (FLIP_FLAG_HORIZONTAL | FLIP_FLAG_VERTICAL | FLIP_FLAG_DIAGONAL | FLIP_FLAG_ROTATE_120);
-        /* Draw the tile using the calculated GID of the frame, along with the possible flags. */
-        DrawTMXLayerTile(map, screenRect, gid, posX, posY, tint);
-    } else {
-        /* Determine where the tile will be drawn. raylib's coordinates consider [x, y] to be the top-left corner of */
-        /* the rectangle being drawn. The TMX documentation complicates things a bit saying "Larger tiles will extend */
-        /* at the top and right (anchored to the bottom left)" meaning that TMX considers [x, y] to be the */
-        /* bottom-left corner. The simplest way to reconcile the Y coordinate differences is to substract the */
-        /* texture's height at Y + 1. This way, tiles larger than the map's tile height values will be drawn further */
-        /* up (negative Y direction). */
-        Rectangle destRect;
-        destRect.x = posX + tile.offset.x;
-        destRect.y = posY + tile.offset.y + map->tileHeight - tile.sourceRect.height;
-        destRect.width = tile.sourceRect.width;
-        destRect.height = tile.sourceRect.height;
+void BuildTileChunk(const TmxMap* map, const TmxTileLayer* tileLayer, TmxTileChunk* chunk, uint32_t chunkX,
+        uint32_t chunkY) {
+    FreeTileChunk(chunk); /* In case the chunk is being rebuilt */
+
+    uint32_t left = chunkX * RAYTMX_CHUNK_SIZE, top = chunkY * RAYTMX_CHUNK_SIZE;
+    uint32_t right = left + RAYTMX_CHUNK_SIZE < map->width ? left + RAYTMX_CHUNK_SIZE : map->width;
+    uint32_t bottom = top + RAYTMX_CHUNK_SIZE < map->height ? top + RAYTMX_CHUNK_SIZE : map->height;
+
+    /* Count the non-empty tiles, and the animated ones among them, to size the arrays. Some of these tiles may turn */
+    /* out to have nothing to draw but this is a close upper bound. */
+    uint32_t quadsCapacity = 0, animatedQuadsCapacity = 0;
+    for (uint32_t y = top; y < bottom; y++) {
+        for (uint32_t x = left; x < right; x++) {
+            uint32_t index = (y * map->width) + x;
+            if (index >= tileLayer->tilesLength || tileLayer->tiles[index] == 0)
+                continue;
+            quadsCapacity += 1;
+            int32_t gid = (int32_t)(tileLayer->tiles[index] &
+                ~(FLIP_FLAG_HORIZONTAL | FLIP_FLAG_VERTICAL | FLIP_FLAG_DIAGONAL | FLIP_FLAG_ROTATE_120));
+            if (gid < (int32_t)map->gidsToTilesLength && map->gidsToTiles[gid].hasAnimation)
+                animatedQuadsCapacity += 1;
+        }
+    }
+    if (quadsCapacity > 0)
+        chunk->quads = (RaytmxTileQuad*)MemAllocZero(sizeof(RaytmxTileQuad) * quadsCapacity);
+    if (animatedQuadsCapacity > 0)
+        chunk->animatedQuads = (RaytmxAnimatedQuad*)MemAllocZero(sizeof(RaytmxAnimatedQuad) * animatedQuadsCapacity);
+
+    bool hasBounds = false;
+    float boundsLeft = 0.0f, boundsTop = 0.0f, boundsRight = 0.0f, boundsBottom = 0.0f;
+    for (uint32_t row = 0; row < RAYTMX_CHUNK_SIZE; row++) {
+        chunk->rowStarts[row] = (uint16_t)chunk->quadsLength;
+        uint32_t y = top + row;
+        if (y >= bottom || quadsCapacity == 0)
+            continue;
+
+        for (uint32_t x = left; x < right; x++) {
+            uint32_t index = (y * map->width) + x;
+            if (index >= tileLayer->tilesLength || tileLayer->tiles[index] == 0)
+                continue;
 
-        /* If the screen and destination rectangles are overlapping to any degree (i.e. if the tile is visible) */
-        if (CheckCollisionRecs(screenRect, destRect)) {
-            DrawTextureTile(/* texture: */ tile.texture, /* source: */ tile.sourceRect, /* dest: */ destRect,
-                /* flipX: */ isFlippedHorizontally, /* flipY: */ isFlippedVertically,
-                /* flipDiag: */ isFlippedDiagonally, /* tint: */ tint);
+            RaytmxTileQuad quad;
+            bool isDrawable = GetLayerTileQuad(map, tileLayer->tiles[index], x, y, &quad);
+            int32_t gid = GetGid((int32_t)tileLayer->tiles[index], NULL, NULL, NULL, NULL);
+            if (gid < (int32_t)map->gidsToTilesLength && map->gidsToTiles[gid].hasAnimation) { /* If an animation */
+                /* Animated tiles always get a quad, even if the current frame has nothing to draw, so that there's a */
+                /* place for the frames that do */
+                if (!isDrawable)
+                    memset(&quad, 0, sizeof(RaytmxTileQuad));
+                RaytmxAnimatedQuad* animatedQuad = &chunk->animatedQuads[chunk->animatedQuadsLength++];
+                animatedQuad->tileIndex = index;
+                animatedQuad->quadIndex = chunk->quadsLength;
+                animatedQuad->gid = map->displayGids[gid];
+            } else if (!isDrawable)
+                continue;
+
+            if (isDrawable) {
+                /* Note: The first and third corners are always opposites regardless of any flipping */
+                float quadLeft = fminf(quad.positions[0].x, quad.positions[2].x);
+                float quadTop = fminf(quad.positions[0].y, quad.positions[2].y);
+                float quadRight = fmaxf(quad.positions[0].x, quad.positions[2].x);
+                float quadBottom = fmaxf(quad.positions[0].y, quad.positions[2].y);
+                if (!hasBounds || quadLeft < boundsLeft)
+                    boundsLeft = quadLeft;
+                if (!hasBounds || quadTop < boundsTop)
+                    boundsTop = quadTop;
+                if (!hasBounds || quadRight > boundsRight)
+                    boundsRight = quadRight;
+                if (!hasBounds || quadBottom > boundsBottom)
+                    boundsBottom = quadBottom;
+                hasBounds = true;
+            }
+            chunk->quads[chunk->quadsLength++] = quad;
         }
     }
+    chunk->rowStarts[RAYTMX_CHUNK_SIZE] = (uint16_t)chunk->quadsLength;
+
+    chunk->bounds.x = boundsLeft;
+    chunk->bounds.y = boundsTop;
+    chunk->bounds.width = boundsRight - boundsLeft;
+    chunk->bounds.height = boundsBottom - boundsTop;
+    chunk->isBuilt = true;
+}
+
+void UpdateTileChunkAnimations(const TmxMap* map, const TmxTileLayer* tileLayer, TmxTileChunk* chunk) {
+    for (uint32_t i = 0; i < chunk->animatedQuadsLength; i++) {
+        RaytmxAnimatedQuad* animatedQuad = &chunk->animatedQuads[i];
+        uint32_t rawGid = tileLayer->tiles[animatedQuad->tileIndex];
+        int32_t displayGid = map->displayGids[GetGid((int32_t)rawGid, NULL, NULL, NULL, NULL)];
+        if (displayGid == animatedQuad->gid) /* If the animation is still on the same frame */
+            continue;
+
+        /* The animation has moved on to another frame so rebuild this one quad to match */
+        RaytmxTileQuad* quad = &chunk->quads[animatedQuad->quadIndex];
+        uint32_t x = animatedQuad->tileIndex % map->width, y = animatedQuad->tileIndex / map->width;
+        if (GetLayerTileQuad(map, rawGid, x, y, quad)) {
+            /* Frames may differ in size so the chunk's bounds may need to grow to contain this one */
+            float quadLeft = fminf(quad->positions[0].x, quad->positions[2].x);
+            float quadTop = fminf(quad->positions[0].y, quad->positions[2].y);
+            float quadRight = fmaxf(quad->positions[0].x, quad->positions[2].x);
+            float quadBottom = fmaxf(quad->positions[0].y, quad->positions[2].y);
+            if (chunk->bounds.width > 0.0f && chunk->bounds.height > 0.0f) { /* Unless the bounds are still empty */
+                quadLeft = fminf(quadLeft, chunk->bounds.x);
+                quadTop = fminf(quadTop, chunk->bounds.y);
+                quadRight = fmaxf(quadRight, chunk->bounds.x + chunk->bounds.width);
+                quadBottom = fmaxf(quadBottom, chunk->bounds.y + chunk->bounds.height);
+            }
+            chunk->bounds.x = quadLeft;
+            chunk->bounds.y = quadTop;
+            chunk->bounds.width = quadRight - quadLeft;
+            chunk->bounds.height = quadBottom - quadTop;
+        } else
+            memset(quad, 0, sizeof(RaytmxTileQuad)); /* This frame has nothing to draw */
+        animatedQuad->gid = displayGid;
+    }
+}
+
+void FreeTileChunk(TmxTileChunk* chunk) {
+    if (chunk->quads != NULL)
+        MemFree(chunk->quads);
+    if (chunk->animatedQuads != NULL)
+        MemFree(chunk->animatedQuads);
+    memset(chunk, 0, sizeof(TmxTileChunk));
+}
+
+void DrawTMXLayerTile(const TmxMap* map, Rectangle screenRect, int32_t rawGid, int posX, int posY, Color tint) {
+    if (map == NULL || tint.a == 0)
+        return;
+
+    /* Tile Global IDs (GIDs) can have several bit flags that indicate transforms. Get the actual GID value without */
+    /* those bit flags. The flags themselves are only needed once drawing, by way of GetFlipIndex(). */
+    int32_t gid = GetGid(rawGid, NULL, NULL, NULL, NULL);
+    if (gid >= (int32_t)map->gidsToTilesLength) /* If the GID is outside the range of known GIDs */
+        return; /* Do not attempt to draw this time */
+    /* Animations aren't really tiles. Instead, they contain frames that identify a tile to draw for the duration of */
+    /* that frame. Look up the tile currently displayed which, for static tiles, is simply the same tile. */
+    gid = map->displayGids[gid];
+    if (gid <= 0) /* If the GID is not known to exist in any tilesets within the map, or has nothing to display */
+        return; /* Do not attempt to draw this tile */
+    /* With the GID, grab the relevant tile information (texture, etc.) from the global mapping */
+    TmxTile tile = map->gidsToTiles[gid];
+
+    /* Determine where the tile will be drawn. raylib's coordinates consider [x, y] to be the top-left corner of */
+    /* the rectangle being drawn. The TMX documentation complicates things a bit saying "Larger tiles will extend */
+    /* at the top and right (anchored to the bottom left)" meaning that TMX considers [x, y] to be the */
+    /* bottom-left corner. The simplest way to reconcile the Y coordinate differences is to substract the */
+    /* texture's height at Y + 1. This way, tiles larger than the map's tile height values will be drawn further */
+    /* up (negative Y direction). */
+    Rectangle destRect;
+    destRect.x = posX + tile.offset.x;
+    destRect.y = posY + tile.offset.y + map->tileHeight - tile.sourceRect.height;
+    destRect.width = tile.sourceRect.width;
+    destRect.height = tile.sourceRect.height;
+
+    /* If the screen and destination rectangles are overlapping to any degree (i.e. if the tile is visible) */
+    if (CheckCollisionRecs(screenRect, destRect))
+        DrawTextureTile(&tile, destRect, GetFlipIndex(rawGid), tint);
 }
 
 void DrawTMXObjectTile(const TmxMap* map, Rectangle screenRect, int32_t rawGid, int posX, int posY, float width,
@@ -3014,11 +4707,9 @@ void DrawTMXObjectTile(const TmxMap* map, Rectangle screenRect, int32_t rawGid,
     if (map == NULL || width <= 0 || height <= 0 || tint.a == 0)
         return;
 
-    bool isFlippedHorizontally, isFlippedVertically, isFlippedDiagonally, isRotatedHexagonal120;
-    /* Tile Global IDs (GIDs) can have several bit flags that indicate transforms. This function is used to both get */
-    /* those possible transform flags as well as the actual GID value without those bit flags. */
-    int32_t gid = GetGid(rawGid, &isFlippedHorizontally, &isFlippedVertically, &isFlippedDiagonally,
-        &isRotatedHexagonal120);
+    /* Tile Global IDs (GIDs) can have several bit flags that indicate transforms. Get the actual GID value without */
+    /* those bit flags. The flags themselves are only needed once drawing, by way of GetFlipIndex(). */
+    int32_t gid = GetGid(rawGid, NULL, NULL, NULL, NULL);
     if (gid >= (int32_t)map->gidsToTilesLength) /* If the GID is outside the range of known GIDs */
         return; /* Do not attempt to draw this time */
     /* With the GID, grab the relevant tile information (texture, animation, etc.) from the global mapping */
@@ -3029,7 +4720,8 @@ void DrawTMXObjectTile(const TmxMap* map, Rectangle screenRect, int32_t rawGid,
     if (tile.hasAnimation) {
         /* Animations aren't really tiles. Instead, they contain frames that identify a tile to draw for the duration */
         /* of that frame. That current tile should be drawn. */
-        DrawTMXLayerTile(map, screenRect, tile.gid + tile.animation.frames[tile.frameIndex].id, posX, posY, tint);
+        if (map->displayGids[gid] > 0) /* If the current frame has something to display */
+            DrawTMXLayerTile(map, screenRect, map->displayGids[gid], posX, posY, tint);
     } else {
         /* Determine the area in which to draw, and potentially stretch, the texture. This area matches that of the */
         /* <object>, not the tile size. This also means that the Y coordinate needs consideration because raylib */
@@ -3042,9 +4734,7 @@ void DrawTMXObjectTile(const TmxMap* map, Rectangle screenRect, int32_t rawGid,
 
         /* If the screen and destination rectangles are overlapping to any degree (i.e. if the tile is visible) */
         if (CheckCollisionRecs(screenRect, destRect)) {
-            DrawTextureTile(/* texture: */ tile.texture, /* source: */ tile.sourceRect, /* dest: */ destRect,
-                /* flipX: */ isFlippedHorizontally, /* flipY: */ isFlippedVertically,
-                /* flipDiag: */ isFlippedDiagonally, /* tint: */ tint);
+            DrawTextureTile(&tile, destRect, GetFlipIndex(rawGid), tint);
         }
     }
 }
@@ -3054,6 +4744,36 @@ void DrawTMXObjectGroup(const TmxMap* map, Rectangle screenRect, TmxLayer layer,
         return;
 
     TmxObjectGroup objectGroup = layer.exact.objectGroup;
+    TmxObjectIndex* index = objectGroup.index;
+    if (index != NULL) {
+        /* Find the objects in the screen's vicinity using the spatial index. The index is in the layer's space so the */
+        /* screen rectangle is moved into it. Objects found this way are still subject to the usual visibility checks. */
+        /* A pixel of margin absorbs any rounding differences between the index and the checks. */
+        Rectangle area = screenRect;
+        area.x -= (float)posX + 1.0f;
+        area.y -= (float)posY + 1.0f;
+        area.width += 2.0f;
+        area.height += 2.0f;
+        uint32_t candidatesLength = QueryObjectIndex(index, area, false, false, index->candidates);
+        /* When most of the objects are nearby anyway, sorting them is more work than simply checking every object */
+        if (candidatesLength <= objectGroup.objectsLength / 4) {
+            /* Draw the objects in the <objectgroup>'s draw order. Sorting by the objects' positions within that order */
+            /* and then drawing them results in the same order as a complete iteration. */
+            if (objectGroup.drawOrder == OBJECT_GROUP_DRAW_ORDER_TOP_DOWN) {
+                for (uint32_t i = 0; i < candidatesLength; i++)
+                    index->candidates[i] = index->topDownRanks[index->candidates[i]];
+            }
+            qsort(index->candidates, candidatesLength, sizeof(uint32_t), CompareIndexes);
+            for (uint32_t i = 0; i < candidatesLength; i++) {
+                uint32_t objectIndex = index->candidates[i];
+                if (objectGroup.drawOrder == OBJECT_GROUP_DRAW_ORDER_TOP_DOWN)
+                    objectIndex = objectGroup.ySortedObjects[objectIndex];
+                DrawTMXObject(map, screenRect, &objectGroup, objectGroup.objects[objectIndex], posX, posY, tint);
+            }
+            return;
+        }
+    }
+
     for (int32_t i = 0; i < (int32_t)objectGroup.objectsLength; i++) {
         /* Select the object to draw based on the <objectgroup>'s draw order */
         TmxObject object;
@@ -3061,79 +4781,362 @@ void DrawTMXObjectGroup(const TmxMap* map, Rectangle screenRect, TmxLayer layer,
             object = objectGroup.objects[i];
         else /* if (objectGroup.drawOrder == OBJECT_GROUP_DRAW_ORDER_TOP_DOWN) */
             object = objectGroup.objects[objectGroup.ySortedObjects[i]];
+        DrawTMXObject(map, screenRect, &objectGroup, object, posX, posY, tint);
+    }
+}
 
-        if (object.type == OBJECT_TYPE_TILE) { /* If the object is a tile with an abitrary GID and dimensions */
-            /* Note: This draw method handles occlusion culling so it doesn't need to be done here */
-            DrawTMXObjectTile(map, /* screenRect: */ screenRect, /* rawGid: */ object.gid,
-                /* posX: */ posX + (int)object.x, /* posY: */ posY + (int)object.y, /* width: */ (float)object.width,
-                /* height: */ (float)object.height, /* color: */ tint);
-        } else { /* If the object is any type other than a tile */
-            Rectangle offsetAabb = object.aabb;
-            offsetAabb.x += posX;
-            offsetAabb.y += posY;
-            /* If the screen rectangle and the polygon's AABB are overlapping to any degree (i.e. it is visible) */
-            if (CheckCollisionRecs(screenRect, offsetAabb)) {
-                switch (object.type) {
-                case OBJECT_TYPE_QUAD:
-                    DrawRectangle(/* posX: */ posX + (int)object.x, /* posY: */ posY + (int)object.y,
-                        /* width: */ (int)object.width, /* height: */ (int)object.height,
-                        /* color: */ objectGroup.color);
-                break;
-                case OBJECT_TYPE_ELLIPSE:
-                {
-                    /* The width and height of the object are used here as the semi major and minor axes */
-                    float halfWidth = (float)object.width / 2.0f, halfHeight = (float)object.height / 2.0f;
-                    DrawEllipse(/* centerX: */ posX + (int)(object.x + halfWidth),
-                        /* centerY: */ posY + (int)(object.y + halfHeight), /* radiusH: */ halfWidth,
-                        /* radiusV: */ halfHeight, /* color: */ objectGroup.color);
+void DrawTMXObject(const TmxMap* map, Rectangle screenRect, const TmxObjectGroup* objectGroup, TmxObject object,
+        int posX, int posY, Color tint) {
+    if (object.type == OBJECT_TYPE_TILE) { /* If the object is a tile with an abitrary GID and dimensions */
+        /* Note: This draw method handles occlusion culling so it doesn't need to be done here */
+        DrawTMXObjectTile(map, /* screenRect: */ screenRect, /* rawGid: */ object.gid,
+            /* posX: */ posX + (int)object.x, /* posY: */ posY + (int)object.y, /* width: */ (float)object.width,
+            /* height: */ (float)object.height, /* color: */ tint);
+    } else { /* If the object is any type other than a tile */
+        Rectangle offsetAabb = object.aabb;
+        offsetAabb.x += posX;
+        offsetAabb.y += posY;
+        /* If the screen rectangle and the polygon's AABB are overlapping to any degree (i.e. it is visible) */
+        if (CheckCollisionRecs(screenRect, offsetAabb)) {
+            EndTileBatch(); /* Shapes and text are drawn by raylib functions that begin their own batches */
+            switch (object.type) {
+            case OBJECT_TYPE_QUAD:
+                DrawRectangle(/* posX: */ posX + (int)object.x, /* posY: */ posY + (int)object.y,
+                    /* width: */ (int)object.width, /* height: */ (int)object.height,
+                    /* color: */ objectGroup->color);
+            break;
+            case OBJECT_TYPE_ELLIPSE:
+            {
+                /* The width and height of the object are used here as the semi major and minor axes */
+                float halfWidth = (float)object.width / 2.0f, halfHeight = (float)object.height / 2.0f;
+                DrawEllipse(/* centerX: */ posX + (int)(object.x + halfWidth),
+                    /* centerY: */ posY + (int)(object.y + halfHeight), /* radiusH: */ halfWidth,
+                    /* radiusV: */ halfHeight, /* color: */ objectGroup->color);
+            }
+            break;
+            case OBJECT_TYPE_POINT:
+            DrawCircle(/* centerX: */ (int)object.x, /* centerY: */ (int)object.y,
+                /* radius: */ (float)map->tileWidth / 4.0f, /* color: */ objectGroup->color);
+            break;
+            case OBJECT_TYPE_POLYGON:
+            case OBJECT_TYPE_POLYLINE:
+                /* Copy the 'points' array to the 'offsetPoints' array and apply the drawing position, an offset */
+                /* applied by the layer and/or draw call. The 'offsetPoints' array was allocated at the same time */
+                /* as 'points' with the same size. This is done to improve draw speeds, or to minimize harm. */
+                memcpy(object.points, object.offsetPoints, object.pointsLength);
+                for (uint32_t i = 0; i < object.pointsLength; i++) {
+                    object.offsetPoints[i].x += posX;
+                    object.offsetPoints[i].y += posY;
                 }
-                break;
-                case OBJECT_TYPE_POINT:
-                DrawCircle(/* centerX: */ (int)object.x, /* centerY: */ (int)object.y,
-                    /* radius: */ (float)map->tileWidth / 4.0f, /* color: */ objectGroup.color);
-                break;
-                case OBJECT_TYPE_POLYGON:
-                case OBJECT_TYPE_POLYLINE:
-                    /* Copy the 'points' array to the 'offsetPoints' array and apply the drawing position, an offset */
-                    /* applied by the layer and/or draw call. The 'offsetPoints' array was allocated at the same time */
-                    /* as 'points' with the same size. This is done to improve draw speeds, or to minimize harm. */
-                    memcpy(object.points, object.offsetPoints, object.pointsLength);
-                    for (uint32_t i = 0; i < object.pointsLength; i++) {
-                        object.offsetPoints[i].x += posX;
-                        object.offsetPoints[i].y += posY;
-                    }
-                    /* Use the offset points to draw the poly(gon|line) */
-                    if (object.type == OBJECT_TYPE_POLYGON) {
-                        /* Note: Polygons' first elements are their centroids. DrawTriangleFan() requires this. */
-                        /* Additionally, the last element in 'points' is a duplicate of the first, non-centroid point. */
-                        DrawTriangleFan(/* points: */ object.points, /* pointCount: */ object.pointsLength,
-                            /* color: */ objectGroup.color);
-                    } else /* if (object.type == OBJECT_TYPE_POLYLINE) */ {
-                        /* Note: The last element in 'points' is a duplicate of the first point */
-                        for (uint32_t i = 1; i < object.pointsLength; i++) {
-                            DrawLineEx(/* startPos: */ object.points[i - 1], /* endPos: */ object.points[i],
-                                /* thick: */ TMX_LINE_THICKNESS, /* color: */ objectGroup.color);
-                        }
+                /* Use the offset points to draw the poly(gon|line) */
+                if (object.type == OBJECT_TYPE_POLYGON) {
+                    /* Note: Polygons' first elements are their centroids. DrawTriangleFan() requires this. */
+                    /* Additionally, the last element in 'points' is a duplicate of the first, non-centroid point. */
+                    DrawTriangleFan(/* points: */ object.points, /* pointCount: */ object.pointsLength,
+                        /* color: */ objectGroup->color);
+                } else /* if (object.type == OBJECT_TYPE_POLYLINE) */ {
+                    /* Note: The last element in 'points' is a duplicate of the first point */
+                    for (uint32_t i = 1; i < object.pointsLength; i++) {
+                        DrawLineEx(/* startPos: */ object.points[i - 1], /* endPos: */ object.points[i],
+                            /* thick: */ TMX_LINE_THICKNESS, /* color: */ objectGroup->color);
                     }
-                break;
-                case OBJECT_TYPE_TEXT:
-                    for (uint32_t i = 0; i < object.text->linesLength; i++) {
-                        Vector2 position = object.text->lines[i].position;
-                        position.x += posX;
-                        position.y += posY;
-                        DrawTextEx(/* font: */ object.text->lines[i].font, /* text: */ object.text->lines[i].content,
-                            /* position: */ position, /* fontSize: */ (float)object.text->pixelSize,
-                            /* spacing: */ object.text->lines[i].spacing, /* tint: */ object.text->color);
-                    }
-                break;
-                case OBJECT_TYPE_TILE:
-                    /* Object tile's are handled in the 'if' case of this 'else' block because the use of an AABB for */
-                    /* occlusion culling is not reliable for them */
-                break;
                 }
+            break;
+            case OBJECT_TYPE_TEXT:
+                for (uint32_t i = 0; i < object.text->linesLength; i++) {
+                    Vector2 position = object.text->lines[i].position;
+                    position.x += posX;
+                    position.y += posY;
+                    DrawTextEx(/* font: */ object.text->lines[i].font, /* text: */ object.text->lines[i].content,
+                        /* position: */ position, /* fontSize: */ (float)object.text->pixelSize,
+                        /* spacing: */ object.text->lines[i].spacing, /* tint: */ object.text->color);
+                }
+            break;
+            case OBJECT_TYPE_TILE:
+                /* Object tile's are handled in the 'if' case of this 'else' block because the use of an AABB for */
+                /* occlusion culling is not reliable for them */
+            break;
+            }
+        }
+    }
+}
+
+void BuildObjectIndexes(const TmxMap* map, TmxLayer* layers, uint32_t layersLength) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        TmxLayer* layer = &layers[i];
+        if (layer->type == LAYER_TYPE_OBJECT_GROUP && layer->exact.objectGroup.objectsLength > 0)
+            layer->exact.objectGroup.index = BuildObjectIndex(map, &layer->exact.objectGroup);
+        /* <group> layers may contain object groups of their own so recursively index them too */
+        BuildObjectIndexes(map, layer->layers, layer->layersLength);
+    }
+}
+
+TmxObjectIndex* BuildObjectIndex(const TmxMap* map, const TmxObjectGroup* objectGroup) {
+    uint32_t objectsLength = objectGroup->objectsLength;
+    TmxObjectIndex* index = (TmxObjectIndex*)MemAllocZero(sizeof(TmxObjectIndex));
+    index->bounds = (Rectangle*)MemAllocZero(sizeof(Rectangle) * objectsLength);
+    index->topDownRanks = (uint32_t*)MemAllocZero(sizeof(uint32_t) * objectsLength);
+    index->candidates = (uint32_t*)MemAllocZero(sizeof(uint32_t) * objectsLength);
+    for (uint32_t i = 0; objectGroup->ySortedObjects != NULL && i < objectsLength; i++)
+        index->topDownRanks[objectGroup->ySortedObjects[i]] = i;
+
+    /* Find the area each object may be drawn to and the area they cover altogether */
+    uint32_t indexedLength = 0;
+    float left = INFINITY, top = INFINITY, right = -INFINITY, bottom = -INFINITY;
+    float widthsSum = 0.0f, heightsSum = 0.0f;
+    for (uint32_t i = 0; i < objectsLength; i++) {
+        Rectangle* bounds = &index->bounds[i];
+        if (!GetObjectIndexBounds(map, &objectGroup->objects[i], bounds))
+            continue;
+
+        indexedLength += 1;
+        left = fminf(left, bounds->x);
+        top = fminf(top, bounds->y);
+        right = fmaxf(right, bounds->x + bounds->width);
+        bottom = fmaxf(bottom, bounds->y + bounds->height);
+        widthsSum += bounds->width;
+        heightsSum += bounds->height;
+    }
+
+    /* Choose the grid's dimensions. Aim for roughly one object per cell, as long as the cells don't become smaller */
+    /* than the average object. Smaller cells would mostly just place the same objects in more cells. */
+    index->columns = 1;
+    index->rows = 1;
+    if (indexedLength > 0) {
+        float width = right - left, height = bottom - top;
+        float averageWidth = widthsSum / (float)indexedLength, averageHeight = heightsSum / (float)indexedLength;
+        float columns = 1.0f, rows = 1.0f;
+        if (width > 0.0f && height > 0.0f) {
+            columns = sqrtf((float)indexedLength * width / height);
+            rows = sqrtf((float)indexedLength * height / width);
+        } else if (width > 0.0f)
+            columns = (float)indexedLength;
+        else if (height > 0.0f)
+            rows = (float)indexedLength;
+        if (averageWidth > 0.0f)
+            columns = fminf(columns, width / averageWidth);
+        if (averageHeight > 0.0f)
+            rows = fminf(rows, height / averageHeight);
+        index->columns = (uint32_t)fminf(fmaxf(columns, 1.0f), 1024.0f);
+        index->rows = (uint32_t)fminf(fmaxf(rows, 1.0f), 1024.0f);
+        index->left = left;
+        index->top = top;
+        index->cellWidth = width > 0.0f ? width / (float)index->columns : 1.0f;
+        index->cellHeight = height > 0.0f ? height / (float)index->rows : 1.0f;
+    } else {
+        index->cellWidth = 1.0f;
+        index->cellHeight = 1.0f;
+    }
+
+    index->cellStarts = (uint32_t*)MemAllocZero(sizeof(uint32_t) * ((index->columns * index->rows) + 1));
+    FillObjectIndexCells(index, objectsLength);
+    return index;
+}
+
+bool UpdateObjectIndex(const TmxMap* map, const TmxObjectGroup* objectGroup) {
+    /* Any of the objects may have moved so all of their bounds are found again, but the cells are only refilled if */
+    /* an object now overlaps different cells and nothing is allocated unless they then hold more entries. The grid */
+    /* itself is kept, with objects beyond it held by its outermost cells, unless so many objects have moved that it */
+    /* may no longer suit them. False is returned in that case so the index is rebuilt instead. */
+    TmxObjectIndex* index = objectGroup->index;
+    uint32_t movedLength = 0;
+    bool isCellChanged = false;
+    for (uint32_t i = 0; i < objectGroup->objectsLength; i++) {
+        Rectangle bounds;
+        bool isIndexed = GetObjectIndexBounds(map, &objectGroup->objects[i], &bounds);
+        Rectangle* previousBounds = &index->bounds[i];
+        if (bounds.x == previousBounds->x && bounds.y == previousBounds->y && bounds.width == previousBounds->width &&
+                bounds.height == previousBounds->height) /* If the object hasn't moved */
+            continue;
+
+        movedLength += 1;
+        bool wasIndexed = previousBounds->width >= 0.0f;
+        if (isIndexed != wasIndexed)
+            isCellChanged = true;
+        else if (isIndexed && !isCellChanged) {
+            uint32_t firstColumn, lastColumn, firstRow, lastRow;
+            uint32_t previousFirstColumn, previousLastColumn, previousFirstRow, previousLastRow;
+            GetObjectIndexCells(index, bounds, &firstColumn, &lastColumn, &firstRow, &lastRow);
+            GetObjectIndexCells(index, *previousBounds, &previousFirstColumn, &previousLastColumn, &previousFirstRow,
+                &previousLastRow);
+            isCellChanged = firstColumn != previousFirstColumn || lastColumn != previousLastColumn ||
+                firstRow != previousFirstRow || lastRow != previousLastRow;
+        }
+        *previousBounds = bounds;
+    }
+
+    if (movedLength > objectGroup->objectsLength / 4)
+        return false;
+    if (isCellChanged)
+        FillObjectIndexCells(index, objectGroup->objectsLength);
+    return true;
+}
+
+bool GetObjectIndexBounds(const TmxMap* map, const TmxObject* object, Rectangle* bounds) {
+    /* Determine the area the object may be drawn to. Objects that are never drawn are given a negative width and */
+    /* left out of the index. */
+    memset(bounds, 0, sizeof(Rectangle));
+    bounds->width = -1.0f;
+    if (object->type == OBJECT_TYPE_TILE) {
+        /* Tile objects have no AABB but, with the tiles known, the area they're drawn to can be calculated the same */
+        /* way DrawTMXObjectTile() does */
+        int32_t gid = GetGid(object->gid, NULL, NULL, NULL, NULL);
+        if (gid <= 0 || gid >= (int32_t)map->gidsToTilesLength || map->gidsToTiles[gid].gid <= 0 ||
+                object->width <= 0.0 || object->height <= 0.0)
+            return false;
+        const TmxTile* tile = &map->gidsToTiles[gid];
+        float x = (float)(int)object->x, y = (float)(int)object->y;
+        if (tile->hasAnimation) { /* If the object is an animation, drawn with the frame's own dimensions */
+            *bounds = map->tileBounds;
+            bounds->x += x;
+            bounds->y += y;
+        } else {
+            bounds->x = x + tile->offset.x;
+            bounds->y = y + tile->offset.y - (float)object->height;
+            bounds->width = (float)object->width;
+            bounds->height = (float)object->height;
+        }
+    } else if (object->aabb.width >= 0.0f && object->aabb.height >= 0.0f) /* Excludes polygons without points */
+        *bounds = object->aabb;
+    else
+        return false;
+    return true;
+}
+
+void FillObjectIndexCells(TmxObjectIndex* index, uint32_t objectsLength) {
+    /* Count the objects overlapping each cell, sum the counts to find where each cell's objects begin, and then fill */
+    /* in the cells. Objects are added in order so each cell's objects end up in ascending order. Each cell's start is */
+    /* used as its position while filling, leaving it at the next cell's start, so the starts are shifted back after. */
+    uint32_t cellsLength = index->columns * index->rows;
+    uint32_t previousEntriesLength = index->cellStarts[cellsLength];
+    memset(index->cellStarts, 0, sizeof(uint32_t) * (cellsLength + 1));
+    for (uint32_t i = 0; i < objectsLength; i++) {
+        if (index->bounds[i].width < 0.0f) /* If the object isn't indexed */
+            continue;
+        uint32_t firstColumn, lastColumn, firstRow, lastRow;
+        GetObjectIndexCells(index, index->bounds[i], &firstColumn, &lastColumn, &firstRow, &lastRow);
+        for (uint32_t row = firstRow; row <= lastRow; row++) {
+            for (uint32_t column = firstColumn; column <= lastColumn; column++)
+                index->cellStarts[(row * index->columns) + column + 1] += 1;
+        }
+    }
+    for (uint32_t cell = 0; cell < cellsLength; cell++)
+        index->cellStarts[cell + 1] += index->cellStarts[cell];
+    if (index->cellStarts[cellsLength] > previousEntriesLength) { /* If the entries no longer fit */
+        if (index->cellObjects != NULL)
+            MemFree(index->cellObjects);
+        index->cellObjects = (uint32_t*)MemAllocZero(sizeof(uint32_t) * index->cellStarts[cellsLength]);
+    }
+    if (index->cellStarts[cellsLength] > 0) {
+        for (uint32_t i = 0; i < objectsLength; i++) {
+            if (index->bounds[i].width < 0.0f) /* If the object isn't indexed */
+                continue;
+            uint32_t firstColumn, lastColumn, firstRow, lastRow;
+            GetObjectIndexCells(index, index->bounds[i], &firstColumn, &lastColumn, &firstRow, &lastRow);
+            for (uint32_t row = firstRow; row <= lastRow; row++) {
+                for (uint32_t column = firstColumn; column <= lastColumn; column++)
+                    index->cellObjects[index->cellStarts[(row * index->columns) + column]++] = i;
+            }
+        }
+        memmove(&index->cellStarts[1], &index->cellStarts[0], sizeof(uint32_t) * cellsLength);
+        index->cellStarts[0] = 0;
+    }
+}
+
+void GetObjectIndexCells(const TmxObjectIndex* index, Rectangle area, uint32_t* firstColumn, uint32_t* lastColumn,
+        uint32_t* firstRow, uint32_t* lastRow) {
+    /* Areas reaching beyond the grid are clamped to its outermost cells */
+    float maxColumn = (float)(index->columns - 1), maxRow = (float)(index->rows - 1);
+    *firstColumn = (uint32_t)fminf(fmaxf(floorf((area.x - index->left) / index->cellWidth), 0.0f), maxColumn);
+    *lastColumn = (uint32_t)fminf(fmaxf(floorf((area.x + area.width - index->left) / index->cellWidth), 0.0f),
+        maxColumn);
+    *firstRow = (uint32_t)fminf(fmaxf(floorf((area.y - index->top) / index->cellHeight), 0.0f), maxRow);
+    *lastRow = (uint32_t)fminf(fmaxf(floorf((area.y + area.height - index->top) / index->cellHeight), 0.0f), maxRow);
+}
+
+uint32_t QueryObjectIndex(const TmxObjectIndex* index, Rectangle area, bool isPoint, bool isExact,
+        uint32_t* candidates) {
+    uint32_t candidatesLength = 0;
+    uint32_t firstColumn, lastColumn, firstRow, lastRow;
+    GetObjectIndexCells(index, area, &firstColumn, &lastColumn, &firstRow, &lastRow);
+    for (uint32_t row = firstRow; row <= lastRow; row++) {
+        for (uint32_t column = firstColumn; column <= lastColumn; column++) {
+            uint32_t cell = (row * index->columns) + column;
+            for (uint32_t i = index->cellStarts[cell]; i < index->cellStarts[cell + 1]; i++) {
+                uint32_t objectIndex = index->cellObjects[i];
+                Rectangle bounds = index->bounds[objectIndex];
+                /* An object overlapping several of the cells is found in each of them. Only take it from one: the */
+                /* top-left cell of those the area and the object have in common. */
+                uint32_t objectFirstColumn, objectLastColumn, objectFirstRow, objectLastRow;
+                GetObjectIndexCells(index, bounds, &objectFirstColumn, &objectLastColumn, &objectFirstRow,
+                    &objectLastRow);
+                if (column != (firstColumn > objectFirstColumn ? firstColumn : objectFirstColumn) ||
+                        row != (firstRow > objectFirstRow ? firstRow : objectFirstRow))
+                    continue;
+
+                if (isExact) { /* If the caller wants only the objects actually within the area */
+                    if (isPoint && (area.x < bounds.x || area.x > bounds.x + bounds.width || area.y < bounds.y ||
+                            area.y > bounds.y + bounds.height))
+                        continue;
+                    if (!isPoint && !CheckCollisionRecs(area, bounds))
+                        continue;
+                }
+                candidates[candidatesLength++] = objectIndex;
             }
         }
     }
+    return candidatesLength;
+}
+
+uint32_t QueryObjects(const TmxObjectGroup* objectGroup, Rectangle area, bool isPoint, uint32_t* objectIndexes,
+        uint32_t objectIndexesLength) {
+    /* The candidates are collected in memory of the query's own, rather than the index's scratch space, so that the */
+    /* layer isn't modified and queries can be made while it's drawn or from several threads at once */
+    uint32_t stackCandidates[TMX_QUERY_STACK_LENGTH];
+    uint32_t* candidates = stackCandidates;
+    if (objectGroup->objectsLength > TMX_QUERY_STACK_LENGTH)
+        candidates = (uint32_t*)MemAlloc(sizeof(uint32_t) * objectGroup->objectsLength);
+
+    uint32_t candidatesLength = QueryObjectIndex(objectGroup->index, area, isPoint, true, candidates);
+    qsort(candidates, candidatesLength, sizeof(uint32_t), CompareIndexes);
+    for (uint32_t i = 0; objectIndexes != NULL && i < candidatesLength && i < objectIndexesLength; i++)
+        objectIndexes[i] = candidates[i];
+
+    if (candidates != stackCandidates)
+        MemFree(candidates);
+    return candidatesLength;
+}
+
+void FreeObjectIndex(TmxObjectIndex* index) {
+    if (index->bounds != NULL)
+        MemFree(index->bounds);
+    if (index->cellStarts != NULL)
+        MemFree(index->cellStarts);
+    if (index->cellObjects != NULL)
+        MemFree(index->cellObjects);
+    if (index->topDownRanks != NULL)
+        MemFree(index->topDownRanks);
+    if (index->candidates != NULL)
+        MemFree(index->candidates);
+    MemFree(index);
+}
+
+int CompareObjectSortKeys(const void* a, const void* b) {
+    const RaytmxObjectSortKey *keyA = (const RaytmxObjectSortKey*)a, *keyB = (const RaytmxObjectSortKey*)b;
+    if (keyA->y != keyB->y)
+        return keyA->y < keyB->y ? -1 : 1; /* Lower y-coordinate first */
+    /* Objects sharing a y-coordinate are ordered last to first. This is the order the sort has always produced, */
+    /* inserting each object ahead of its equals, and it keeps the order total so any sort yields the same result. */
+    if (keyA->index != keyB->index)
+        return keyA->index > keyB->index ? -1 : 1; /* Later object first */
+    return 0;
+}
+
+int CompareIndexes(const void* a, const void* b) {
+    uint32_t indexA = *(const uint32_t*)a, indexB = *(const uint32_t*)b;
+    if (indexA != indexB)
+        return indexA < indexB ? -1 : 1; /* Ascending */
+    return 0;
 }
 
 void TraceLogTMXTilesets(int logLevel, TmxOrientation orientation, TmxTileset* tilesets, uint32_t tilesetsLength,
@@ -3473,7 +5476,7 @@ void TraceLogTMXLayers(int logLevel, TmxLayer* layers, uint32_t layersLength, in
 }
 
 TmxProperty* AddProperty(RaytmxState* raytmxState) {
-    RaytmxPropertyNode* node = (RaytmxPropertyNode*)MemAllocZero(sizeof(RaytmxPropertyNode));
+    RaytmxPropertyNode* node = (RaytmxPropertyNode*)AllocFromArena(&raytmxState->arena, sizeof(RaytmxPropertyNode));
 
     if (raytmxState->propertiesRoot == NULL)
         raytmxState->propertiesRoot = node;
@@ -3485,20 +5488,93 @@ TmxProperty* AddProperty(RaytmxState* raytmxState) {
     return &node->property;
 }
 
-void AddTileLayerTile(RaytmxState* raytmxState, uint32_t gid) {
-    RaytmxTileLayerTileNode* node = (RaytmxTileLayerTileNode*)MemAllocZero(sizeof(RaytmxTileLayerTileNode));
-    node->gid = gid;
+void ReserveTileLayerTiles(RaytmxLayerTiles* layerTiles, uint32_t capacity) {
+    if (capacity <= layerTiles->capacity)
+        return;
+
+    layerTiles->gids = (uint32_t*)MemRealloc(layerTiles->gids, sizeof(uint32_t) * capacity);
+    layerTiles->capacity = capacity;
+}
+
+void AddTileLayerTile(RaytmxLayerTiles* layerTiles, uint32_t gid) {
+    if (layerTiles->length == layerTiles->capacity) {
+        /* Grow geometrically in case the layer's dimensions were wrong, or unknown, when room was reserved */
+        ReserveTileLayerTiles(layerTiles, layerTiles->capacity > 0 ? layerTiles->capacity * 2 : 256);
+    }
+
+    layerTiles->gids[layerTiles->length] = gid;
+    layerTiles->length += 1;
+}
+
+void AddTileLayerTiles(RaytmxLayerTiles* layerTiles, const uint32_t* gids, uint32_t gidsLength) {
+    if (gidsLength == 0)
+        return;
+
+    if (layerTiles->capacity - layerTiles->length < gidsLength)
+        ReserveTileLayerTiles(layerTiles, layerTiles->length + gidsLength);
+
+    memcpy(layerTiles->gids + layerTiles->length, gids, sizeof(uint32_t) * gidsLength);
+    layerTiles->length += gidsLength;
+}
+
+void SetTileLayerTiles(TmxLayer* layer, RaytmxLayerTiles* layerTiles) {
+    TmxTileLayer* tileLayer = &layer->exact.tileLayer;
+    if (layerTiles->length > 0 && tileLayer->tiles != NULL) { /* If the layer already has tiles from elsewhere */
+        TraceLog(LOG_WARNING, "RAYTMX: layer \"%s\" has more than one source of tile data - the latter tiles for "
+            "this layer will be dropped", layer->name);
+        MemFree(layerTiles->gids);
+    } else if (layerTiles->length == 0) {
+        if (layerTiles->gids != NULL)
+            MemFree(layerTiles->gids);
+    } else {
+        /* Trim the array if there were fewer GIDs than expected and then hand it to the tile layer */
+        if (layerTiles->length < layerTiles->capacity)
+            layerTiles->gids = (uint32_t*)MemRealloc(layerTiles->gids, sizeof(uint32_t) * layerTiles->length);
+        tileLayer->tiles = layerTiles->gids;
+        tileLayer->tilesLength = layerTiles->length;
+    }
+
+    layerTiles->gids = NULL;
+    layerTiles->length = 0;
+    layerTiles->capacity = 0;
+}
+
+void AddLayerData(RaytmxState* raytmxState, const hoxml_context_t* hoxmlContext) {
+    RaytmxLayerDataNode* node = (RaytmxLayerDataNode*)AllocFromArena(&raytmxState->arena,
+        sizeof(RaytmxLayerDataNode));
+    node->layer = raytmxState->layer;
+    node->line = hoxmlContext->line;
+
+    if (raytmxState->layerDataContent != NULL) {
+        /* The content was found in the document itself, which remains loaded until the data is decoded */
+        node->content = raytmxState->layerDataContent;
+        node->contentLength = raytmxState->layerDataContentLength;
+    } else {
+        /* hoxml's copy of the content is only valid until the parser moves on so it's copied again */
+        const char* content = hoxmlContext->content != NULL ? hoxmlContext->content : "";
+        node->contentLength = strlen(content);
+        char* contentCopy = (char*)MemAlloc((unsigned int)node->contentLength + 1);
+        memcpy(contentCopy, content, node->contentLength + 1);
+        node->content = contentCopy;
+        node->isContentCopied = true;
+    }
+
+    /* The GIDs array, sized for the layer when the <data> began, goes with the data to be filled when it's decoded */
+    node->tiles = raytmxState->layerTiles;
+    raytmxState->layerTiles.gids = NULL;
+    raytmxState->layerTiles.length = 0;
+    raytmxState->layerTiles.capacity = 0;
 
-    if (raytmxState->layerTilesRoot == NULL)
-        raytmxState->layerTilesRoot = node;
+    if (raytmxState->layerDataRoot == NULL)
+        raytmxState->layerDataRoot = node;
     else
-        raytmxState->layerTilesTail->next = node;
-    raytmxState->layerTilesTail = node;
-    raytmxState->layerTilesLength += 1;
+        raytmxState->layerDataTail->next = node;
+    raytmxState->layerDataTail = node;
+    raytmxState->layerDataLength += 1;
 }
 
 TmxTileset* AddTileset(RaytmxState* raytmxState) {
-    RaytmxTilesetNode* node = (RaytmxTilesetNode*)MemAllocZero(sizeof(RaytmxTilesetNode));
+    RaytmxTilesetNode* node = (RaytmxTilesetNode*)AllocFromArena(&raytmxState->arena, sizeof(RaytmxTilesetNode));
 
     if (raytmxState->tilesetsRoot == NULL)
         raytmxState->tilesetsRoot = node;
@@ -3511,7 +5587,8 @@ TmxTileset* AddTileset(RaytmxState* raytmxState) {
 }
 
 TmxTilesetTile* AddTilesetTile(RaytmxState* raytmxState) {
-    RaytmxTilesetTileNode* node = (RaytmxTilesetTileNode*)MemAllocZero(sizeof(RaytmxTilesetTileNode));
+    RaytmxTilesetTileNode* node = (RaytmxTilesetTileNode*)AllocFromArena(&raytmxState->arena,
+        sizeof(RaytmxTilesetTileNode));
 
     if (raytmxState->tilesetTilesRoot == NULL)
         raytmxState->tilesetTilesRoot = node;
@@ -3524,7 +5601,8 @@ TmxTilesetTile* AddTilesetTile(RaytmxState* raytmxState) {
 }
 
 TmxAnimationFrame* AddAnimationFrame(RaytmxState* raytmxState) {
-    RaytmxAnimationFrameNode* node = (RaytmxAnimationFrameNode*)MemAllocZero(sizeof(RaytmxAnimationFrameNode));
+    RaytmxAnimationFrameNode* node = (RaytmxAnimationFrameNode*)AllocFromArena(&raytmxState->arena,
+        sizeof(RaytmxAnimationFrameNode));
 
     if (raytmxState->animationFramesRoot == NULL)
         raytmxState->animationFramesRoot = node;
@@ -3537,7 +5615,7 @@ TmxAnimationFrame* AddAnimationFrame(RaytmxState* raytmxState) {
 }
 
 TmxLayer* AddGenericLayer(RaytmxState* raytmxState, bool isGroup) {
-    RaytmxLayerNode* node = (RaytmxLayerNode*)MemAllocZero(sizeof(RaytmxLayerNode));
+    RaytmxLayerNode* node = (RaytmxLayerNode*)AllocFromArena(&raytmxState->arena, sizeof(RaytmxLayerNode));
     /* There are some non-zero default values for several layer attributes: */
     node->layer.opacity = 1.0;
     node->layer.visible = true;
@@ -3568,7 +5646,7 @@ TmxLayer* AddGenericLayer(RaytmxState* raytmxState, bool isGroup) {
 }
 
 TmxObject* AddObject(RaytmxState* raytmxState) {
-    RaytmxObjectNode* node = (RaytmxObjectNode*)MemAllocZero(sizeof(RaytmxObjectNode));
+    RaytmxObjectNode* node = (RaytmxObjectNode*)AllocFromArena(&raytmxState->arena, sizeof(RaytmxObjectNode));
     /* <object> elements have a couple non-zero default values: */
     node->object.gid = -1;
     node->object.visible = true;
@@ -3583,6 +5661,41 @@ TmxObject* AddObject(RaytmxState* raytmxState) {
     return &node->object;
 }
 
+void* AllocFromArena(RaytmxArena* arena, size_t size) {
+    /* Round the size up so the next allocation is aligned as well */
+    size = (size + TMX_ARENA_ALIGNMENT - 1) & ~((size_t)TMX_ARENA_ALIGNMENT - 1);
+    /* The block's memory begins after its header, also rounded up to stay aligned */
+    const size_t headerSize = (sizeof(RaytmxArenaBlock) + TMX_ARENA_ALIGNMENT - 1) &
+        ~((size_t)TMX_ARENA_ALIGNMENT - 1);
+
+    RaytmxArenaBlock* block = arena->blocks;
+    if (block == NULL || block->capacity - block->used < size) { /* If there's no room left in the current block */
+        /* Each block is twice the size of the last so the number of blocks grows only logarithmically */
+        size_t capacity = block != NULL ? block->capacity * 2 : TMX_ARENA_BLOCK_SIZE;
+        if (capacity < size)
+            capacity = size;
+        /* Blocks are zeroized here, once, so every allocation made from them starts out zeroized */
+        block = (RaytmxArenaBlock*)MemAllocZero((unsigned int)(headerSize + capacity));
+        block->capacity = capacity;
+        block->next = arena->blocks;
+        arena->blocks = block;
+    }
+
+    void* memory = (unsigned char*)block + headerSize + block->used;
+    block->used += size;
+    return memory;
+}
+
+void FreeArena(RaytmxArena* arena) {
+    RaytmxArenaBlock *blocksIterator = arena->blocks, *blocksTemp;
+    while (blocksIterator != NULL) {
+        blocksTemp = blocksIterator;
+        blocksIterator = blocksIterator->next;
+        MemFree(blocksTemp);
+    }
+    arena->blocks = NULL;
+}
+
 void AppendLayerTo(TmxMap* map, RaytmxLayerNode* groupNode, RaytmxLayerNode* layersRoot, uint32_t layersLength) {
     if (map == NULL || layersRoot == NULL || layersLength == 0)
         return;
@@ -3599,6 +5712,14 @@ void AppendLayerTo(TmxMap* map, RaytmxLayerNode* groupNode, RaytmxLayerNode* lay
         if (layersIterator->childrenRoot != NULL)
             AppendLayerTo(map, layersIterator, layersIterator->childrenRoot, layersIterator->childrenLength);
         layers[i] = layersIterator->layer;
+        if (layers[i].type == LAYER_TYPE_TILE_LAYER && map->width > 0 && map->height > 0) {
+            /* Divide the tile layer into chunks. Their geometry is built when they're first drawn. */
+            TmxTileLayer* tileLayer = &layers[i].exact.tileLayer;
+            tileLayer->chunksWidth = (map->width + RAYTMX_CHUNK_SIZE - 1) / RAYTMX_CHUNK_SIZE;
+            tileLayer->chunksHeight = (map->height + RAYTMX_CHUNK_SIZE - 1) / RAYTMX_CHUNK_SIZE;
+            tileLayer->chunks = (TmxTileChunk*)MemAllocZero(sizeof(TmxTileChunk) * tileLayer->chunksWidth *
+                tileLayer->chunksHeight);
+        }
         layersIterator = layersIterator->next;
     }
 
@@ -3611,26 +5732,227 @@ void AppendLayerTo(TmxMap* map, RaytmxLayerNode* groupNode, RaytmxLayerNode* lay
     }
 }
 
+void PackTilesetAtlases(TmxMap* map, const TmxImage** gidsToImages, TmxLoadTask* task) {
+    /* Gather the distinct images, identified by path, and an entry for every tile extracted from one of them */
+    const TmxImage** images = (const TmxImage**)MemAllocZero(sizeof(TmxImage*) * map->gidsToTilesLength);
+    uint32_t imagesLength = 0;
+    RaytmxAtlasEntry* entries = (RaytmxAtlasEntry*)MemAllocZero(sizeof(RaytmxAtlasEntry) * map->gidsToTilesLength);
+    uint32_t entriesLength = 0;
+    for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++) {
+        const TmxImage* image = gidsToImages[gid];
+        const TmxTile* tile = &map->gidsToTiles[gid];
+        if (image == NULL || image->path == NULL || tile->sourceRect.width <= 0.0f || tile->sourceRect.height <= 0.0f)
+            continue;
+
+        uint32_t imageIndex = 0;
+        while (imageIndex < imagesLength && strcmp(images[imageIndex]->path, image->path) != 0)
+            imageIndex++;
+        if (imageIndex == imagesLength) /* If this is the first tile of this image */
+            images[imagesLength++] = image;
+
+        RaytmxAtlasEntry* entry = &entries[entriesLength++];
+        entry->gid = gid;
+        entry->image = imageIndex;
+        entry->sourceX = (int32_t)tile->sourceRect.x;
+        entry->sourceY = (int32_t)tile->sourceRect.y;
+        entry->width = (int32_t)tile->sourceRect.width;
+        entry->height = (int32_t)tile->sourceRect.height;
+    }
+
+    /* Load the images into RAM, as opposed to VRAM, and convert them to a common format so pixels can be copied. */
+    /* They're decoded at the same time by as many threads as are wanted. */
+    const char** imagePaths = (const char**)MemAllocZero(sizeof(char*) * (imagesLength > 0 ? imagesLength : 1));
+    for (uint32_t i = 0; i < imagesLength; i++)
+        imagePaths[i] = images[i]->path;
+    Image* loadedImages = (Image*)MemAllocZero(sizeof(Image) * (imagesLength > 0 ? imagesLength : 1));
+    RaytmxImageQueue imageQueue;
+    memset(&imageQueue, 0, sizeof(RaytmxImageQueue));
+    imageQueue.paths = imagePaths;
+    imageQueue.images = loadedImages;
+    imageQueue.imagesLength = imagesLength;
+    imageQueue.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    imageQueue.task = task;
+    DecodeImages(&imageQueue);
+    for (uint32_t i = 0; i < imagesLength; i++) {
+        if (loadedImages[i].data == NULL && !IsLoadCanceled(task))
+            TraceLog(LOG_ERROR, "RAYTMX: Unable to load image \"%s\"", images[i]->path);
+    }
+    MemFree((void*)imagePaths);
+    /* Tiles of images that failed to load are dropped and, like any texture that fails to load, won't be drawn */
+    uint32_t loadedEntriesLength = 0;
+    for (uint32_t i = 0; i < entriesLength; i++) {
+        if (loadedImages[entries[i].image].data != NULL)
+            entries[loadedEntriesLength++] = entries[i];
+    }
+    entriesLength = loadedEntriesLength;
+
+    int32_t pagesWidth = 0;
+    int32_t* pagesHeights = (int32_t*)MemAllocZero(sizeof(int32_t) * (entriesLength + 1));
+    uint32_t pagesLength = PackAtlasEntries(entries, entriesLength, RAYTMX_ATLAS_MAX_SIZE, &pagesWidth, pagesHeights);
+
+    /* Every page becomes an atlas. Any image with a tile too large for an atlas keeps a texture of its own, which is */
+    /* also owned by the map, so there may be as many as one more texture per image. */
+    Texture2D* atlases = (Texture2D*)MemAllocZero(sizeof(Texture2D) * (pagesLength + imagesLength + 1));
+    uint32_t atlasesLength = 0;
+    for (uint32_t page = 0; page < pagesLength; page++) {
+        Image atlasImage = GenImageColor(pagesWidth, pagesHeights[page], BLANK);
+        for (uint32_t i = 0; i < entriesLength; i++) {
+            if (entries[i].page == page)
+                BlitAtlasEntry(&atlasImage, &loadedImages[entries[i].image], &entries[i]);
+        }
+        atlases[atlasesLength++] = AddDecodedTexture(task, &atlasImage);
+        UnloadImage(atlasImage);
+    }
+
+    /* Point the tiles to their areas within the atlases */
+    uint32_t* imagesToTextures = (uint32_t*)MemAllocZero(sizeof(uint32_t) * (imagesLength > 0 ? imagesLength : 1));
+    for (uint32_t i = 0; i < imagesLength; i++)
+        imagesToTextures[i] = UINT32_MAX;
+    for (uint32_t i = 0; i < entriesLength; i++) {
+        RaytmxAtlasEntry* entry = &entries[i];
+        TmxTile* tile = &map->gidsToTiles[entry->gid];
+        if (entry->page != UINT32_MAX) {
+            /* The tile is inside a one-pixel border of extruded edges */
+            tile->texture = atlases[entry->page];
+            tile->sourceRect.x = (float)(entry->x + 1);
+            tile->sourceRect.y = (float)(entry->y + 1);
+        } else { /* If the tile didn't fit in an atlas */
+            if (imagesToTextures[entry->image] == UINT32_MAX) {
+                TraceLog(LOG_WARNING, "RAYTMX: Image \"%s\" has a tile too large to be packed into an atlas",
+                    images[entry->image]->path);
+                imagesToTextures[entry->image] = atlasesLength;
+                atlases[atlasesLength++] = AddDecodedTexture(task, &loadedImages[entry->image]);
+            }
+            tile->texture = atlases[imagesToTextures[entry->image]];
+        }
+    }
+
+    for (uint32_t i = 0; i < imagesLength; i++) {
+        if (loadedImages[i].data != NULL)
+            UnloadImage(loadedImages[i]);
+    }
+    MemFree(imagesToTextures);
+    MemFree(pagesHeights);
+    MemFree(loadedImages);
+    MemFree(entries);
+    MemFree((void*)images);
+
+    if (atlasesLength > 0) {
+        map->atlases = atlases;
+        map->atlasesLength = atlasesLength;
+    } else
+        MemFree(atlases);
+}
+
+uint32_t PackAtlasEntries(RaytmxAtlasEntry* entries, uint32_t entriesLength, int32_t maxSize, int32_t* pagesWidth,
+        int32_t* pagesHeights) {
+    /* Entries are packed into "shelves," rows as tall as their tallest entry, from the tallest entry to the shortest */
+    /* so that entries of similar heights share shelves and little space is wasted. Ties are broken by GID so the */
+    /* result depends only on the entries and never on the sorting algorithm. */
+    qsort(entries, entriesLength, sizeof(RaytmxAtlasEntry), CompareAtlasEntries);
+
+    /* Choose the narrowest power-of-two width that fits the widest entry and would make a roughly square atlas */
+    int64_t area = 0;
+    int32_t widest = 0;
+    for (uint32_t i = 0; i < entriesLength; i++) {
+        int32_t width = entries[i].width + 2, height = entries[i].height + 2; /* Including the extruded border */
+        if (width > maxSize || height > maxSize)
+            continue;
+        area += (int64_t)width * height;
+        if (width > widest)
+            widest = width;
+    }
+    int32_t pageWidth = 1;
+    while (pageWidth < maxSize && (pageWidth < widest || (int64_t)pageWidth * pageWidth < area))
+        pageWidth *= 2;
+    if (pageWidth > maxSize)
+        pageWidth = maxSize;
+    *pagesWidth = pageWidth;
+
+    uint32_t pagesLength = 0;
+    int32_t shelfX = 0, shelfY = 0, shelfHeight = 0;
+    for (uint32_t i = 0; i < entriesLength; i++) {
+        RaytmxAtlasEntry* entry = &entries[i];
+        int32_t width = entry->width + 2, height = entry->height + 2;
+        if (width > pageWidth || height > maxSize) { /* If the entry can't fit in any atlas */
+            entry->page = UINT32_MAX;
+            continue;
+        }
+
+        if (shelfX + width > pageWidth) { /* If the entry doesn't fit on the current shelf, start another */
+            shelfY += shelfHeight;
+            shelfX = 0;
+            shelfHeight = 0;
+        }
+        if (pagesLength == 0 || shelfY + height > maxSize) { /* If the shelf doesn't fit on the page, start another */
+            pagesHeights[pagesLength++] = 0;
+            shelfX = 0;
+            shelfY = 0;
+            shelfHeight = 0;
+        }
+
+        entry->page = pagesLength - 1;
+        entry->x = shelfX;
+        entry->y = shelfY;
+        shelfX += width;
+        if (height > shelfHeight)
+            shelfHeight = height;
+        if (shelfY + shelfHeight > pagesHeights[entry->page])
+            pagesHeights[entry->page] = shelfY + shelfHeight;
+    }
+
+    return pagesLength;
+}
+
+int CompareAtlasEntries(const void* a, const void* b) {
+    const RaytmxAtlasEntry *entryA = (const RaytmxAtlasEntry*)a, *entryB = (const RaytmxAtlasEntry*)b;
+    if (entryA->height != entryB->height)
+        return entryA->height > entryB->height ? -1 : 1; /* Taller first */
+    if (entryA->width != entryB->width)
+        return entryA->width > entryB->width ? -1 : 1; /* Wider first */
+    if (entryA->gid != entryB->gid)
+        return entryA->gid < entryB->gid ? -1 : 1; /* Lower GID first */
+    return 0;
+}
+
+void BlitAtlasEntry(Image* page, const Image* image, const RaytmxAtlasEntry* entry) {
+    /* Copy the tile's pixels into the atlas, inside a one-pixel border, and fill the border by repeating the tile's */
+    /* outermost pixels. Filtering or imprecise texture coordinates may sample just outside of the tile and would */
+    /* otherwise pick up pixels of a neighboring tile. */
+    unsigned char* pagePixels = (unsigned char*)page->data;
+    const unsigned char* imagePixels = (const unsigned char*)image->data;
+    for (int32_t y = -1; y <= entry->height; y++) {
+        int32_t clampedY = y < 0 ? 0 : (y >= entry->height ? entry->height - 1 : y);
+        int32_t sourceY = entry->sourceY + clampedY;
+        for (int32_t x = -1; x <= entry->width; x++) {
+            int32_t clampedX = x < 0 ? 0 : (x >= entry->width ? entry->width - 1 : x);
+            int32_t sourceX = entry->sourceX + clampedX;
+            unsigned char* destination = pagePixels +
+                ((((size_t)(entry->y + 1 + y) * (size_t)page->width) + (size_t)(entry->x + 1 + x)) * 4);
+            if (sourceX < 0 || sourceY < 0 || sourceX >= image->width || sourceY >= image->height)
+                memset(destination, 0, 4); /* Areas outside of the image are transparent */
+            else
+                memcpy(destination, imagePixels + ((((size_t)sourceY * (size_t)image->width) + sourceX) * 4), 4);
+        }
+    }
+}
+
 RaytmxCachedTextureNode* LoadCachedTexture(RaytmxState* raytmxState, const char* fileName) {
     if (raytmxState == NULL || fileName == NULL)
         return NULL;
 
     /* First try to find an already-loaded texture identified by the file name */
-    RaytmxCachedTextureNode* cachedTextureNode = raytmxState->texturesRoot;
-    while (cachedTextureNode != NULL) {
-        /* If the file name associated with the node matches the given file name */
-        if (strcmp(cachedTextureNode->fileName, fileName) == 0)
-            return cachedTextureNode;
-        cachedTextureNode = cachedTextureNode->next;
-    }
-
-    /* Try to load the texture */
-    char* fullPath = JoinPath(raytmxState->documentDirectory, fileName);
-    Texture2D texture = LoadTexture(fullPath);
-    if (texture.id == 0) { /* If loading the texture failed */
-        TraceLog(LOG_ERROR, "RAYTMX: Unable to load texture \"%s\"", fullPath);
-        return NULL;
-    }
+    uint64_t hash = GetStringHash(fileName);
+    RaytmxCachedTextureNode* cachedTextureNode =
+        (RaytmxCachedTextureNode*)FindInHashTable(&raytmxState->texturesTable, fileName, hash);
+    if (cachedTextureNode != NULL)
+        return cachedTextureNode;
+
+    /* Reference the image so that it's decoded, along with every other image, once parsing is done. Until then, */
+    /* and until it's uploaded, its texture is a placeholder. */
+    char path[TMX_PATH_LENGTH];
+    Texture2D texture = AddPendingTexture(raytmxState->task,
+        JoinPath(raytmxState->documentDirectory, fileName, path, sizeof(path)));
 
     /* Create a new node in the list of known textures */
     cachedTextureNode = (RaytmxCachedTextureNode*)MemAllocZero(sizeof(RaytmxCachedTextureNode));
@@ -3638,35 +5960,164 @@ RaytmxCachedTextureNode* LoadCachedTexture(RaytmxState* raytmxState, const char*
     StringCopy(cachedTextureNode->fileName, fileName);
     cachedTextureNode->texture = texture;
 
-    /* Add to the cache */
-    if (raytmxState->texturesRoot == NULL)
-        raytmxState->texturesRoot = cachedTextureNode;
-    else {
-        RaytmxCachedTextureNode* cachedTextureIterator = raytmxState->texturesRoot;
-        while (cachedTextureIterator->next != NULL)
-            cachedTextureIterator = cachedTextureIterator->next;
-        cachedTextureIterator->next = cachedTextureNode;
-    }
+    /* Add to the cache. The list only owns the nodes, so order doesn't matter, while the table finds them. */
+    cachedTextureNode->next = raytmxState->texturesRoot;
+    raytmxState->texturesRoot = cachedTextureNode;
+    AddToHashTable(&raytmxState->texturesTable, cachedTextureNode->fileName, hash, cachedTextureNode);
 
     return cachedTextureNode;
 }
 
+RaytmxExternalFile LoadExternalFile(const char* fileName) {
+    RaytmxExternalFile file;
+    memset(&file, 0, sizeof(RaytmxExternalFile));
+    if (tmxLoadFile != NULL) {
+        file.data = tmxLoadFile(fileName, &file.length, tmxFileUserData);
+        return file;
+    }
+
+#ifdef TMX_MMAP
+    /* Map the file so that it's paged in as it's parsed rather than copied into memory up front. Empty files and */
+    /* files that can't be mapped (e.g. pipes) are left to raylib. */
+    int fileDescriptor = open(fileName, O_RDONLY);
+    if (fileDescriptor >= 0) {
+        struct stat fileStatus;
+        if (fstat(fileDescriptor, &fileStatus) == 0 && S_ISREG(fileStatus.st_mode) && fileStatus.st_size > 0) {
+            void* data = mmap(NULL, (size_t)fileStatus.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+            if (data != MAP_FAILED) {
+                file.data = (const unsigned char*)data;
+                file.length = (size_t)fileStatus.st_size;
+                file.isMapped = true;
+            }
+        }
+        close(fileDescriptor); /* The mapping, if any, remains valid after the file is closed */
+        if (file.isMapped)
+            return file;
+    }
+#endif /* TMX_MMAP */
+
+    int dataSize = 0;
+    file.data = LoadFileData(fileName, &dataSize);
+    if (file.data != NULL)
+        file.length = (size_t)dataSize;
+    return file;
+}
+
+void UnloadExternalFile(RaytmxExternalFile file) {
+    if (file.data == NULL)
+        return;
+
+#ifdef TMX_MMAP
+    if (file.isMapped) {
+        munmap((void*)file.data, file.length);
+        return;
+    }
+#endif /* TMX_MMAP */
+    if (tmxLoadFile != NULL) {
+        if (tmxUnloadFile != NULL)
+            tmxUnloadFile(file.data, tmxFileUserData);
+    } else
+        UnloadFileData((unsigned char*)file.data);
+}
+
+Image LoadExternalImage(const char* fileName) {
+    if (tmxLoadFile == NULL)
+        return LoadImage(fileName);
+
+    /* raylib identifies the image's format by its file extension (e.g. ".png") */
+    Image image;
+    memset(&image, 0, sizeof(Image));
+    RaytmxExternalFile file = LoadExternalFile(fileName);
+    if (file.data != NULL) {
+        image = LoadImageFromMemory(GetFileExtension(fileName), file.data, (int)file.length);
+        UnloadExternalFile(file);
+    }
+    return image;
+}
+
+bool ReadImageFileDimensions(const char* fileName, uint32_t* width, uint32_t* height) {
+    /* Only the header is needed. Files on disk are mapped, where possible, so only the first page is read. */
+    RaytmxExternalFile file = LoadExternalFile(fileName);
+    if (file.data == NULL)
+        return false;
+    bool isRead = GetImageDimensions(file.data, file.length, width, height);
+    UnloadExternalFile(file);
+    return isRead;
+}
+
+bool GetImageDimensions(const unsigned char* data, size_t dataLength, uint32_t* width, uint32_t* height) {
+    /* PNG: an 8-byte signature followed by the IHDR chunk, which begins with big-endian, 32-bit dimensions */
+    if (dataLength >= 24 && memcmp(data, "\x89PNG\r\n\x1A\n", 8) == 0 && memcmp(data + 12, "IHDR", 4) == 0) {
+        *width = ((uint32_t)data[16] << 24) | ((uint32_t)data[17] << 16) | ((uint32_t)data[18] << 8) | data[19];
+        *height = ((uint32_t)data[20] << 24) | ((uint32_t)data[21] << 16) | ((uint32_t)data[22] << 8) | data[23];
+        return true;
+    }
+    /* QOI: a "qoif" signature followed by big-endian, 32-bit dimensions */
+    if (dataLength >= 12 && memcmp(data, "qoif", 4) == 0) {
+        *width = ((uint32_t)data[4] << 24) | ((uint32_t)data[5] << 16) | ((uint32_t)data[6] << 8) | data[7];
+        *height = ((uint32_t)data[8] << 24) | ((uint32_t)data[9] << 16) | ((uint32_t)data[10] << 8) | data[11];
+        return true;
+    }
+    /* GIF: a "GIF87a" or "GIF89a" signature followed by little-endian, 16-bit dimensions */
+    if (dataLength >= 10 && memcmp(data, "GIF8", 4) == 0) {
+        *width = (uint32_t)data[6] | ((uint32_t)data[7] << 8);
+        *height = (uint32_t)data[8] | ((uint32_t)data[9] << 8);
+        return true;
+    }
+    /* BMP: a "BM" signature and, past the file header, an info header with little-endian, signed 32-bit dimensions. */
+    /* The height is negative for images stored top-down. */
+    if (dataLength >= 26 && data[0] == 'B' && data[1] == 'M') {
+        int32_t bmpWidth = (int32_t)((uint32_t)data[18] | ((uint32_t)data[19] << 8) | ((uint32_t)data[20] << 16) |
+            ((uint32_t)data[21] << 24));
+        int32_t bmpHeight = (int32_t)((uint32_t)data[22] | ((uint32_t)data[23] << 8) | ((uint32_t)data[24] << 16) |
+            ((uint32_t)data[25] << 24));
+        *width = (uint32_t)(bmpWidth < 0 ? -bmpWidth : bmpWidth);
+        *height = (uint32_t)(bmpHeight < 0 ? -bmpHeight : bmpHeight);
+        return true;
+    }
+    /* JPEG: a series of segments, after the start-of-image marker, one of which is a start-of-frame segment that */
+    /* holds big-endian, 16-bit dimensions */
+    if (dataLength >= 4 && data[0] == 0xFF && data[1] == 0xD8) {
+        size_t i = 2;
+        while (i + 4 <= dataLength && data[i] == 0xFF) {
+            unsigned char marker = data[i + 1];
+            if (marker == 0xFF) { /* Markers may be preceded by any number of fill bytes */
+                i += 1;
+                continue;
+            }
+            if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7)) { /* Markers without segments */
+                i += 2;
+                continue;
+            }
+            /* Start-of-frame markers are 0xC0 through 0xCF except for 0xC4 (DHT), 0xC8 (JPG), and 0xCC (DAC) */
+            if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+                if (i + 9 > dataLength)
+                    return false;
+                *height = ((uint32_t)data[i + 5] << 8) | data[i + 6];
+                *width = ((uint32_t)data[i + 7] << 8) | data[i + 8];
+                return true;
+            }
+            i += 2 + (((size_t)data[i + 2] << 8) | data[i + 3]); /* Skip the marker and the segment */
+        }
+    }
+    return false; /* The format isn't recognized or the header is malformed */
+}
+
 RaytmxCachedTemplateNode* LoadCachedTemplate(RaytmxState* raytmxState, const char* fileName) {
     if (raytmxState == NULL || fileName == NULL)
         return NULL;
 
     /* First try to find an already-loaded template identified by the file name */
-    RaytmxCachedTemplateNode* cachedTemplateNode = raytmxState->templatesRoot;
-    while (cachedTemplateNode != NULL) {
-        /* If the file name associated with the node matches the given file name */
-        if (strcmp(cachedTemplateNode->fileName, fileName) == 0)
-            return cachedTemplateNode;
-        cachedTemplateNode = cachedTemplateNode->next;
-    }
+    uint64_t hash = GetStringHash(fileName);
+    RaytmxCachedTemplateNode* cachedTemplateNode =
+        (RaytmxCachedTemplateNode*)FindInHashTable(&raytmxState->templatesTable, fileName, hash);
+    if (cachedTemplateNode != NULL)
+        return cachedTemplateNode;
 
     /* Load the template from the external TX file */
-    char* fullPath = JoinPath(raytmxState->documentDirectory, fileName);
-    RaytmxObjectTemplate objectTemplate = LoadTX(fullPath);
+    char fullPath[TMX_PATH_LENGTH];
+    JoinPath(raytmxState->documentDirectory, fileName, fullPath, sizeof(fullPath));
+    RaytmxObjectTemplate objectTemplate = LoadTX(fullPath, raytmxState->task);
     if (!objectTemplate.isSuccess) { /* If loading the template failed */
         TraceLog(LOG_ERROR, "RAYTMX: Unable to load template \"%s\"", fullPath);
         return NULL;
@@ -3695,41 +6146,3335 @@ RaytmxCachedTemplateNode* LoadCachedTemplate(RaytmxState* raytmxState, const cha
                 isNew = false;
                 break;
             }
+            tilesetsIterator = tilesetsIterator->next;
         }
         if (isNew) {
             TmxTileset* tileset = AddTileset(raytmxState);
             *tileset = objectTemplate.tileset;
+        } else { /* The duplicate is freed as the existing tileset is used instead */
+            DetachTilesetTextures(&cachedTemplateNode->objectTemplate.tileset);
+            FreeTileset(cachedTemplateNode->objectTemplate.tileset);
+            cachedTemplateNode->objectTemplate.hasTileset = false;
         }
     }
 
-    /* Add to the cache */
-    if (raytmxState->templatesRoot == NULL)
-        raytmxState->templatesRoot = cachedTemplateNode;
-    else {
-        RaytmxCachedTemplateNode* cachedTemplateIterator = raytmxState->templatesRoot;
-        while (cachedTemplateIterator->next != NULL)
-            cachedTemplateIterator = cachedTemplateIterator->next;
-        cachedTemplateIterator->next = cachedTemplateNode;
-    }
+    /* Add to the cache. The list only owns the nodes, so order doesn't matter, while the table finds them. */
+    cachedTemplateNode->next = raytmxState->templatesRoot;
+    raytmxState->templatesRoot = cachedTemplateNode;
+    AddToHashTable(&raytmxState->templatesTable, cachedTemplateNode->fileName, hash, cachedTemplateNode);
 
     return cachedTemplateNode;
 }
 
-Color GetColorFromHexString(const char* hex) {
-    Color color = BLACK; /* #define'd by raylib as { 0, 0, 0, 255 } */
+void* FindInHashTable(const RaytmxHashTable* table, const char* key, uint64_t hash) {
+    if (table->capacity == 0) /* If nothing was ever added */
+        return NULL;
 
-    size_t length = strlen(hex);
-    if (length < 6) /* If the hex string is too short to contain at least R, G, and B components */
-        return color;
+    uint32_t mask = table->capacity - 1;
+    for (uint32_t i = (uint32_t)hash & mask; table->slots[i].key != NULL; i = (i + 1) & mask) {
+        if (table->slots[i].hash == hash && strcmp(table->slots[i].key, key) == 0)
+            return table->slots[i].value;
+    }
+    return NULL;
+}
 
-    /* Hex strings are in the form #AARRGGBB or #RRGGBB meaning alpha is optional. To avoid any special logic for the */
-    /* two cases where alpha is or isn't given, parsing will just be done backwards. Here, 'hex' is used as an */
-    /* iterator so it will begin at the end of the string. */
-    hex += length - 1;
+void AddToHashTable(RaytmxHashTable* table, const char* key, uint64_t hash, void* value) {
+    if ((table->length + 1) * 4 > table->capacity * 3) { /* If the table would be more than three quarters full */
+        /* Double the capacity and move the slots in use to their new places */
+        RaytmxHashTable grown;
+        grown.capacity = table->capacity > 0 ? table->capacity * 2 : 16;
+        grown.length = 0;
+        grown.slots = (RaytmxHashSlot*)MemAllocZero(sizeof(RaytmxHashSlot) * grown.capacity);
+        for (uint32_t i = 0; i < table->capacity; i++) {
+            if (table->slots[i].key != NULL)
+                AddToHashTable(&grown, table->slots[i].key, table->slots[i].hash, table->slots[i].value);
+        }
+        FreeHashTable(table);
+        *table = grown;
+    }
 
-    char component[] = "\0\0\0"; /* Used to hold the two-digit component (e.g. "55" or "ff") */
-    for (size_t i = 0; i < length / 2; i++) { /* Iterate three or four times with four meaning alpha was included */
-        component[1] = *hex--; /* Store the char value 'hex' points to then point to the previous char */
+    uint32_t mask = table->capacity - 1;
+    uint32_t i = (uint32_t)hash & mask;
+    while (table->slots[i].key != NULL)
+        i = (i + 1) & mask;
+    table->slots[i].hash = hash;
+    table->slots[i].key = key;
+    table->slots[i].value = value;
+    table->length += 1;
+}
+
+void FreeHashTable(RaytmxHashTable* table) {
+    if (table->slots != NULL)
+        MemFree(table->slots);
+    table->slots = NULL;
+    table->capacity = 0;
+    table->length = 0;
+}
+
+uint64_t GetStringHash(const char* str) {
+    return GetXxHash64((const unsigned char*)str, strlen(str));
+}
+
+void RunLoadTask(TmxLoadTask* task) {
+    RaytmxExternalFile file = LoadExternalFile(task->fileName);
+    if (file.data == NULL)
+        TraceLog(LOG_ERROR, "RAYTMX: Failed to open \"%s\"", task->fileName);
+    else {
+        TMX_ATOMIC_STORE(&task->bytesTotal, file.length);
+        task->map = LoadMapFromMemory((const char*)file.data, file.length, task->fileName, task);
+        UnloadExternalFile(file);
+    }
+    TMX_ATOMIC_STORE(&task->isLoaded, true); /* Publishes the map and pending textures to the finalizing thread */
+}
+
+#if defined(TMX_THREADS_PTHREADS)
+void* RunLoadTaskThread(void* task) {
+    RunLoadTask((TmxLoadTask*)task);
+    return NULL;
+}
+#elif defined(TMX_THREADS_WIN32)
+unsigned __stdcall RunLoadTaskThread(void* task) {
+    RunLoadTask((TmxLoadTask*)task);
+    return 0;
+}
+#endif
+
+void JoinLoadTask(TmxLoadTask* task) {
+    if (!task->hasThread)
+        return;
+
+#if defined(TMX_THREADS_PTHREADS)
+    pthread_join(task->thread, NULL);
+#elif defined(TMX_THREADS_WIN32)
+    WaitForSingleObject((void*)task->thread, 0xFFFFFFFF /* INFINITE */);
+    CloseHandle((void*)task->thread);
+#endif
+    task->hasThread = false;
+}
+
+void FreeLoadTask(TmxLoadTask* task) {
+    FreePendingTextures(task);
+    MemFree(task->fileName);
+    MemFree(task);
+}
+
+void FreePendingTextures(TmxLoadTask* task) {
+    /* Unload whatever the map didn't take ownership of: images yet to be uploaded and textures nothing refers to */
+    for (uint32_t i = 0; i < task->pendingTexturesLength; i++) {
+        RaytmxPendingTexture* pendingTexture = &task->pendingTextures[i];
+        FreeString(pendingTexture->path);
+        FreeString(pendingTexture->canonicalPath);
+        if (pendingTexture->image.data != NULL)
+            UnloadImage(pendingTexture->image);
+        if (pendingTexture->sharedTexture != NULL) /* If shared, the map holds references of its own */
+            ReleaseSharedTexture(pendingTexture->sharedTexture);
+        else if (pendingTexture->isUploaded && pendingTexture->texture.id != 0 && !pendingTexture->isReferenced)
+            UnloadTexture(pendingTexture->texture);
+    }
+    if (task->pendingTextures != NULL)
+        MemFree(task->pendingTextures);
+    FreeHashTable(&task->pendingTexturesTable);
+    task->pendingTextures = NULL;
+    task->pendingTexturesLength = 0;
+    task->pendingTexturesCapacity = 0;
+}
+
+bool IsLoadCanceled(TmxLoadTask* task) {
+    return task != NULL && TMX_ATOMIC_LOAD(&task->isCanceled);
+}
+
+Texture2D AddPendingTexture(TmxLoadTask* task, const char* path) {
+    if (task->pendingTexturesLength == task->pendingTexturesCapacity) {
+        task->pendingTexturesCapacity = task->pendingTexturesCapacity > 0 ? task->pendingTexturesCapacity * 2 : 8;
+        task->pendingTextures = (RaytmxPendingTexture*)MemRealloc(task->pendingTextures,
+            sizeof(RaytmxPendingTexture) * task->pendingTexturesCapacity);
+    }
+    /* An image referenced by path more than once in the same load, like one shared by several tilesets or by both */
+    /* cached and newly-parsed documents, is given the one placeholder so it's decoded and uploaded once */
+    char* canonicalPath = NULL;
+    uint64_t hash = 0;
+    if (path != NULL) {
+        canonicalPath = CanonicalizePath(path);
+        hash = GetStringHash(canonicalPath);
+        uintptr_t id = (uintptr_t)FindInHashTable(&task->pendingTexturesTable, canonicalPath, hash);
+        if (id != 0) {
+            MemFree(canonicalPath);
+            return task->pendingTextures[id - 1].texture;
+        }
+    }
+
+    RaytmxPendingTexture* pendingTexture = &task->pendingTextures[task->pendingTexturesLength++];
+    memset(pendingTexture, 0, sizeof(RaytmxPendingTexture));
+    if (path != NULL) {
+        pendingTexture->path = (char*)MemAllocZero((unsigned int)strlen(path) + 1);
+        StringCopy(pendingTexture->path, path);
+        pendingTexture->canonicalPath = canonicalPath;
+        AddToHashTable(&task->pendingTexturesTable, canonicalPath, hash, (void*)(uintptr_t)task->pendingTexturesLength);
+    }
+
+    /* The placeholder's ID is the index of the pending texture plus one. Its dimensions are filled in once the */
+    /* image is decoded. */
+    pendingTexture->texture.id = task->pendingTexturesLength;
+    return pendingTexture->texture;
+}
+
+Texture2D AddDecodedTexture(TmxLoadTask* task, Image* image) {
+    /* Take the image, leaving the caller without it */
+    Texture2D placeholder = AddPendingTexture(task, NULL);
+    RaytmxPendingTexture* pendingTexture = &task->pendingTextures[placeholder.id - 1];
+    pendingTexture->image = *image;
+    image->data = NULL;
+
+    placeholder.width = pendingTexture->image.width;
+    placeholder.height = pendingTexture->image.height;
+    placeholder.mipmaps = pendingTexture->image.mipmaps;
+    placeholder.format = pendingTexture->image.format;
+    pendingTexture->texture = placeholder;
+    return placeholder;
+}
+
+void DecodePendingTextures(TmxLoadTask* task) {
+    if (task->pendingTexturesLength == 0)
+        return;
+
+    /* Every texture pending at this point, right after parsing, was referenced by path. Those already in the shared */
+    /* cache are referenced for the duration of the load, which keeps them in VRAM, and aren't decoded. */
+    uint32_t* indexes = (uint32_t*)MemAlloc(sizeof(uint32_t) * task->pendingTexturesLength);
+    const char** imagePaths = (const char**)MemAlloc(sizeof(char*) * task->pendingTexturesLength);
+    uint32_t imagesLength = 0;
+    for (uint32_t i = 0; i < task->pendingTexturesLength; i++) {
+        RaytmxPendingTexture* pendingTexture = &task->pendingTextures[i];
+        if (task->isSharingTextures) {
+            pendingTexture->sharedTexture = AcquireSharedTexture(pendingTexture->canonicalPath);
+            if (pendingTexture->sharedTexture != NULL) {
+                pendingTexture->texture.width = pendingTexture->sharedTexture->texture.width;
+                pendingTexture->texture.height = pendingTexture->sharedTexture->texture.height;
+                pendingTexture->texture.mipmaps = pendingTexture->sharedTexture->texture.mipmaps;
+                pendingTexture->texture.format = pendingTexture->sharedTexture->texture.format;
+                continue;
+            }
+        }
+        indexes[imagesLength] = i;
+        imagePaths[imagesLength++] = pendingTexture->path;
+    }
+    Image* images = (Image*)MemAllocZero(sizeof(Image) * (imagesLength > 0 ? imagesLength : 1));
+    RaytmxImageQueue queue;
+    memset(&queue, 0, sizeof(RaytmxImageQueue));
+    queue.paths = imagePaths;
+    queue.images = images;
+    queue.imagesLength = imagesLength;
+    queue.task = task;
+    DecodeImages(&queue);
+
+    /* Hand the images to the pending textures, reporting any that couldn't be decoded, and give the placeholders */
+    /* the images' dimensions */
+    for (uint32_t i = 0; i < imagesLength; i++) {
+        RaytmxPendingTexture* pendingTexture = &task->pendingTextures[indexes[i]];
+        pendingTexture->image = images[i];
+        if (images[i].data == NULL) {
+            if (!IsLoadCanceled(task))
+                TraceLog(LOG_ERROR, "RAYTMX: Unable to load texture \"%s\"", pendingTexture->path);
+            memset(&pendingTexture->texture, 0, sizeof(Texture2D));
+        } else {
+            pendingTexture->texture.width = images[i].width;
+            pendingTexture->texture.height = images[i].height;
+            pendingTexture->texture.mipmaps = images[i].mipmaps;
+            pendingTexture->texture.format = images[i].format;
+        }
+    }
+    MemFree(indexes);
+    MemFree((void*)imagePaths);
+    MemFree(images);
+}
+
+void UploadPendingTexture(TmxLoadTask* task) {
+    RaytmxPendingTexture* pendingTexture = &task->pendingTextures[task->texturesUploaded];
+    if (pendingTexture->image.data != NULL && task->isSharingTextures) {
+        /* Another load may have shared the same image's texture since this one's image was decoded */
+        pendingTexture->sharedTexture = AcquireSharedTexture(pendingTexture->canonicalPath);
+    }
+    if (pendingTexture->sharedTexture != NULL) /* If the texture is already in VRAM */
+        pendingTexture->texture = pendingTexture->sharedTexture->texture;
+    else if (pendingTexture->image.data != NULL) { /* If the image was decoded */
+        pendingTexture->texture = LoadTextureFromImage(pendingTexture->image);
+        if (pendingTexture->texture.id == 0 && pendingTexture->path != NULL)
+            TraceLog(LOG_ERROR, "RAYTMX: Unable to load texture \"%s\"", pendingTexture->path);
+        else if (pendingTexture->texture.id != 0 && task->isSharingTextures && pendingTexture->canonicalPath != NULL)
+            pendingTexture->sharedTexture = AddSharedTexture(pendingTexture->canonicalPath, pendingTexture->texture);
+    }
+    if (pendingTexture->image.data != NULL) {
+        UnloadImage(pendingTexture->image);
+        pendingTexture->image.data = NULL;
+    }
+    pendingTexture->isUploaded = true;
+    TMX_ATOMIC_STORE(&task->texturesUploaded, task->texturesUploaded + 1);
+}
+
+void DecodeImages(RaytmxImageQueue* queue) {
+    if (queue->task != NULL)
+        TMX_ATOMIC_STORE(&queue->task->imagesTotal, queue->task->imagesTotal + queue->imagesLength);
+
+    /* Use as many threads as are wanted, up to one per image, to take images from the queue until it's empty */
+    uint32_t threadsLength = GetLoadThreadsLength();
+    if (threadsLength > queue->imagesLength)
+        threadsLength = queue->imagesLength;
+    RaytmxThreadWork work;
+    work.run = RunImageQueue;
+    work.queue = queue;
+    RunOnLoadThreads(&work, threadsLength);
+}
+
+void RunImageQueue(void* imageQueue) {
+    /* This may run on any thread so it must only touch the images it takes from the queue. Images that can't be */
+    /* decoded are left with NULL data and reported once every image has been decoded. */
+    RaytmxImageQueue* queue = (RaytmxImageQueue*)imageQueue;
+#ifdef TMX_THREADS
+    for (uint32_t i = TMX_ATOMIC_INCREMENT(&queue->nextImage); i < queue->imagesLength;
+            i = TMX_ATOMIC_INCREMENT(&queue->nextImage)) {
+#else
+    for (uint32_t i = queue->nextImage; i < queue->imagesLength; i = ++queue->nextImage) {
+#endif
+        if (IsLoadCanceled(queue->task)) /* If the load was canceled, leave the remaining images undecoded */
+            break;
+        Image image = LoadExternalImage(queue->paths[i]);
+        if (image.data != NULL && queue->format != 0)
+            ImageFormat(&image, queue->format);
+        queue->images[i] = image;
+        if (queue->task != NULL) {
+#ifdef TMX_THREADS
+            TMX_ATOMIC_INCREMENT(&queue->task->imagesDecoded);
+#else
+            queue->task->imagesDecoded += 1;
+#endif
+        }
+    }
+}
+
+void ResolveTaskTextures(TmxLoadTask* task, TmxMap* map) {
+    for (uint32_t i = 0; i < map->tilesetsLength; i++) {
+        TmxTileset* tileset = &map->tilesets[i];
+        if (tileset->hasImage)
+            ResolveTaskTexture(task, &tileset->image.texture, true);
+        for (uint32_t j = 0; j < tileset->tilesLength; j++) {
+            if (tileset->tiles[j].hasImage)
+                ResolveTaskTexture(task, &tileset->tiles[j].image.texture, true);
+        }
+    }
+    ResolveTaskLayerTextures(task, map->layers, map->layersLength);
+    for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++)
+        ResolveTaskTexture(task, &map->gidsToTiles[gid].texture, false);
+    for (uint32_t i = 0; i < map->atlasesLength; i++)
+        ResolveTaskTexture(task, &map->atlases[i], false);
+}
+
+void ResolveTaskLayerTextures(TmxLoadTask* task, TmxLayer* layers, uint32_t layersLength) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        TmxLayer* layer = &layers[i];
+        if (layer->type == LAYER_TYPE_IMAGE_LAYER && layer->exact.imageLayer.hasImage)
+            ResolveTaskTexture(task, &layer->exact.imageLayer.image.texture, true);
+        else if (layer->type == LAYER_TYPE_GROUP)
+            ResolveTaskLayerTextures(task, layer->layers, layer->layersLength);
+    }
+}
+
+void ResolveTaskTexture(TmxLoadTask* task, Texture2D* texture, bool isOwner) {
+    if (texture->id == 0 || texture->id > task->pendingTexturesLength) /* If there's no texture */
+        return;
+
+    /* Depending on how far along loading is, this gives the placeholder dimensions, swaps it for the uploaded */
+    /* texture, or zeroizes it because its image couldn't be decoded or won't be uploaded */
+    RaytmxPendingTexture* pendingTexture = &task->pendingTextures[texture->id - 1];
+    *texture = pendingTexture->texture;
+    if (pendingTexture->isUploaded && pendingTexture->texture.id != 0) {
+        pendingTexture->isReferenced = true;
+        if (isOwner && pendingTexture->isOwned && pendingTexture->sharedTexture == NULL) {
+            /* A second owner of a texture that isn't shared between maps, like a tileset sharing its image with */
+            /* another, makes the texture reference-counted so that only its last owner unloads it. Without a path, */
+            /* other loads can't find it. It starts with the load's reference, released once loading is done, and */
+            /* is given the first owner's. */
+            pendingTexture->sharedTexture = AddSharedTexture(NULL, pendingTexture->texture);
+            LockCaches();
+            pendingTexture->sharedTexture->referencesCount += 1;
+            UnlockCaches();
+        }
+        if (isOwner && pendingTexture->sharedTexture != NULL) { /* If the owner will release the shared texture */
+            LockCaches();
+            pendingTexture->sharedTexture->referencesCount += 1;
+            UnlockCaches();
+        }
+        if (isOwner)
+            pendingTexture->isOwned = true;
+    }
+}
+
+void DetachTilesetTextures(TmxTileset* tileset) {
+    tileset->image.texture.id = 0;
+    for (uint32_t i = 0; i < tileset->tilesLength; i++)
+        tileset->tiles[i].image.texture.id = 0;
+}
+
+RaytmxSharedTexture* AcquireSharedTexture(const char* canonicalPath) {
+    LockCaches();
+    RaytmxSharedTexture* sharedTexture = tmxSharedTextures;
+    for (; sharedTexture != NULL; sharedTexture = sharedTexture->next) {
+        if (sharedTexture->path != NULL && strcmp(sharedTexture->path, canonicalPath) == 0) {
+            sharedTexture->referencesCount += 1;
+            break;
+        }
+    }
+    UnlockCaches();
+    return sharedTexture;
+}
+
+RaytmxSharedTexture* AddSharedTexture(const char* canonicalPath, Texture2D texture) {
+    /* The texture starts with a single reference, held by the load that uploaded it */
+    RaytmxSharedTexture* sharedTexture = (RaytmxSharedTexture*)MemAllocZero(sizeof(RaytmxSharedTexture));
+    sharedTexture->path = CopyString(canonicalPath);
+    sharedTexture->texture = texture;
+    sharedTexture->referencesCount = 1;
+    LockCaches();
+    sharedTexture->next = tmxSharedTextures;
+    tmxSharedTextures = sharedTexture;
+    UnlockCaches();
+    return sharedTexture;
+}
+
+void ReleaseSharedTexture(RaytmxSharedTexture* sharedTexture) {
+    LockCaches();
+    sharedTexture->referencesCount -= 1;
+    bool isUnused = sharedTexture->referencesCount == 0;
+    if (isUnused) { /* If nothing refers to the texture anymore, remove it from the cache */
+        RaytmxSharedTexture** link = &tmxSharedTextures;
+        while (*link != sharedTexture)
+            link = &(*link)->next;
+        *link = sharedTexture->next;
+    }
+    UnlockCaches();
+    if (isUnused) {
+        UnloadTexture(sharedTexture->texture);
+        FreeString(sharedTexture->path);
+        MemFree(sharedTexture);
+    }
+}
+
+void ReleaseTexture(Texture2D texture) {
+    /* Shared textures are released, and only unloaded by the last owner, while all others are unloaded outright. */
+    /* References are only released on the thread owning the graphics context so the texture can't be unloaded by */
+    /* another thread between finding it and releasing it. */
+    LockCaches();
+    RaytmxSharedTexture* sharedTexture = tmxSharedTextures;
+    while (sharedTexture != NULL && sharedTexture->texture.id != texture.id)
+        sharedTexture = sharedTexture->next;
+    UnlockCaches();
+    if (sharedTexture != NULL)
+        ReleaseSharedTexture(sharedTexture);
+    else
+        UnloadTexture(texture);
+}
+
+void LockCaches(void) {
+#if defined(TMX_THREADS_PTHREADS)
+    pthread_mutex_lock(&tmxCachesMutex);
+#elif defined(TMX_THREADS_WIN32)
+    AcquireSRWLockExclusive((struct _RTL_SRWLOCK*)&tmxCachesLock);
+#endif
+}
+
+void UnlockCaches(void) {
+#if defined(TMX_THREADS_PTHREADS)
+    pthread_mutex_unlock(&tmxCachesMutex);
+#elif defined(TMX_THREADS_WIN32)
+    ReleaseSRWLockExclusive((struct _RTL_SRWLOCK*)&tmxCachesLock);
+#endif
+}
+
+char* CanonicalizePath(const char* path) {
+    /* Rebuild the path from its segments, dropping empty and "." segments, resolving ".." segments against those */
+    /* before them where possible, and separating them with '/' (e.g. "maps/.././art//a.png" -> "art/a.png") */
+    size_t length = strlen(path);
+    char* canonicalPath = (char*)MemAllocZero((unsigned int)length + 1);
+    size_t rootLength = 0; /* Length of the part of the path that ".." can't go above */
+    if (path[0] == '/' || path[0] == '\\')
+        canonicalPath[rootLength++] = '/';
+    size_t canonicalLength = rootLength;
+    for (size_t i = 0; i < length;) {
+        while (i < length && (path[i] == '/' || path[i] == '\\'))
+            i++;
+        size_t segmentStart = i;
+        while (i < length && path[i] != '/' && path[i] != '\\')
+            i++;
+        size_t segmentLength = i - segmentStart;
+        if (segmentLength == 0 || (segmentLength == 1 && path[segmentStart] == '.'))
+            continue;
+        if (segmentLength == 2 && path[segmentStart] == '.' && path[segmentStart + 1] == '.') {
+            size_t previousStart = canonicalLength;
+            while (previousStart > rootLength && canonicalPath[previousStart - 1] != '/')
+                previousStart--;
+            bool isPreviousParent = canonicalLength - previousStart == 2 && canonicalPath[previousStart] == '.' &&
+                canonicalPath[previousStart + 1] == '.';
+            if (canonicalLength > rootLength && !isPreviousParent) { /* If there's a directory to go up from */
+                canonicalLength = previousStart > rootLength ? previousStart - 1 : rootLength;
+                continue;
+            }
+            if (rootLength > 0) /* If the path is absolute, where going above the root stays at the root */
+                continue;
+        }
+        if (canonicalLength > rootLength)
+            canonicalPath[canonicalLength++] = '/';
+        memcpy(&canonicalPath[canonicalLength], &path[segmentStart], segmentLength);
+        canonicalLength += segmentLength;
+    }
+    canonicalPath[canonicalLength] = '\0';
+    return canonicalPath;
+}
+
+char* GetRelativePath(const char* path, const char* directory) {
+    /* Compare the two, canonicalized, segment by segment and replace each of the directory's segments that the path */
+    /* doesn't share with ".." (e.g. "/a/b/../c/d.png" relative to "/a/e" -> "../c/d.png"). Paths that can't be made */
+    /* relative to the directory, like those on another drive, are kept as they are. */
+    char* canonicalPath = CanonicalizePath(path);
+    char* canonicalDirectory = CanonicalizePath(directory);
+    size_t sharedLength = 0; /* Length of the segments at the start of both, not including the separator after them */
+    for (size_t i = 0;; i++) {
+        char pathCharacter = canonicalPath[i], directoryCharacter = canonicalDirectory[i];
+        bool isPathSegmentEnd = pathCharacter == '/' || pathCharacter == '\0';
+        if (isPathSegmentEnd && (directoryCharacter == '/' || directoryCharacter == '\0'))
+            sharedLength = i;
+        if (pathCharacter != directoryCharacter || pathCharacter == '\0')
+            break;
+    }
+    const char* pathRest = &canonicalPath[sharedLength];
+    const char* directoryRest = &canonicalDirectory[sharedLength];
+    if (pathRest[0] == '/')
+        pathRest++;
+    if (directoryRest[0] == '/')
+        directoryRest++;
+
+    /* Going up from the directory only works if its remaining segments are names and not ".." */
+    uint32_t parentsLength = 0;
+    bool isAbsolute = IsPathAbsolute(canonicalPath);
+    bool isRelative = isAbsolute == IsPathAbsolute(canonicalDirectory) &&
+        (!isAbsolute || canonicalPath[0] == '/' || sharedLength > 0); /* If there's a shared root to go up to */
+    for (const char* segment = directoryRest; isRelative && segment[0] != '\0';) {
+        const char* segmentEnd = strchr(segment, '/');
+        size_t segmentLength = segmentEnd != NULL ? (size_t)(segmentEnd - segment) : strlen(segment);
+        if (segmentLength == 2 && segment[0] == '.' && segment[1] == '.')
+            isRelative = false;
+        parentsLength += 1;
+        segment += segmentLength + (segmentEnd != NULL ? 1 : 0);
+    }
+
+    char* relativePath;
+    if (!isRelative)
+        relativePath = CopyString(path);
+    else {
+        size_t restLength = strlen(pathRest);
+        relativePath = (char*)MemAlloc((unsigned int)(3 * parentsLength + restLength + 1));
+        for (uint32_t i = 0; i < parentsLength; i++)
+            memcpy(&relativePath[3 * i], "../", 3);
+        memcpy(&relativePath[3 * parentsLength], pathRest, restLength + 1);
+    }
+    MemFree(canonicalPath);
+    MemFree(canonicalDirectory);
+    return relativePath;
+}
+
+bool CopyCachedDocument(const char* canonicalPath, long modTime, TmxLoadTask* task, RaytmxObjectTemplate* contents) {
+    bool isHeadless = (tmxLoadFlags & LOAD_HEADLESS) != 0;
+    bool isFound = false;
+
+    /* Copy while holding the lock so that the cached document can't be flushed or replaced mid-copy */
+    LockCaches();
+    RaytmxCachedDocument** link = &tmxCachedDocuments;
+    while (*link != NULL) {
+        RaytmxCachedDocument* cachedDocument = *link;
+        if (cachedDocument->isHeadless != isHeadless || strcmp(cachedDocument->path, canonicalPath) != 0) {
+            link = &cachedDocument->next;
+            continue;
+        }
+        if (cachedDocument->modTime != modTime) { /* If the file has changed since it was cached, drop the copy */
+            *link = cachedDocument->next;
+            FreeCachedDocument(cachedDocument);
+            break;
+        }
+        *contents = cachedDocument->contents;
+        contents->object = CopyObject(&cachedDocument->contents.object);
+        if (cachedDocument->contents.hasTileset)
+            contents->tileset = CopyTileset(&cachedDocument->contents.tileset, task);
+        isFound = true;
+        break;
+    }
+    UnlockCaches();
+    return isFound;
+}
+
+void AddCachedDocument(const char* canonicalPath, long modTime, const RaytmxObjectTemplate* contents) {
+    /* Cache a copy, without textures as those belong to the load that parsed the document */
+    RaytmxCachedDocument* cachedDocument = (RaytmxCachedDocument*)MemAllocZero(sizeof(RaytmxCachedDocument));
+    cachedDocument->path = CopyString(canonicalPath);
+    cachedDocument->modTime = modTime;
+    cachedDocument->isHeadless = (tmxLoadFlags & LOAD_HEADLESS) != 0;
+    cachedDocument->contents = *contents;
+    cachedDocument->contents.object = CopyObject(&contents->object);
+    if (contents->hasTileset)
+        cachedDocument->contents.tileset = CopyTileset(&contents->tileset, NULL);
+
+    /* Another load may have cached the same document in the meantime, in which case that copy is replaced */
+    LockCaches();
+    RaytmxCachedDocument* replaced = NULL;
+    for (RaytmxCachedDocument** link = &tmxCachedDocuments; *link != NULL; link = &(*link)->next) {
+        if ((*link)->isHeadless == cachedDocument->isHeadless && strcmp((*link)->path, cachedDocument->path) == 0) {
+            replaced = *link;
+            *link = replaced->next;
+            break;
+        }
+    }
+    cachedDocument->next = tmxCachedDocuments;
+    tmxCachedDocuments = cachedDocument;
+    UnlockCaches();
+
+    if (replaced != NULL)
+        FreeCachedDocument(replaced);
+}
+
+void FreeCachedDocument(RaytmxCachedDocument* cachedDocument) {
+    /* Maps' objects share their templates' properties, and more, which FreeObject() leaves alone. The cached copies */
+    /* are shared with no map so they're freed as well. */
+    TmxObject* object = &cachedDocument->contents.object;
+    MemFree(cachedDocument->path);
+    if (object->properties != NULL) {
+        for (uint32_t i = 0; i < object->propertiesLength; i++)
+            FreeProperty(object->properties[i]);
+        MemFree(object->properties);
+    }
+    if (object->offsetPoints != NULL)
+        MemFree(object->offsetPoints);
+    if (object->text != NULL) {
+        FreeString(object->text->fontFamily);
+        FreeString(object->text->content);
+    }
+    FreeObject(*object);
+    if (cachedDocument->contents.hasTileset)
+        FreeTileset(cachedDocument->contents.tileset); /* Its textures are zeroized so none are unloaded */
+    MemFree(cachedDocument);
+}
+
+long GetDocumentModTime(const char* fileName) {
+    /* Files read through callbacks may not be on disk at all */
+    return tmxLoadFile == NULL ? GetFileModTime(fileName) : 0;
+}
+
+TmxTileset CopyTileset(const TmxTileset* tileset, TmxLoadTask* task) {
+    TmxTileset copy = *tileset;
+    copy.source = CopyString(tileset->source);
+    copy.name = CopyString(tileset->name);
+    copy.classString = CopyString(tileset->classString);
+    copy.properties = CopyProperties(tileset->properties, tileset->propertiesLength);
+    if (tileset->hasImage) {
+        copy.image.source = CopyString(tileset->image.source);
+        copy.image.path = CopyString(tileset->image.path);
+    }
+    if (tileset->tiles != NULL) {
+        copy.tiles = (TmxTilesetTile*)MemAlloc(sizeof(TmxTilesetTile) * tileset->tilesLength);
+        for (uint32_t i = 0; i < tileset->tilesLength; i++) {
+            const TmxTilesetTile* tile = &tileset->tiles[i];
+            TmxTilesetTile* tileCopy = &copy.tiles[i];
+            *tileCopy = *tile;
+            if (tile->hasImage) {
+                tileCopy->image.source = CopyString(tile->image.source);
+                tileCopy->image.path = CopyString(tile->image.path);
+            }
+            if (tile->hasAnimation && tile->animation.frames != NULL) {
+                tileCopy->animation.frames =
+                    (TmxAnimationFrame*)MemAlloc(sizeof(TmxAnimationFrame) * tile->animation.framesLength);
+                memcpy(tileCopy->animation.frames, tile->animation.frames,
+                    sizeof(TmxAnimationFrame) * tile->animation.framesLength);
+            }
+            if (tile->hasAnimation && tile->animation.frameEnds != NULL) {
+                tileCopy->animation.frameEnds = (double*)MemAlloc(sizeof(double) * tile->animation.framesLength);
+                memcpy(tileCopy->animation.frameEnds, tile->animation.frameEnds,
+                    sizeof(double) * tile->animation.framesLength);
+            }
+            tileCopy->properties = CopyProperties(tile->properties, tile->propertiesLength);
+        }
+    }
+
+    /* Without a load, the copy is left without textures. With one, the copy's images are given textures as parsing */
+    /* would have, in the same order. The load's pending textures are looked up by path so images already */
+    /* referenced, by this tileset or any other part of the map, reuse their textures. */
+    copy.image.texture.id = 0;
+    for (uint32_t i = 0; i < copy.tilesLength; i++)
+        copy.tiles[i].image.texture.id = 0;
+    if (task == NULL || (tmxLoadFlags & (LOAD_PACK_ATLAS | LOAD_HEADLESS)))
+        return copy;
+    if (copy.hasImage && copy.image.path != NULL)
+        copy.image.texture = AddPendingTexture(task, copy.image.path);
+    for (uint32_t i = 0; i < copy.tilesLength; i++) {
+        if (copy.tiles[i].hasImage && copy.tiles[i].image.path != NULL)
+            copy.tiles[i].image.texture = AddPendingTexture(task, copy.tiles[i].image.path);
+    }
+    return copy;
+}
+
+TmxObject CopyObject(const TmxObject* object) {
+    TmxObject copy = *object;
+    copy.name = CopyString(object->name);
+    copy.typeString = CopyString(object->typeString);
+    copy.templateString = CopyString(object->templateString);
+    copy.properties = CopyProperties(object->properties, object->propertiesLength);
+    if (object->points != NULL) {
+        copy.points = (Vector2*)MemAlloc(sizeof(Vector2) * object->pointsLength);
+        memcpy(copy.points, object->points, sizeof(Vector2) * object->pointsLength);
+    }
+    if (object->offsetPoints != NULL) {
+        copy.offsetPoints = (Vector2*)MemAlloc(sizeof(Vector2) * object->pointsLength);
+        memcpy(copy.offsetPoints, object->offsetPoints, sizeof(Vector2) * object->pointsLength);
+    }
+    if (object->text != NULL) {
+        copy.text = (TmxText*)MemAlloc(sizeof(TmxText));
+        *copy.text = *object->text;
+        copy.text->fontFamily = CopyString(object->text->fontFamily);
+        copy.text->content = CopyString(object->text->content);
+        if (object->text->lines != NULL) {
+            copy.text->lines = (TmxTextLine*)MemAlloc(sizeof(TmxTextLine) * object->text->linesLength);
+            for (uint32_t i = 0; i < object->text->linesLength; i++) {
+                copy.text->lines[i] = object->text->lines[i];
+                copy.text->lines[i].content = CopyString(object->text->lines[i].content);
+            }
+        }
+    }
+    return copy;
+}
+
+TmxProperty* CopyProperties(const TmxProperty* properties, uint32_t propertiesLength) {
+    if (properties == NULL)
+        return NULL;
+
+    TmxProperty* copy = (TmxProperty*)MemAlloc(sizeof(TmxProperty) * propertiesLength);
+    for (uint32_t i = 0; i < propertiesLength; i++) {
+        copy[i] = properties[i];
+        copy[i].name = CopyString(properties[i].name);
+        copy[i].stringValue = CopyString(properties[i].stringValue);
+    }
+    return copy;
+}
+
+char* CopyString(const char* str) {
+    if (str == NULL)
+        return NULL;
+
+    char* copy = (char*)MemAlloc((unsigned int)strlen(str) + 1);
+    StringCopy(copy, str);
+    return copy;
+}
+
+void AddBinaryMapTextures(TmxMap* map, TmxLoadTask* task, bool isPackingAtlases) {
+    /* Images are given textures in the order parsing would have, with images of the same path sharing a texture. */
+    /* When packing atlases, tilesets' images are left without textures as the atlases replace them. */
+    RaytmxHashTable images;
+    memset(&images, 0, sizeof(RaytmxHashTable));
+    for (uint32_t i = 0; i < map->tilesetsLength && !isPackingAtlases; i++) {
+        TmxTileset* tileset = &map->tilesets[i];
+        if (tileset->hasImage)
+            AddBinaryImageTexture(task, &images, &tileset->image);
+        for (uint32_t j = 0; j < tileset->tilesLength; j++) {
+            if (tileset->tiles[j].hasImage)
+                AddBinaryImageTexture(task, &images, &tileset->tiles[j].image);
+        }
+    }
+    AddBinaryLayerTextures(task, &images, map->layers, map->layersLength);
+    FreeHashTable(&images);
+}
+
+void AddBinaryLayerTextures(TmxLoadTask* task, RaytmxHashTable* images, TmxLayer* layers, uint32_t layersLength) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        TmxLayer* layer = &layers[i];
+        if (layer->type == LAYER_TYPE_IMAGE_LAYER && layer->exact.imageLayer.hasImage)
+            AddBinaryImageTexture(task, images, &layer->exact.imageLayer.image);
+        else if (layer->type == LAYER_TYPE_GROUP)
+            AddBinaryLayerTextures(task, images, layer->layers, layer->layersLength);
+    }
+}
+
+void AddBinaryImageTexture(TmxLoadTask* task, RaytmxHashTable* images, TmxImage* image) {
+    if (image->path == NULL)
+        return;
+
+    uint64_t hash = GetStringHash(image->path);
+    const TmxImage* sameImage = (const TmxImage*)FindInHashTable(images, image->path, hash);
+    if (sameImage != NULL)
+        image->texture = sameImage->texture;
+    else {
+        image->texture = AddPendingTexture(task, image->path);
+        AddToHashTable(images, image->path, hash, image);
+    }
+}
+
+void GetTileImages(const TmxMap* map, const TmxImage** gidsToImages) {
+    /* This follows how LoadTMX() gives tiles their textures: tiles of a shared image use it unless they're */
+    /* animations while tiles of an image collection use their own */
+    for (uint32_t i = 0; i < map->tilesetsLength; i++) {
+        const TmxTileset* tileset = &map->tilesets[i];
+        if (tileset->hasImage) {
+            for (uint32_t id = 0; id < tileset->tileCount; id++) {
+                int64_t gid = (int64_t)tileset->firstGid + id;
+                if (gid >= (int64_t)map->gidsToTilesLength)
+                    break;
+                if (gid > 0 && !map->gidsToTiles[gid].hasAnimation)
+                    gidsToImages[gid] = &tileset->image;
+            }
+        } else {
+            for (uint32_t j = 0; j < tileset->tilesLength; j++) {
+                int64_t gid = (int64_t)tileset->firstGid + tileset->tiles[j].id;
+                if (tileset->tiles[j].hasImage && gid > 0 && gid < (int64_t)map->gidsToTilesLength)
+                    gidsToImages[gid] = &tileset->tiles[j].image;
+            }
+        }
+    }
+}
+
+void WriteBinaryMap(RaytmxBinaryWriter* writer, const TmxMap* map) {
+    WriteBinaryString(writer, map->fileName);
+    WriteBinaryU32(writer, (uint32_t)map->orientation);
+    WriteBinaryU32(writer, (uint32_t)map->renderOrder);
+    WriteBinaryU32(writer, map->width);
+    WriteBinaryU32(writer, map->height);
+    WriteBinaryU32(writer, map->tileWidth);
+    WriteBinaryU32(writer, map->tileHeight);
+    WriteBinaryU32(writer, (uint32_t)map->parallaxOriginX);
+    WriteBinaryU32(writer, (uint32_t)map->parallaxOriginY);
+    WriteBinaryColor(writer, map->backgroundColor);
+    WriteBinaryBool(writer, map->hasBackgroundColor);
+    WriteBinaryProperties(writer, map->properties, map->propertiesLength);
+
+    WriteBinaryU32(writer, map->tilesets != NULL ? map->tilesetsLength : 0);
+    for (uint32_t i = 0; map->tilesets != NULL && i < map->tilesetsLength; i++)
+        WriteBinaryTileset(writer, &map->tilesets[i]);
+    WriteBinaryLayers(writer, map->layers, map->layersLength);
+
+    /* The tiles come after the tilesets since animated tiles refer to their tilesets' tiles */
+    WriteBinaryU32(writer, map->gidsToTiles != NULL ? map->gidsToTilesLength : 0);
+    for (uint32_t gid = 0; map->gidsToTiles != NULL && gid < map->gidsToTilesLength; gid++)
+        WriteBinaryTile(writer, map, &map->gidsToTiles[gid]);
+    WriteBinaryBool(writer, map->gidsToTiles != NULL && map->displayGids != NULL);
+    if (map->gidsToTiles != NULL && map->displayGids != NULL)
+        WriteBinaryU32s(writer, (const uint32_t*)map->displayGids, map->gidsToTilesLength);
+    WriteBinaryU32(writer, map->animatedGids != NULL ? map->animatedGidsLength : 0);
+    if (map->animatedGids != NULL)
+        WriteBinaryU32s(writer, map->animatedGids, map->animatedGidsLength);
+    WriteBinaryDouble(writer, map->animationTime);
+    WriteBinaryFloat(writer, map->tileBounds.x);
+    WriteBinaryFloat(writer, map->tileBounds.y);
+    WriteBinaryFloat(writer, map->tileBounds.width);
+    WriteBinaryFloat(writer, map->tileBounds.height);
+}
+
+void WriteBinaryTileset(RaytmxBinaryWriter* writer, const TmxTileset* tileset) {
+    WriteBinaryU32(writer, (uint32_t)tileset->firstGid);
+    WriteBinaryU32(writer, (uint32_t)tileset->lastGid);
+    WriteBinaryString(writer, tileset->source);
+    WriteBinaryString(writer, tileset->name);
+    WriteBinaryString(writer, tileset->classString);
+    WriteBinaryU32(writer, tileset->tileWidth);
+    WriteBinaryU32(writer, tileset->tileHeight);
+    WriteBinaryU32(writer, tileset->spacing);
+    WriteBinaryU32(writer, tileset->margin);
+    WriteBinaryU32(writer, tileset->tileCount);
+    WriteBinaryU32(writer, tileset->columns);
+    WriteBinaryU32(writer, (uint32_t)tileset->objectAlignment);
+    WriteBinaryU32(writer, (uint32_t)tileset->tileOffsetX);
+    WriteBinaryU32(writer, (uint32_t)tileset->tileOffsetY);
+    WriteBinaryBool(writer, tileset->hasImage);
+    if (tileset->hasImage)
+        WriteBinaryImage(writer, &tileset->image);
+    WriteBinaryProperties(writer, tileset->properties, tileset->propertiesLength);
+
+    WriteBinaryU32(writer, tileset->tiles != NULL ? tileset->tilesLength : 0);
+    for (uint32_t i = 0; tileset->tiles != NULL && i < tileset->tilesLength; i++) {
+        const TmxTilesetTile* tile = &tileset->tiles[i];
+        WriteBinaryU32(writer, tile->id);
+        WriteBinaryU32(writer, (uint32_t)tile->x);
+        WriteBinaryU32(writer, (uint32_t)tile->y);
+        WriteBinaryU32(writer, tile->width);
+        WriteBinaryU32(writer, tile->height);
+        WriteBinaryBool(writer, tile->hasImage);
+        if (tile->hasImage)
+            WriteBinaryImage(writer, &tile->image);
+        WriteBinaryBool(writer, tile->hasAnimation);
+        if (tile->hasAnimation)
+            WriteBinaryAnimation(writer, &tile->animation);
+        WriteBinaryProperties(writer, tile->properties, tile->propertiesLength);
+    }
+}
+
+void WriteBinaryLayers(RaytmxBinaryWriter* writer, const TmxLayer* layers, uint32_t layersLength) {
+    WriteBinaryU32(writer, layers != NULL ? layersLength : 0);
+    for (uint32_t i = 0; layers != NULL && i < layersLength; i++) {
+        const TmxLayer* layer = &layers[i];
+        WriteBinaryU32(writer, (uint32_t)layer->type);
+        WriteBinaryU32(writer, layer->id);
+        WriteBinaryString(writer, layer->name);
+        WriteBinaryString(writer, layer->classString);
+        WriteBinaryBool(writer, layer->visible);
+        WriteBinaryDouble(writer, layer->opacity);
+        WriteBinaryColor(writer, layer->tintColor);
+        WriteBinaryBool(writer, layer->hasTintColor);
+        WriteBinaryU32(writer, (uint32_t)layer->offsetX);
+        WriteBinaryU32(writer, (uint32_t)layer->offsetY);
+        WriteBinaryDouble(writer, layer->parallaxX);
+        WriteBinaryDouble(writer, layer->parallaxY);
+        WriteBinaryProperties(writer, layer->properties, layer->propertiesLength);
+
+        switch (layer->type) {
+        case LAYER_TYPE_TILE_LAYER: {
+            /* The chunks' geometry is built when first drawn so only the GIDs are written */
+            const TmxTileLayer* tileLayer = &layer->exact.tileLayer;
+            WriteBinaryU32(writer, tileLayer->width);
+            WriteBinaryU32(writer, tileLayer->height);
+            WriteBinaryString(writer, tileLayer->encoding);
+            WriteBinaryString(writer, tileLayer->compression);
+            WriteBinaryU32(writer, tileLayer->tiles != NULL ? tileLayer->tilesLength : 0);
+            if (tileLayer->tiles != NULL)
+                WriteBinaryU32s(writer, tileLayer->tiles, tileLayer->tilesLength);
+        } break;
+        case LAYER_TYPE_OBJECT_GROUP: {
+            const TmxObjectGroup* objectGroup = &layer->exact.objectGroup;
+            WriteBinaryColor(writer, objectGroup->color);
+            WriteBinaryBool(writer, objectGroup->hasColor);
+            WriteBinaryU32(writer, (uint32_t)objectGroup->drawOrder);
+            uint32_t objectsLength = objectGroup->objects != NULL ? objectGroup->objectsLength : 0;
+            WriteBinaryU32(writer, objectsLength);
+            for (uint32_t j = 0; j < objectsLength; j++)
+                WriteBinaryObject(writer, &objectGroup->objects[j]);
+            WriteBinaryBool(writer, objectsLength > 0 && objectGroup->ySortedObjects != NULL);
+            if (objectsLength > 0 && objectGroup->ySortedObjects != NULL)
+                WriteBinaryU32s(writer, objectGroup->ySortedObjects, objectsLength);
+        } break;
+        case LAYER_TYPE_IMAGE_LAYER:
+            WriteBinaryBool(writer, layer->exact.imageLayer.repeatX);
+            WriteBinaryBool(writer, layer->exact.imageLayer.repeatY);
+            WriteBinaryBool(writer, layer->exact.imageLayer.hasImage);
+            if (layer->exact.imageLayer.hasImage)
+                WriteBinaryImage(writer, &layer->exact.imageLayer.image);
+        break;
+        case LAYER_TYPE_GROUP: break; /* Nothing but child layers, which every layer type is followed by */
+        }
+        WriteBinaryLayers(writer, layer->layers, layer->layersLength);
+    }
+}
+
+void WriteBinaryObject(RaytmxBinaryWriter* writer, const TmxObject* object) {
+    WriteBinaryU32(writer, (uint32_t)object->type);
+    WriteBinaryU32(writer, object->id);
+    WriteBinaryString(writer, object->name);
+    WriteBinaryString(writer, object->typeString);
+    WriteBinaryDouble(writer, object->x);
+    WriteBinaryDouble(writer, object->y);
+    WriteBinaryDouble(writer, object->width);
+    WriteBinaryDouble(writer, object->height);
+    WriteBinaryDouble(writer, object->rotation);
+    WriteBinaryU32(writer, (uint32_t)object->gid);
+    WriteBinaryBool(writer, object->visible);
+    WriteBinaryString(writer, object->templateString);
+
+    /* 'offsetPoints' is scratch space for drawing, recreated from 'points' when read */
+    uint32_t pointsLength = object->points != NULL ? object->pointsLength : 0;
+    WriteBinaryU32(writer, pointsLength);
+    for (uint32_t i = 0; i < pointsLength; i++) {
+        WriteBinaryFloat(writer, object->points[i].x);
+        WriteBinaryFloat(writer, object->points[i].y);
+    }
+
+    WriteBinaryBool(writer, object->text != NULL);
+    if (object->text != NULL) {
+        const TmxText* text = object->text;
+        WriteBinaryString(writer, text->fontFamily);
+        WriteBinaryU32(writer, text->pixelSize);
+        WriteBinaryBool(writer, text->wrap);
+        WriteBinaryColor(writer, text->color);
+        WriteBinaryBool(writer, text->bold);
+        WriteBinaryBool(writer, text->italic);
+        WriteBinaryBool(writer, text->underline);
+        WriteBinaryBool(writer, text->strikeOut);
+        WriteBinaryBool(writer, text->kerning);
+        WriteBinaryU32(writer, (uint32_t)text->halign);
+        WriteBinaryU32(writer, (uint32_t)text->valign);
+        WriteBinaryString(writer, text->content);
+        /* The lines' font is raylib's default font, which is a texture, so it's looked up again when read */
+        WriteBinaryU32(writer, text->lines != NULL ? text->linesLength : 0);
+        for (uint32_t i = 0; text->lines != NULL && i < text->linesLength; i++) {
+            WriteBinaryString(writer, text->lines[i].content);
+            WriteBinaryFloat(writer, text->lines[i].position.x);
+            WriteBinaryFloat(writer, text->lines[i].position.y);
+            WriteBinaryFloat(writer, text->lines[i].spacing);
+        }
+    }
+
+    WriteBinaryProperties(writer, object->properties, object->propertiesLength);
+    WriteBinaryFloat(writer, object->aabb.x);
+    WriteBinaryFloat(writer, object->aabb.y);
+    WriteBinaryFloat(writer, object->aabb.width);
+    WriteBinaryFloat(writer, object->aabb.height);
+}
+
+void WriteBinaryTile(RaytmxBinaryWriter* writer, const TmxMap* map, const TmxTile* tile) {
+    /* Textures are given to the tiles again when read, and texture coordinates calculated again, so neither is */
+    /* written */
+    WriteBinaryU32(writer, (uint32_t)tile->gid);
+    WriteBinaryFloat(writer, tile->sourceRect.x);
+    WriteBinaryFloat(writer, tile->sourceRect.y);
+    WriteBinaryFloat(writer, tile->sourceRect.width);
+    WriteBinaryFloat(writer, tile->sourceRect.height);
+    WriteBinaryFloat(writer, tile->offset.x);
+    WriteBinaryFloat(writer, tile->offset.y);
+    WriteBinaryBool(writer, tile->hasAnimation);
+    if (tile->hasAnimation) {
+        /* An animation shares the frames of the tileset tile it was defined by so it's written as the indexes of */
+        /* that tileset and tile */
+        uint32_t tilesetIndex = UINT32_MAX, tileIndex = UINT32_MAX;
+        for (uint32_t i = 0; i < map->tilesetsLength && tileIndex == UINT32_MAX; i++) {
+            for (uint32_t j = 0; j < map->tilesets[i].tilesLength && tile->animation.frames != NULL; j++) {
+                if (map->tilesets[i].tiles[j].animation.frames == tile->animation.frames) {
+                    tilesetIndex = i;
+                    tileIndex = j;
+                    break;
+                }
+            }
+        }
+        WriteBinaryU32(writer, tilesetIndex);
+        WriteBinaryU32(writer, tileIndex);
+    }
+    WriteBinaryU32(writer, tile->frameIndex);
+    WriteBinaryFloat(writer, tile->frameTime);
+}
+
+void WriteBinaryImage(RaytmxBinaryWriter* writer, const TmxImage* image) {
+    WriteBinaryString(writer, image->source);
+    /* The path is saved relative to the binary map so the two can be moved together, and so the bytes written don't */
+    /* depend on the working directory */
+    char* relativePath = image->path != NULL ? GetRelativePath(image->path, writer->directory) : NULL;
+    WriteBinaryString(writer, relativePath);
+    MemFree(relativePath);
+    WriteBinaryColor(writer, image->trans);
+    WriteBinaryBool(writer, image->hasTrans);
+    WriteBinaryU32(writer, image->width);
+    WriteBinaryU32(writer, image->height);
+}
+
+void WriteBinaryAnimation(RaytmxBinaryWriter* writer, const TmxAnimation* animation) {
+    uint32_t framesLength = animation->frames != NULL ? animation->framesLength : 0;
+    WriteBinaryU32(writer, framesLength);
+    for (uint32_t i = 0; i < framesLength; i++) {
+        WriteBinaryU32(writer, animation->frames[i].id);
+        WriteBinaryFloat(writer, animation->frames[i].duration);
+    }
+    WriteBinaryBool(writer, framesLength > 0 && animation->frameEnds != NULL);
+    for (uint32_t i = 0; i < framesLength && animation->frameEnds != NULL; i++)
+        WriteBinaryDouble(writer, animation->frameEnds[i]);
+}
+
+void WriteBinaryProperties(RaytmxBinaryWriter* writer, const TmxProperty* properties, uint32_t propertiesLength) {
+    WriteBinaryU32(writer, properties != NULL ? propertiesLength : 0);
+    for (uint32_t i = 0; properties != NULL && i < propertiesLength; i++) {
+        WriteBinaryU32(writer, (uint32_t)properties[i].type);
+        WriteBinaryString(writer, properties[i].name);
+        WriteBinaryString(writer, properties[i].stringValue);
+        WriteBinaryU32(writer, (uint32_t)properties[i].intValue);
+        WriteBinaryFloat(writer, properties[i].floatValue);
+        WriteBinaryBool(writer, properties[i].boolValue);
+        WriteBinaryColor(writer, properties[i].colorValue);
+    }
+}
+
+void WriteBinaryString(RaytmxBinaryWriter* writer, const char* str) {
+    /* Strings are prefixed with their lengths plus one, leaving zero to mean NULL, and aren't null-terminated */
+    if (str == NULL) {
+        WriteBinaryU32(writer, 0);
+        return;
+    }
+    size_t length = strlen(str);
+    WriteBinaryU32(writer, (uint32_t)length + 1);
+    WriteBinaryBytes(writer, str, length);
+}
+
+void WriteBinaryU32s(RaytmxBinaryWriter* writer, const uint32_t* values, uint32_t valuesLength) {
+    if (IsLittleEndian()) /* If the values are already laid out as they're to be written */
+        WriteBinaryBytes(writer, values, sizeof(uint32_t) * valuesLength);
+    else {
+        for (uint32_t i = 0; i < valuesLength; i++)
+            WriteBinaryU32(writer, values[i]);
+    }
+}
+
+void WriteBinaryU32(RaytmxBinaryWriter* writer, uint32_t value) {
+    unsigned char bytes[4];
+    for (uint32_t i = 0; i < 4; i++)
+        bytes[i] = (unsigned char)(value >> (8 * i));
+    WriteBinaryBytes(writer, bytes, 4);
+}
+
+void WriteBinaryU64(RaytmxBinaryWriter* writer, uint64_t value) {
+    unsigned char bytes[8];
+    for (uint32_t i = 0; i < 8; i++)
+        bytes[i] = (unsigned char)(value >> (8 * i));
+    WriteBinaryBytes(writer, bytes, 8);
+}
+
+void WriteBinaryFloat(RaytmxBinaryWriter* writer, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(uint32_t));
+    WriteBinaryU32(writer, bits);
+}
+
+void WriteBinaryDouble(RaytmxBinaryWriter* writer, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(uint64_t));
+    WriteBinaryU64(writer, bits);
+}
+
+void WriteBinaryBool(RaytmxBinaryWriter* writer, bool value) {
+    unsigned char byte = value ? 1 : 0;
+    WriteBinaryBytes(writer, &byte, 1);
+}
+
+void WriteBinaryColor(RaytmxBinaryWriter* writer, Color value) {
+    unsigned char bytes[4] = { value.r, value.g, value.b, value.a };
+    WriteBinaryBytes(writer, bytes, 4);
+}
+
+void WriteBinaryBytes(RaytmxBinaryWriter* writer, const void* bytes, size_t bytesLength) {
+    if (writer->length + bytesLength > writer->capacity) { /* If the buffer must grow, at least double it */
+        size_t capacity = writer->capacity > 0 ? writer->capacity * 2 : 65536;
+        while (capacity < writer->length + bytesLength)
+            capacity *= 2;
+        writer->data = (unsigned char*)MemRealloc(writer->data, (unsigned int)capacity);
+        writer->capacity = capacity;
+    }
+    if (bytesLength > 0)
+        memcpy(writer->data + writer->length, bytes, bytesLength);
+    writer->length += bytesLength;
+}
+
+void ReadBinaryMap(RaytmxBinaryReader* reader, TmxMap* map) {
+    /* Arrays are attached to the map as soon as they're allocated, and their lengths set, so that the map can be */
+    /* unloaded at any point. Once the reader is invalid, every read returns zero and so every array is empty. */
+    map->fileName = ReadBinaryString(reader);
+    map->orientation = (TmxOrientation)ReadBinaryU32(reader);
+    map->renderOrder = (TmxRenderOrder)ReadBinaryU32(reader);
+    map->width = ReadBinaryU32(reader);
+    map->height = ReadBinaryU32(reader);
+    map->tileWidth = ReadBinaryU32(reader);
+    map->tileHeight = ReadBinaryU32(reader);
+    map->parallaxOriginX = (int32_t)ReadBinaryU32(reader);
+    map->parallaxOriginY = (int32_t)ReadBinaryU32(reader);
+    map->backgroundColor = ReadBinaryColor(reader);
+    map->hasBackgroundColor = ReadBinaryBool(reader);
+    map->properties = ReadBinaryProperties(reader, &map->propertiesLength);
+
+    uint32_t tilesetsLength = ReadBinaryLength(reader, 65);
+    if (tilesetsLength > 0) {
+        map->tilesets = (TmxTileset*)MemAllocZero(sizeof(TmxTileset) * tilesetsLength);
+        map->tilesetsLength = tilesetsLength;
+    }
+    for (uint32_t i = 0; i < tilesetsLength; i++)
+        ReadBinaryTileset(reader, &map->tilesets[i]);
+    ReadBinaryLayers(reader, map, &map->layers, &map->layersLength, 0);
+
+    uint32_t gidsToTilesLength = ReadBinaryLength(reader, 37);
+    if (gidsToTilesLength > 0) {
+        map->gidsToTiles = (TmxTile*)MemAllocZero(sizeof(TmxTile) * gidsToTilesLength);
+        map->gidsToTilesLength = gidsToTilesLength;
+    }
+    for (uint32_t gid = 0; gid < gidsToTilesLength; gid++)
+        ReadBinaryTile(reader, map, &map->gidsToTiles[gid]);
+    if (ReadBinaryBool(reader)) {
+        map->displayGids = (int32_t*)ReadBinaryU32s(reader, gidsToTilesLength);
+        for (uint32_t gid = 0; map->displayGids != NULL && gid < gidsToTilesLength; gid++) {
+            if (map->displayGids[gid] < 0 || (uint32_t)map->displayGids[gid] >= gidsToTilesLength)
+                reader->isValid = false;
+        }
+    }
+    if (gidsToTilesLength > 0 && map->displayGids == NULL) /* If there are tiles but nothing to say which to draw */
+        reader->isValid = false;
+    uint32_t animatedGidsLength = ReadBinaryLength(reader, sizeof(uint32_t));
+    map->animatedGids = ReadBinaryU32s(reader, animatedGidsLength);
+    if (map->animatedGids != NULL)
+        map->animatedGidsLength = animatedGidsLength;
+    for (uint32_t i = 0; i < map->animatedGidsLength; i++) {
+        if (map->animatedGids[i] >= gidsToTilesLength || map->displayGids == NULL)
+            reader->isValid = false;
+    }
+    map->animationTime = ReadBinaryDouble(reader);
+    map->tileBounds.x = ReadBinaryFloat(reader);
+    map->tileBounds.y = ReadBinaryFloat(reader);
+    map->tileBounds.width = ReadBinaryFloat(reader);
+    map->tileBounds.height = ReadBinaryFloat(reader);
+}
+
+void ReadBinaryTileset(RaytmxBinaryReader* reader, TmxTileset* tileset) {
+    tileset->firstGid = (int32_t)ReadBinaryU32(reader);
+    tileset->lastGid = (int32_t)ReadBinaryU32(reader);
+    tileset->source = ReadBinaryString(reader);
+    tileset->name = ReadBinaryString(reader);
+    tileset->classString = ReadBinaryString(reader);
+    tileset->tileWidth = ReadBinaryU32(reader);
+    tileset->tileHeight = ReadBinaryU32(reader);
+    tileset->spacing = ReadBinaryU32(reader);
+    tileset->margin = ReadBinaryU32(reader);
+    tileset->tileCount = ReadBinaryU32(reader);
+    tileset->columns = ReadBinaryU32(reader);
+    tileset->objectAlignment = (TmxObjectAlignment)ReadBinaryU32(reader);
+    tileset->tileOffsetX = (int32_t)ReadBinaryU32(reader);
+    tileset->tileOffsetY = (int32_t)ReadBinaryU32(reader);
+    tileset->hasImage = ReadBinaryBool(reader);
+    if (tileset->hasImage)
+        ReadBinaryImage(reader, &tileset->image);
+    tileset->properties = ReadBinaryProperties(reader, &tileset->propertiesLength);
+
+    uint32_t tilesLength = ReadBinaryLength(reader, 26);
+    if (tilesLength > 0) {
+        tileset->tiles = (TmxTilesetTile*)MemAllocZero(sizeof(TmxTilesetTile) * tilesLength);
+        tileset->tilesLength = tilesLength;
+    }
+    for (uint32_t i = 0; i < tilesLength; i++) {
+        TmxTilesetTile* tile = &tileset->tiles[i];
+        tile->id = ReadBinaryU32(reader);
+        tile->x = (int32_t)ReadBinaryU32(reader);
+        tile->y = (int32_t)ReadBinaryU32(reader);
+        tile->width = ReadBinaryU32(reader);
+        tile->height = ReadBinaryU32(reader);
+        tile->hasImage = ReadBinaryBool(reader);
+        if (tile->hasImage)
+            ReadBinaryImage(reader, &tile->image);
+        tile->hasAnimation = ReadBinaryBool(reader);
+        if (tile->hasAnimation)
+            ReadBinaryAnimation(reader, &tile->animation);
+        tile->properties = ReadBinaryProperties(reader, &tile->propertiesLength);
+    }
+}
+
+void ReadBinaryLayers(RaytmxBinaryReader* reader, const TmxMap* map, TmxLayer** layers, uint32_t* layersLength,
+        uint32_t depth) {
+    uint32_t length = ReadBinaryLength(reader, 62);
+    if (length == 0)
+        return;
+    if (depth >= TMX_BINARY_MAX_DEPTH) { /* If the layers are nested deeper than any sensible map would nest them */
+        reader->isValid = false;
+        return;
+    }
+
+    *layers = (TmxLayer*)MemAllocZero(sizeof(TmxLayer) * length);
+    *layersLength = length;
+    for (uint32_t i = 0; i < length; i++) {
+        TmxLayer* layer = &(*layers)[i];
+        uint32_t type = ReadBinaryU32(reader);
+        if (type > LAYER_TYPE_GROUP) { /* If the type is unknown, the layer is left as an empty tile layer */
+            reader->isValid = false;
+            return;
+        }
+        layer->type = (TmxLayerType)type;
+        layer->id = ReadBinaryU32(reader);
+        layer->name = ReadBinaryString(reader);
+        layer->classString = ReadBinaryString(reader);
+        layer->visible = ReadBinaryBool(reader);
+        layer->opacity = ReadBinaryDouble(reader);
+        layer->tintColor = ReadBinaryColor(reader);
+        layer->hasTintColor = ReadBinaryBool(reader);
+        layer->offsetX = (int32_t)ReadBinaryU32(reader);
+        layer->offsetY = (int32_t)ReadBinaryU32(reader);
+        layer->parallaxX = ReadBinaryDouble(reader);
+        layer->parallaxY = ReadBinaryDouble(reader);
+        layer->properties = ReadBinaryProperties(reader, &layer->propertiesLength);
+
+        switch (layer->type) {
+        case LAYER_TYPE_TILE_LAYER: {
+            TmxTileLayer* tileLayer = &layer->exact.tileLayer;
+            tileLayer->width = ReadBinaryU32(reader);
+            tileLayer->height = ReadBinaryU32(reader);
+            tileLayer->encoding = ReadBinaryString(reader);
+            tileLayer->compression = ReadBinaryString(reader);
+            uint32_t tilesLength = ReadBinaryLength(reader, sizeof(uint32_t));
+            tileLayer->tiles = ReadBinaryU32s(reader, tilesLength);
+            if (tileLayer->tiles != NULL)
+                tileLayer->tilesLength = tilesLength;
+            if (tileLayer->tilesLength > 0 && map->width > 0 && map->height > 0) {
+                /* Divide the tile layer into chunks just as LoadTMX() does. A layer always has more tiles than */
+                /* chunks so, if it doesn't, the map's dimensions are corrupt and would make for a huge allocation. */
+                uint32_t chunksWidth = (map->width + RAYTMX_CHUNK_SIZE - 1) / RAYTMX_CHUNK_SIZE;
+                uint32_t chunksHeight = (map->height + RAYTMX_CHUNK_SIZE - 1) / RAYTMX_CHUNK_SIZE;
+                if ((uint64_t)chunksWidth * chunksHeight > tileLayer->tilesLength) {
+                    reader->isValid = false;
+                    return;
+                }
+                tileLayer->chunksWidth = chunksWidth;
+                tileLayer->chunksHeight = chunksHeight;
+                tileLayer->chunks = (TmxTileChunk*)MemAllocZero(sizeof(TmxTileChunk) * chunksWidth * chunksHeight);
+            }
+        } break;
+        case LAYER_TYPE_OBJECT_GROUP: {
+            TmxObjectGroup* objectGroup = &layer->exact.objectGroup;
+            objectGroup->color = ReadBinaryColor(reader);
+            objectGroup->hasColor = ReadBinaryBool(reader);
+            objectGroup->drawOrder = (TmxObjectGroupDrawOrder)ReadBinaryU32(reader);
+            uint32_t objectsLength = ReadBinaryLength(reader, 94);
+            if (objectsLength > 0) {
+                objectGroup->objects = (TmxObject*)MemAllocZero(sizeof(TmxObject) * objectsLength);
+                objectGroup->objectsLength = objectsLength;
+            }
+            for (uint32_t j = 0; j < objectsLength; j++)
+                ReadBinaryObject(reader, &objectGroup->objects[j]);
+            if (ReadBinaryBool(reader)) {
+                objectGroup->ySortedObjects = ReadBinaryU32s(reader, objectsLength);
+                for (uint32_t j = 0; objectGroup->ySortedObjects != NULL && j < objectsLength; j++) {
+                    if (objectGroup->ySortedObjects[j] >= objectsLength)
+                        reader->isValid = false;
+                }
+            }
+        } break;
+        case LAYER_TYPE_IMAGE_LAYER:
+            layer->exact.imageLayer.repeatX = ReadBinaryBool(reader);
+            layer->exact.imageLayer.repeatY = ReadBinaryBool(reader);
+            layer->exact.imageLayer.hasImage = ReadBinaryBool(reader);
+            if (layer->exact.imageLayer.hasImage)
+                ReadBinaryImage(reader, &layer->exact.imageLayer.image);
+        break;
+        case LAYER_TYPE_GROUP: break; /* Nothing but child layers, which every layer type is followed by */
+        }
+        ReadBinaryLayers(reader, map, &layer->layers, &layer->layersLength, depth + 1);
+    }
+}
+
+void ReadBinaryObject(RaytmxBinaryReader* reader, TmxObject* object) {
+    object->type = (TmxObjectType)ReadBinaryU32(reader);
+    object->id = ReadBinaryU32(reader);
+    object->name = ReadBinaryString(reader);
+    object->typeString = ReadBinaryString(reader);
+    object->x = ReadBinaryDouble(reader);
+    object->y = ReadBinaryDouble(reader);
+    object->width = ReadBinaryDouble(reader);
+    object->height = ReadBinaryDouble(reader);
+    object->rotation = ReadBinaryDouble(reader);
+    object->gid = (int32_t)ReadBinaryU32(reader);
+    object->visible = ReadBinaryBool(reader);
+    object->templateString = ReadBinaryString(reader);
+
+    uint32_t pointsLength = ReadBinaryLength(reader, 2 * sizeof(float));
+    if (pointsLength > 0) {
+        object->points = (Vector2*)MemAlloc(sizeof(Vector2) * pointsLength);
+        object->offsetPoints = (Vector2*)MemAlloc(sizeof(Vector2) * pointsLength);
+        object->pointsLength = pointsLength;
+        for (uint32_t i = 0; i < pointsLength; i++) {
+            object->points[i].x = ReadBinaryFloat(reader);
+            object->points[i].y = ReadBinaryFloat(reader);
+        }
+        memcpy(object->offsetPoints, object->points, sizeof(Vector2) * pointsLength);
+    }
+
+    if (ReadBinaryBool(reader)) {
+        TmxText* text = (TmxText*)MemAllocZero(sizeof(TmxText));
+        object->text = text;
+        text->fontFamily = ReadBinaryString(reader);
+        text->pixelSize = ReadBinaryU32(reader);
+        text->wrap = ReadBinaryBool(reader);
+        text->color = ReadBinaryColor(reader);
+        text->bold = ReadBinaryBool(reader);
+        text->italic = ReadBinaryBool(reader);
+        text->underline = ReadBinaryBool(reader);
+        text->strikeOut = ReadBinaryBool(reader);
+        text->kerning = ReadBinaryBool(reader);
+        text->halign = (TmxHorizontalAlignment)ReadBinaryU32(reader);
+        text->valign = (TmxVerticalAlignment)ReadBinaryU32(reader);
+        text->content = ReadBinaryString(reader);
+        uint32_t linesLength = ReadBinaryLength(reader, 16);
+        if (linesLength > 0) {
+            text->lines = (TmxTextLine*)MemAllocZero(sizeof(TmxTextLine) * linesLength);
+            text->linesLength = linesLength;
+        }
+        for (uint32_t i = 0; i < linesLength; i++) {
+            TmxTextLine* line = &text->lines[i];
+            line->content = ReadBinaryString(reader);
+            line->position.x = ReadBinaryFloat(reader);
+            line->position.y = ReadBinaryFloat(reader);
+            line->spacing = ReadBinaryFloat(reader);
+            if (!(tmxLoadFlags & LOAD_HEADLESS)) /* raylib's default font is a texture so headless maps go without */
+                line->font = GetFontDefault();
+        }
+    }
+
+    object->properties = ReadBinaryProperties(reader, &object->propertiesLength);
+    object->aabb.x = ReadBinaryFloat(reader);
+    object->aabb.y = ReadBinaryFloat(reader);
+    object->aabb.width = ReadBinaryFloat(reader);
+    object->aabb.height = ReadBinaryFloat(reader);
+}
+
+void ReadBinaryTile(RaytmxBinaryReader* reader, const TmxMap* map, TmxTile* tile) {
+    tile->gid = (int32_t)ReadBinaryU32(reader);
+    tile->sourceRect.x = ReadBinaryFloat(reader);
+    tile->sourceRect.y = ReadBinaryFloat(reader);
+    tile->sourceRect.width = ReadBinaryFloat(reader);
+    tile->sourceRect.height = ReadBinaryFloat(reader);
+    tile->offset.x = ReadBinaryFloat(reader);
+    tile->offset.y = ReadBinaryFloat(reader);
+    tile->hasAnimation = ReadBinaryBool(reader);
+    if (tile->hasAnimation) { /* If the tile shares the animation of a tileset tile */
+        uint32_t tilesetIndex = ReadBinaryU32(reader), tileIndex = ReadBinaryU32(reader);
+        if (tilesetIndex < map->tilesetsLength && tileIndex < map->tilesets[tilesetIndex].tilesLength)
+            tile->animation = map->tilesets[tilesetIndex].tiles[tileIndex].animation;
+        else if (tilesetIndex != UINT32_MAX || tileIndex != UINT32_MAX)
+            reader->isValid = false;
+    }
+    tile->frameIndex = ReadBinaryU32(reader);
+    tile->frameTime = ReadBinaryFloat(reader);
+    if (tile->animation.framesLength > 0 && tile->frameIndex >= tile->animation.framesLength)
+        reader->isValid = false;
+}
+
+void ReadBinaryImage(RaytmxBinaryReader* reader, TmxImage* image) {
+    image->source = ReadBinaryString(reader);
+    image->path = ReadBinaryString(reader);
+    if (image->path != NULL && !IsPathAbsolute(image->path)) { /* If saved relative to the binary map, as most are */
+        char path[TMX_PATH_LENGTH];
+        JoinPath(reader->directory, image->path, path, sizeof(path));
+        MemFree(image->path);
+        image->path = CopyString(path);
+    }
+    image->trans = ReadBinaryColor(reader);
+    image->hasTrans = ReadBinaryBool(reader);
+    image->width = ReadBinaryU32(reader);
+    image->height = ReadBinaryU32(reader);
+}
+
+void ReadBinaryAnimation(RaytmxBinaryReader* reader, TmxAnimation* animation) {
+    uint32_t framesLength = ReadBinaryLength(reader, sizeof(uint32_t) + sizeof(float));
+    if (framesLength > 0) {
+        animation->frames = (TmxAnimationFrame*)MemAllocZero(sizeof(TmxAnimationFrame) * framesLength);
+        animation->framesLength = framesLength;
+    }
+    for (uint32_t i = 0; i < framesLength; i++) {
+        animation->frames[i].id = ReadBinaryU32(reader);
+        animation->frames[i].duration = ReadBinaryFloat(reader);
+    }
+    if (ReadBinaryBool(reader) && framesLength > 0) {
+        animation->frameEnds = (double*)MemAllocZero(sizeof(double) * framesLength);
+        for (uint32_t i = 0; i < framesLength; i++)
+            animation->frameEnds[i] = ReadBinaryDouble(reader);
+    }
+}
+
+TmxProperty* ReadBinaryProperties(RaytmxBinaryReader* reader, uint32_t* propertiesLength) {
+    uint32_t length = ReadBinaryLength(reader, 25);
+    if (length == 0)
+        return NULL;
+
+    TmxProperty* properties = (TmxProperty*)MemAllocZero(sizeof(TmxProperty) * length);
+    *propertiesLength = length;
+    for (uint32_t i = 0; i < length; i++) {
+        properties[i].type = (TmxPropertyType)ReadBinaryU32(reader);
+        properties[i].name = ReadBinaryString(reader);
+        properties[i].stringValue = ReadBinaryString(reader);
+        properties[i].intValue = (int32_t)ReadBinaryU32(reader);
+        properties[i].floatValue = ReadBinaryFloat(reader);
+        properties[i].boolValue = ReadBinaryBool(reader);
+        properties[i].colorValue = ReadBinaryColor(reader);
+    }
+    return properties;
+}
+
+char* ReadBinaryString(RaytmxBinaryReader* reader) {
+    uint32_t lengthPlusOne = ReadBinaryU32(reader);
+    if (lengthPlusOne == 0) /* If the string is NULL */
+        return NULL;
+
+    const unsigned char* bytes = ReadBinaryBytes(reader, lengthPlusOne - 1);
+    if (bytes == NULL)
+        return NULL;
+    char* str = (char*)MemAlloc(lengthPlusOne);
+    memcpy(str, bytes, lengthPlusOne - 1);
+    str[lengthPlusOne - 1] = '\0';
+    return str;
+}
+
+uint32_t* ReadBinaryU32s(RaytmxBinaryReader* reader, uint32_t valuesLength) {
+    const unsigned char* bytes = ReadBinaryBytes(reader, sizeof(uint32_t) * (size_t)valuesLength);
+    if (bytes == NULL || valuesLength == 0)
+        return NULL;
+
+    /* This is where the bulk of a map, its GIDs, is read so values laid out as the host expects are copied at once */
+    uint32_t* values = (uint32_t*)MemAlloc((unsigned int)(sizeof(uint32_t) * valuesLength));
+    if (IsLittleEndian())
+        memcpy(values, bytes, sizeof(uint32_t) * valuesLength);
+    else {
+        for (uint32_t i = 0; i < valuesLength; i++) {
+            const unsigned char* value = bytes + sizeof(uint32_t) * i;
+            values[i] = (uint32_t)value[0] | ((uint32_t)value[1] << 8) | ((uint32_t)value[2] << 16) |
+                ((uint32_t)value[3] << 24);
+        }
+    }
+    return values;
+}
+
+uint32_t ReadBinaryLength(RaytmxBinaryReader* reader, size_t minElementSize) {
+    /* Every element takes at least a few bytes so a length claiming more elements than the remaining bytes could */
+    /* possibly hold is corrupt. Checking this first keeps corrupt lengths from causing huge allocations. */
+    uint32_t length = ReadBinaryU32(reader);
+    if (reader->isValid && (uint64_t)length * minElementSize > reader->length - reader->offset) {
+        reader->isValid = false;
+        return 0;
+    }
+    return reader->isValid ? length : 0;
+}
+
+uint32_t ReadBinaryU32(RaytmxBinaryReader* reader) {
+    const unsigned char* bytes = ReadBinaryBytes(reader, 4);
+    if (bytes == NULL)
+        return 0;
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+uint64_t ReadBinaryU64(RaytmxBinaryReader* reader) {
+    const unsigned char* bytes = ReadBinaryBytes(reader, 8);
+    if (bytes == NULL)
+        return 0;
+    uint64_t value = 0;
+    for (uint32_t i = 0; i < 8; i++)
+        value |= (uint64_t)bytes[i] << (8 * i);
+    return value;
+}
+
+float ReadBinaryFloat(RaytmxBinaryReader* reader) {
+    uint32_t bits = ReadBinaryU32(reader);
+    float value;
+    memcpy(&value, &bits, sizeof(float));
+    return value;
+}
+
+double ReadBinaryDouble(RaytmxBinaryReader* reader) {
+    uint64_t bits = ReadBinaryU64(reader);
+    double value;
+    memcpy(&value, &bits, sizeof(double));
+    return value;
+}
+
+bool ReadBinaryBool(RaytmxBinaryReader* reader) {
+    const unsigned char* byte = ReadBinaryBytes(reader, 1);
+    return byte != NULL && *byte != 0;
+}
+
+Color ReadBinaryColor(RaytmxBinaryReader* reader) {
+    Color color = { 0, 0, 0, 0 };
+    const unsigned char* bytes = ReadBinaryBytes(reader, 4);
+    if (bytes != NULL) {
+        color.r = bytes[0];
+        color.g = bytes[1];
+        color.b = bytes[2];
+        color.a = bytes[3];
+    }
+    return color;
+}
+
+const unsigned char* ReadBinaryBytes(RaytmxBinaryReader* reader, size_t bytesLength) {
+    if (!reader->isValid || bytesLength > reader->length - reader->offset) { /* If reading past the end */
+        reader->isValid = false;
+        return NULL;
+    }
+    const unsigned char* bytes = reader->data + reader->offset;
+    reader->offset += bytesLength;
+    return bytes;
+}
+
+bool IsLittleEndian(void) {
+    const uint16_t value = 1;
+    return *(const unsigned char*)&value == 1;
+}
+
+void DecodeTileLayers(RaytmxState* raytmxState) {
+    if (raytmxState->layerDataRoot == NULL) /* If there's no Base64 or CSV layer data to decode */
+        return;
+
+    /* Queue the data largest first so that a thread isn't left decoding a large layer after the rest are done */
+    RaytmxLayerDataQueue queue;
+    queue.nodes = (RaytmxLayerDataNode**)MemAlloc(sizeof(RaytmxLayerDataNode*) * raytmxState->layerDataLength);
+    queue.nodesLength = 0;
+    queue.nextNode = 0;
+    queue.task = raytmxState->task;
+    size_t contentLength = 0;
+    for (RaytmxLayerDataNode* node = raytmxState->layerDataRoot; node != NULL; node = node->next) {
+        queue.nodes[queue.nodesLength++] = node;
+        contentLength += node->contentLength;
+    }
+    if (queue.task != NULL)
+        TMX_ATOMIC_STORE(&queue.task->layersTotal, queue.nodesLength);
+    qsort(queue.nodes, queue.nodesLength, sizeof(RaytmxLayerDataNode*), CompareLayerDataSizes);
+
+    /* Use as many threads as are wanted, up to one per layer, to take data from the queue until it's empty */
+    uint32_t threadsLength = GetLoadThreadsLength();
+    if (threadsLength > queue.nodesLength)
+        threadsLength = queue.nodesLength;
+    if (contentLength < TMX_THREADS_MIN_CONTENT) /* If there's so little data that starting threads would cost more */
+        threadsLength = 1;
+    RaytmxThreadWork work;
+    work.run = RunLayerDataQueue;
+    work.queue = &queue;
+    RunOnLoadThreads(&work, threadsLength);
+    MemFree(queue.nodes);
+
+    /* With every thread finished, report any errors and hand the GIDs to the layers in the document's order */
+    for (RaytmxLayerDataNode* node = raytmxState->layerDataRoot; node != NULL; node = node->next) {
+        LogLayerDataErrors(node);
+        SetTileLayerTiles(node->layer, &node->tiles);
+        if (node->isContentCopied)
+            MemFree((void*)node->content);
+        node->content = NULL;
+    }
+    raytmxState->layerDataRoot = NULL;
+    raytmxState->layerDataTail = NULL;
+    raytmxState->layerDataLength = 0;
+}
+
+uint32_t GetLoadThreadsLength(void) {
+#ifdef TMX_THREADS
+    long threadsLength = tmxLoadThreads;
+    if (threadsLength == 0) { /* If the number of threads is to match the number of processors */
+    #if defined(TMX_THREADS_PTHREADS)
+        threadsLength = sysconf(_SC_NPROCESSORS_ONLN);
+    #elif defined(TMX_THREADS_WIN32)
+        threadsLength = (long)GetActiveProcessorCount(0xFFFF /* ALL_PROCESSOR_GROUPS */);
+    #endif
+    }
+    if (threadsLength < 1)
+        return 1;
+    return threadsLength > TMX_MAX_THREADS ? TMX_MAX_THREADS : (uint32_t)threadsLength;
+#else
+    return 1;
+#endif
+}
+
+void RunOnLoadThreads(RaytmxThreadWork* work, uint32_t threadsLength) {
+    /* Start threads, in addition to this one, that each run the work. This thread runs the work as well. Should a */
+    /* thread fail to start, the others take on its share. */
+#if defined(TMX_THREADS_PTHREADS)
+    pthread_t threads[TMX_MAX_THREADS];
+#elif defined(TMX_THREADS_WIN32)
+    uintptr_t threads[TMX_MAX_THREADS];
+#endif
+    uint32_t threadsStarted = 0;
+#if defined(TMX_THREADS_PTHREADS)
+    for (; threadsStarted + 1 < threadsLength; threadsStarted++) {
+        if (pthread_create(&threads[threadsStarted], NULL, RunLoadThread, work) != 0)
+            break;
+    }
+#elif defined(TMX_THREADS_WIN32)
+    for (; threadsStarted + 1 < threadsLength; threadsStarted++) {
+        threads[threadsStarted] = _beginthreadex(NULL, 0, RunLoadThread, work, 0, NULL);
+        if (threads[threadsStarted] == 0)
+            break;
+    }
+#else
+    (void)threadsLength;
+#endif
+    work->run(work->queue);
+    for (uint32_t i = 0; i < threadsStarted; i++) {
+#if defined(TMX_THREADS_PTHREADS)
+        pthread_join(threads[i], NULL);
+#elif defined(TMX_THREADS_WIN32)
+        WaitForSingleObject((void*)threads[i], 0xFFFFFFFF /* INFINITE */);
+        CloseHandle((void*)threads[i]);
+#endif
+    }
+}
+
+#if defined(TMX_THREADS_PTHREADS)
+void* RunLoadThread(void* work) {
+    ((RaytmxThreadWork*)work)->run(((RaytmxThreadWork*)work)->queue);
+    return NULL;
+}
+#elif defined(TMX_THREADS_WIN32)
+unsigned __stdcall RunLoadThread(void* work) {
+    ((RaytmxThreadWork*)work)->run(((RaytmxThreadWork*)work)->queue);
+    return 0;
+}
+#endif
+
+void RunLayerDataQueue(void* layerDataQueue) {
+    RaytmxLayerDataQueue* queue = (RaytmxLayerDataQueue*)layerDataQueue;
+#ifdef TMX_THREADS
+    for (uint32_t i = TMX_ATOMIC_INCREMENT(&queue->nextNode); i < queue->nodesLength;
+            i = TMX_ATOMIC_INCREMENT(&queue->nextNode)) {
+        DecodeLayerData(queue->nodes[i]);
+        if (queue->task != NULL)
+            TMX_ATOMIC_INCREMENT(&queue->task->layersDecoded);
+    }
+#else
+    for (; queue->nextNode < queue->nodesLength; queue->nextNode++) {
+        DecodeLayerData(queue->nodes[queue->nextNode]);
+        if (queue->task != NULL)
+            queue->task->layersDecoded += 1;
+    }
+#endif
+}
+
+void DecodeLayerData(RaytmxLayerDataNode* node) {
+    /* This may run on any thread so it must not log, or touch anything but the node and the layer it belongs to. */
+    /* Errors are recorded in the node and logged once every layer has been decoded. */
+    const TmxTileLayer* tileLayer = &node->layer->exact.tileLayer;
+    node->decompressResult = DECOMPRESS_SUCCESS;
+    if (strcmp(tileLayer->encoding, "base64") == 0) {
+        /* The layer's data is a series of unsigned, 32-bit integers encoded as a Base64 string. But, XML considers */
+        /* everything between <data> and </data> to be content meaning there is probably some whitespace on both */
+        /* ends of the content we need to ignore. So, find the actual start and stop: */
+        const char *encodedStart = node->content, *encodedEnd = node->content + node->contentLength;
+        while (encodedStart < encodedEnd && isspace(*encodedStart))
+            encodedStart++;
+        while (encodedEnd > encodedStart && isspace(*(encodedEnd - 1)))
+            encodedEnd--;
+
+        /* With the string of encoded Base64 data trimmed, decode it */
+        size_t encodedLength = (size_t)(encodedEnd - encodedStart);
+        size_t decodedCapacity = GetBase64DecodedLength(encodedStart, encodedLength), decodedLength = 0;
+        if (tileLayer->compression == NULL) { /* If the Base64-encoded data is uncompressed */
+            /* The decoded data is a series of little-endian, 32-bit GIDs. Decode it directly into the layer's array */
+            /* of GIDs, which was likely already sized for all of them when the <data> began. */
+            ReserveTileLayerTiles(&node->tiles, node->tiles.length + (uint32_t)((decodedCapacity + 3) / 4));
+            unsigned char* destination = (unsigned char*)(node->tiles.gids + node->tiles.length);
+            size_t destinationCapacity = sizeof(uint32_t) * (node->tiles.capacity - node->tiles.length);
+            node->isDecoded = DecodeBase64(encodedStart, encodedLength, destination, destinationCapacity,
+                &decodedLength);
+            if (node->isDecoded) /* N bytes ('decodedLength') with every four bytes being a single GID is N / 4 tiles */
+                node->tiles.length += (uint32_t)(decodedLength / 4);
+        } else { /* If the Base64-encoded data is also compressed */
+            /* Decompression needs all of the compressed data at once so decode it to a temporary buffer */
+            unsigned char* decoded = (unsigned char*)MemAlloc((unsigned int)decodedCapacity + 1);
+            node->isDecoded = DecodeBase64(encodedStart, encodedLength, decoded, decodedCapacity, &decodedLength);
+            if (node->isDecoded) { /* Decompress the data directly into the layer's array of GIDs */
+                node->decompressResult = DecompressLayerData(&node->tiles, tileLayer->compression, decoded,
+                    decodedLength);
+            }
+            MemFree(decoded);
+        }
+    } else { /* CSV */
+        /* The Comma-Separated Value (CSV) list herein is a series of Global IDs (GIDs) of tiles in the form */
+        /* "31,32,33" where 31, 32, and 33 are GIDs. Tiled also puts newlines between rows of the layer. */
+        node->isDecoded = ParseCsvGids(&node->tiles, node->content, node->contentLength, &node->errorOffset);
+        if (!node->isDecoded)
+            node->tiles.length = 0; /* Discard any GIDs parsed before the error */
+    }
+}
+
+void LogLayerDataErrors(const RaytmxLayerDataNode* node) {
+    const char* layerName = node->layer->name;
+    const char* compression = node->layer->exact.tileLayer.compression;
+    if (strcmp(node->layer->exact.tileLayer.encoding, "csv") == 0) {
+        if (node->isDecoded)
+            return;
+        /* The content ends where </data> begins so the line of the malformed character is the line the <data> */
+        /* ended on minus any newlines that follow it. Its column is counted from the newline preceding it, or from */
+        /* the start of the content if there isn't one. */
+        uint32_t line = node->line, column = (uint32_t)node->errorOffset + 1;
+        for (size_t i = node->errorOffset; i < node->contentLength; i++) {
+            if (node->content[i] == '\n')
+                line--;
+        }
+        for (size_t i = node->errorOffset; i > 0; i--) {
+            if (node->content[i - 1] == '\n') {
+                column = (uint32_t)(node->errorOffset - i) + 1;
+                break;
+            }
+        }
+        TraceLog(LOG_ERROR, "RAYTMX: Malformed CSV data for layer \"%s\": line %d, column %d", layerName, line,
+            column);
+        return;
+    }
+
+    if (!node->isDecoded) {
+        TraceLog(LOG_ERROR, "RAYTMX: Unable to decode Base64 data for layer \"%s\"", layerName);
+        return;
+    }
+    switch (node->decompressResult) {
+    case DECOMPRESS_SUCCESS: break;
+    case DECOMPRESS_BAD_HEADER:
+        TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" uses \"%s\" compression but the stream's header is invalid",
+            layerName, compression);
+        break;
+    case DECOMPRESS_BAD_CHECKSUM:
+        TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" compressed with \"%s\" cannot be parsed because the decompressed "
+            "data doesn't match the stream's checksum", layerName, compression);
+        break;
+    case DECOMPRESS_UNSUPPORTED:
+        TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" compressed with \"%s\" cannot be parsed because the stream "
+            "requires a dictionary", layerName, compression);
+        break;
+    default:
+        TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" compressed with \"%s\" cannot be parsed because decompression "
+            "failed", layerName, compression);
+        break;
+    }
+}
+
+int CompareLayerDataSizes(const void* a, const void* b) {
+    const RaytmxLayerDataNode *nodeA = *(RaytmxLayerDataNode* const*)a, *nodeB = *(RaytmxLayerDataNode* const*)b;
+    if (nodeA->contentLength != nodeB->contentLength)
+        return nodeA->contentLength > nodeB->contentLength ? -1 : 1; /* Larger content first */
+    return 0;
+}
+
+/* Values of Base64 characters where -1 is invalid, -2 is whitespace, and -3 is padding ('=') */
+static const int8_t tmxBase64Values[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -2, -2, -2, -2, -2, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -3, -1, -1,
+    -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+    -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+size_t GetBase64DecodedLength(const char* encoded, size_t encodedLength) {
+    /* Every four characters encode three bytes and each padding character at the end stands in for one less byte */
+    size_t decodedLength = (encodedLength / 4) * 3 + ((encodedLength % 4) * 3) / 4;
+    for (size_t i = 0; i < 2 && i < encodedLength && encoded[encodedLength - 1 - i] == '='; i++)
+        decodedLength -= 1;
+    return decodedLength;
+}
+
+bool DecodeBase64(const char* encoded, size_t encodedLength, unsigned char* decoded, size_t decodedCapacity,
+        size_t* decodedLength) {
+    const char* iterator = encoded;
+    const char* end = encoded + encodedLength;
+    unsigned char* output = decoded;
+    unsigned char* outputEnd = decoded + decodedCapacity;
+
+    /* Decode as much as possible with the widest SIMD available. These stop early at any character that isn't */
+    /* strictly part of the Base64 alphabet, like padding or whitespace, leaving the rest to the scalar loop below. */
+#ifdef TMX_AVX2
+    {
+        size_t decodedCharacters = DecodeBase64AVX2(iterator, (size_t)(end - iterator), output,
+            (size_t)(outputEnd - output));
+        iterator += decodedCharacters;
+        output += (decodedCharacters / 4) * 3;
+    }
+#endif
+#ifdef TMX_SSE2
+    {
+        size_t decodedCharacters = DecodeBase64SSE2(iterator, (size_t)(end - iterator), output,
+            (size_t)(outputEnd - output));
+        iterator += decodedCharacters;
+        output += (decodedCharacters / 4) * 3;
+    }
+#endif
+
+    /* Decode whatever remains, or everything without SIMD, a group of four characters at a time where possible */
+    uint32_t bits = 0; /* The most recent, not yet output, 6-bit values */
+    int bitsLength = 0;
+    while (iterator < end) {
+        if (bitsLength == 0 && end - iterator >= 4) {
+            int32_t a = tmxBase64Values[(unsigned char)iterator[0]], b = tmxBase64Values[(unsigned char)iterator[1]],
+                c = tmxBase64Values[(unsigned char)iterator[2]], d = tmxBase64Values[(unsigned char)iterator[3]];
+            if ((a | b | c | d) >= 0) { /* If all four are part of the alphabet (i.e. none are negative) */
+                if (outputEnd - output < 3)
+                    return false;
+                uint32_t group = ((uint32_t)a << 18) | ((uint32_t)b << 12) | ((uint32_t)c << 6) | (uint32_t)d;
+                output[0] = (unsigned char)(group >> 16);
+                output[1] = (unsigned char)(group >> 8);
+                output[2] = (unsigned char)group;
+                output += 3;
+                iterator += 4;
+                continue;
+            }
+        }
+
+        /* Otherwise, take one character at a time */
+        int32_t value = tmxBase64Values[(unsigned char)*iterator];
+        iterator++;
+        if (value >= 0) {
+            bits = (bits << 6) | (uint32_t)value;
+            bitsLength += 6;
+            if (bitsLength >= 8) { /* If there's a whole byte */
+                if (output == outputEnd)
+                    return false;
+                bitsLength -= 8;
+                *output = (unsigned char)(bits >> bitsLength);
+                output++;
+            }
+        } else if (value == -3) /* If padding, which can only be at the end */
+            break;
+        else if (value == -1) /* If not whitespace, which is skipped */
+            return false;
+    }
+
+    *decodedLength = (size_t)(output - decoded);
+    return true;
+}
+
+#ifdef TMX_SSE2
+size_t DecodeBase64SSE2(const char* encoded, size_t encodedLength, unsigned char* decoded, size_t decodedCapacity) {
+    /* Decode 16 characters into 12 bytes at a time. Each character is classified by the range it falls in, which */
+    /* also determines the offset that turns it into its 6-bit value. The 6-bit values are then combined into 24-bit */
+    /* values whose bytes are compacted together. Two overlapping 8-byte stores write the 12 bytes so there must be */
+    /* room for 16. */
+    const __m128i upperBias = _mm_set1_epi8((char)(-128 - 'A')), lowerBias = _mm_set1_epi8((char)(-128 - 'a'));
+    const __m128i digitBias = _mm_set1_epi8((char)(-128 - '0'));
+    const __m128i letterLimit = _mm_set1_epi8(-128 + 26), digitLimit = _mm_set1_epi8(-128 + 10);
+    const __m128i plus = _mm_set1_epi8('+'), slash = _mm_set1_epi8('/');
+    const __m128i upperOffset = _mm_set1_epi8(-'A'), lowerOffset = _mm_set1_epi8(26 - 'a');
+    const __m128i digitOffset = _mm_set1_epi8(52 - '0'), plusOffset = _mm_set1_epi8(62 - '+');
+    const __m128i slashOffset = _mm_set1_epi8(63 - '/');
+    const __m128i pairWeights = _mm_set1_epi32(0x00011000), middleBytes = _mm_set1_epi32(0x0000FF00);
+
+    size_t i = 0, o = 0;
+    for (; i + 16 <= encodedLength && o + 16 <= decodedCapacity; i += 16, o += 12) {
+        /* A range check is one signed comparison once the range is shifted to start at the lowest signed value */
+        __m128i characters = _mm_loadu_si128((const __m128i*)(encoded + i));
+        __m128i isUpper = _mm_cmplt_epi8(_mm_add_epi8(characters, upperBias), letterLimit);
+        __m128i isLower = _mm_cmplt_epi8(_mm_add_epi8(characters, lowerBias), letterLimit);
+        __m128i isDigit = _mm_cmplt_epi8(_mm_add_epi8(characters, digitBias), digitLimit);
+        __m128i isPlus = _mm_cmpeq_epi8(characters, plus), isSlash = _mm_cmpeq_epi8(characters, slash);
+        __m128i isValid = _mm_or_si128(_mm_or_si128(isUpper, isLower), _mm_or_si128(_mm_or_si128(isDigit, isPlus),
+            isSlash));
+        if (_mm_movemask_epi8(isValid) != 0xFFFF) /* If any character isn't one of the 64 */
+            break;
+
+        /* Offset each character to its 6-bit value */
+        __m128i offsets = _mm_or_si128(_mm_or_si128(_mm_and_si128(isUpper, upperOffset),
+            _mm_and_si128(isLower, lowerOffset)), _mm_or_si128(_mm_or_si128(_mm_and_si128(isDigit, digitOffset),
+            _mm_and_si128(isPlus, plusOffset)), _mm_and_si128(isSlash, slashOffset)));
+        __m128i values = _mm_add_epi8(characters, offsets);
+        /* Combine pairs of 6-bit values into 12-bit values and then pairs of those into 24-bit values, the first of */
+        /* each pair being the more significant. Shifting values out of the way, rather than masking them, keeps */
+        /* the number of constants low enough for all of them to stay in registers. */
+        __m128i pairs = _mm_or_si128(_mm_srli_epi16(_mm_slli_epi16(values, 8), 2), _mm_srli_epi16(values, 8));
+        __m128i groups = _mm_madd_epi16(pairs, pairWeights);
+        /* Reverse the order of each 24-bit value's bytes so the most significant is first in memory */
+        __m128i bytes = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(groups, 16), _mm_and_si128(groups, middleBytes)),
+            _mm_srli_epi32(_mm_slli_epi32(groups, 24), 8));
+        /* Close the gap between the two 3-byte values in each half and store both halves */
+        __m128i compacted = _mm_or_si128(_mm_srli_epi64(_mm_slli_epi64(bytes, 32), 32),
+            _mm_slli_epi64(_mm_srli_epi64(bytes, 32), 24));
+        _mm_storel_epi64((__m128i*)(decoded + o), compacted);
+        _mm_storel_epi64((__m128i*)(decoded + o + 6), _mm_unpackhi_epi64(compacted, compacted));
+    }
+
+    return i;
+}
+#endif /* TMX_SSE2 */
+
+#ifdef TMX_AVX2
+size_t DecodeBase64AVX2(const char* encoded, size_t encodedLength, unsigned char* decoded, size_t decodedCapacity) {
+    /* This is DecodeBase64SSE2() with each step widened to 32 characters. The four 8-byte stores write 24 bytes so */
+    /* there must be room for 32. AVX2 lacks a "less than" comparison so the operands are swapped instead. */
+    const __m256i upperBias = _mm256_set1_epi8((char)(-128 - 'A')), lowerBias = _mm256_set1_epi8((char)(-128 - 'a'));
+    const __m256i digitBias = _mm256_set1_epi8((char)(-128 - '0'));
+    const __m256i letterLimit = _mm256_set1_epi8(-128 + 26), digitLimit = _mm256_set1_epi8(-128 + 10);
+    const __m256i plus = _mm256_set1_epi8('+'), slash = _mm256_set1_epi8('/');
+    const __m256i upperOffset = _mm256_set1_epi8(-'A'), lowerOffset = _mm256_set1_epi8(26 - 'a');
+    const __m256i digitOffset = _mm256_set1_epi8(52 - '0'), plusOffset = _mm256_set1_epi8(62 - '+');
+    const __m256i slashOffset = _mm256_set1_epi8(63 - '/');
+    const __m256i pairWeights = _mm256_set1_epi32(0x00011000), middleBytes = _mm256_set1_epi32(0x0000FF00);
+
+    size_t i = 0, o = 0;
+    for (; i + 32 <= encodedLength && o + 32 <= decodedCapacity; i += 32, o += 24) {
+        __m256i characters = _mm256_loadu_si256((const __m256i*)(encoded + i));
+        __m256i isUpper = _mm256_cmpgt_epi8(letterLimit, _mm256_add_epi8(characters, upperBias));
+        __m256i isLower = _mm256_cmpgt_epi8(letterLimit, _mm256_add_epi8(characters, lowerBias));
+        __m256i isDigit = _mm256_cmpgt_epi8(digitLimit, _mm256_add_epi8(characters, digitBias));
+        __m256i isPlus = _mm256_cmpeq_epi8(characters, plus), isSlash = _mm256_cmpeq_epi8(characters, slash);
+        __m256i isValid = _mm256_or_si256(_mm256_or_si256(isUpper, isLower),
+            _mm256_or_si256(_mm256_or_si256(isDigit, isPlus), isSlash));
+        if (_mm256_movemask_epi8(isValid) != -1) /* If any character isn't one of the 64 */
+            break;
+
+        __m256i offsets = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(isUpper, upperOffset),
+            _mm256_and_si256(isLower, lowerOffset)), _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(isDigit,
+            digitOffset), _mm256_and_si256(isPlus, plusOffset)), _mm256_and_si256(isSlash, slashOffset)));
+        __m256i values = _mm256_add_epi8(characters, offsets);
+        __m256i pairs = _mm256_or_si256(_mm256_srli_epi16(_mm256_slli_epi16(values, 8), 2),
+            _mm256_srli_epi16(values, 8));
+        __m256i groups = _mm256_madd_epi16(pairs, pairWeights);
+        __m256i bytes = _mm256_or_si256(_mm256_or_si256(_mm256_srli_epi32(groups, 16),
+            _mm256_and_si256(groups, middleBytes)), _mm256_srli_epi32(_mm256_slli_epi32(groups, 24), 8));
+        __m256i compacted = _mm256_or_si256(_mm256_srli_epi64(_mm256_slli_epi64(bytes, 32), 32),
+            _mm256_slli_epi64(_mm256_srli_epi64(bytes, 32), 24));
+        __m128i low = _mm256_castsi256_si128(compacted), high = _mm256_extracti128_si256(compacted, 1);
+        _mm_storel_epi64((__m128i*)(decoded + o), low);
+        _mm_storel_epi64((__m128i*)(decoded + o + 6), _mm_unpackhi_epi64(low, low));
+        _mm_storel_epi64((__m128i*)(decoded + o + 12), high);
+        _mm_storel_epi64((__m128i*)(decoded + o + 18), _mm_unpackhi_epi64(high, high));
+    }
+
+    return i;
+}
+#endif /* TMX_AVX2 */
+
+bool ParseCsvGids(RaytmxLayerTiles* layerTiles, const char* csv, size_t csvLength, size_t* errorOffset) {
+    const char* iterator = csv;
+    const char* end = csv + csvLength;
+    bool isValueExpected = true; /* Whether the next token must be a value, as at the start and after each comma */
+
+    /* Classify up to 64 characters at a time into bit masks, one bit per character, then walk the masks' set bits */
+    /* to visit each token in order. A window never begins partway through a value because a value that runs to */
+    /* the end of a window is parsed to its end and the next window begins after it. */
+    while (iterator < end) {
+        uint32_t windowLength = end - iterator >= 64 ? 64 : (uint32_t)(end - iterator);
+        uint64_t digits, commas;
+        uint64_t invalid = GetCsvWindowMasks(iterator, windowLength, &digits, &commas);
+        uint64_t starts = digits & ~(digits << 1); /* The first digit of each value */
+        uint64_t tokens = starts | commas;
+        const char* next = iterator + windowLength;
+        if (invalid != 0) /* Only tokens before the first invalid character are considered */
+            tokens &= (invalid & (~invalid + 1)) - 1;
+
+        while (tokens != 0) {
+            uint32_t position = CountTrailingZeros64(tokens);
+            tokens &= tokens - 1;
+            if ((commas >> position) & 1) {
+                if (isValueExpected) { /* If there was no value since the start or the previous comma */
+                    *errorOffset = (size_t)(iterator + position - csv);
+                    return false;
+                }
+                isValueExpected = true;
+            } else {
+                const char* digit = iterator + position;
+                uint64_t value = 0;
+                if (!isValueExpected) { /* If two values are separated by whitespace rather than a comma */
+                    *errorOffset = (size_t)(digit - csv);
+                    return false;
+                }
+                /* Parse the value's digits. This may go past the end of the window, but never past the string. */
+                for (; digit < end && *digit >= '0' && *digit <= '9'; digit++) {
+                    value = value * 10 + (uint64_t)(*digit - '0');
+                    if (value > UINT32_MAX) { /* If the value doesn't fit in a GID */
+                        *errorOffset = (size_t)(iterator + position - csv);
+                        return false;
+                    }
+                }
+                AddTileLayerTile(layerTiles, (uint32_t)value);
+                isValueExpected = false;
+                if (digit >= iterator + windowLength) { /* If the value continued past the end of the window */
+                    next = digit;
+                    break;
+                }
+            }
+        }
+
+        if (invalid != 0) { /* If there was a character that's neither a digit, comma, nor whitespace */
+            *errorOffset = (size_t)(iterator + CountTrailingZeros64(invalid) - csv);
+            return false;
+        }
+        iterator = next;
+    }
+
+    /* Note: A trailing comma, with nothing but whitespace after it, is tolerated */
+    return true;
+}
+
+uint64_t GetCsvWindowMasks(const char* window, uint32_t windowLength, uint64_t* digits, uint64_t* commas) {
+    uint64_t whitespace = 0;
+    *digits = 0;
+    *commas = 0;
+
+#ifdef TMX_SSE2
+    if (windowLength == 64) { /* If the whole window can be loaded as four 16-character blocks */
+        /* Adding 0x80 - '0' to each character moves '0' through '9' to the bottom of the signed range so that a */
+        /* single signed comparison finds them */
+        const __m128i digitBias = _mm_set1_epi8((char)(0x80 - '0'));
+        const __m128i digitLimit = _mm_set1_epi8((char)(0x80 + 10));
+        for (uint32_t i = 0; i < 4; i++) {
+            __m128i block = _mm_loadu_si128((const __m128i*)(window + i * 16));
+            __m128i isDigit = _mm_cmplt_epi8(_mm_add_epi8(block, digitBias), digitLimit);
+            __m128i isComma = _mm_cmpeq_epi8(block, _mm_set1_epi8(','));
+            __m128i isWhitespace = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\t'))),
+                _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\r'))));
+            *digits |= (uint64_t)(uint16_t)_mm_movemask_epi8(isDigit) << (i * 16);
+            *commas |= (uint64_t)(uint16_t)_mm_movemask_epi8(isComma) << (i * 16);
+            whitespace |= (uint64_t)(uint16_t)_mm_movemask_epi8(isWhitespace) << (i * 16);
+        }
+        return ~(*digits | *commas | whitespace);
+    }
+#endif
+
+    for (uint32_t i = 0; i < windowLength; i++) {
+        char c = window[i];
+        if (c >= '0' && c <= '9')
+            *digits |= (uint64_t)1 << i;
+        else if (c == ',')
+            *commas |= (uint64_t)1 << i;
+        else if (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+            whitespace |= (uint64_t)1 << i;
+    }
+    /* Characters past the end of a short window are neither valid nor invalid */
+    return ~(*digits | *commas | whitespace) & (windowLength == 64 ? UINT64_MAX : ((uint64_t)1 << windowLength) - 1);
+}
+
+uint32_t CountTrailingZeros64(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return (uint32_t)index;
+#else
+    uint32_t count = 0;
+    while ((value & 1) == 0) {
+        value >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+RaytmxDecompressResult DecompressLayerData(RaytmxLayerTiles* layerTiles, const char* compression,
+        const unsigned char* data, size_t dataLength) {
+    bool isGzip = strcmp(compression, "gzip") == 0;
+    bool isZstd = strcmp(compression, "zstd") == 0;
+    bool isChecksumVerified = (tmxLoadFlags & LOAD_VERIFY_CHECKSUMS) != 0;
+    const unsigned char* compressed = data;
+    size_t compressedLength = dataLength, compressedUsed = 0, decompressedLength = 0;
+    uint32_t firstTile = layerTiles->length;
+
+    if (!isZstd) {
+        /* "gzip" and "zlib" both wrap a DEFLATE stream, with different headers and trailers */
+        size_t headerLength = isGzip ? GetGzipHeaderLength(data, dataLength) : GetZlibHeaderLength(data, dataLength);
+        size_t trailerLength = isGzip ? 8 : 4; /* CRC-32 and size, or Adler-32 */
+        if (headerLength == 0 || dataLength < headerLength + trailerLength)
+            return DECOMPRESS_BAD_HEADER;
+        compressed += headerLength;
+        compressedLength -= headerLength;
+
+        if (isGzip) { /* A GZIP trailer ends with the decompressed size */
+            const unsigned char* size = data + dataLength - 4;
+            uint32_t tilesLength = ((uint32_t)size[0] | ((uint32_t)size[1] << 8) | ((uint32_t)size[2] << 16) |
+                ((uint32_t)size[3] << 24)) / 4;
+            if (tilesLength <= UINT32_MAX - firstTile)
+                ReserveTileLayerTiles(layerTiles, firstTile + tilesLength);
+        }
+    }
+
+    /* Decompress directly into the layer's array of GIDs which is already sized for the layer's cells. Should the */
+    /* data turn out to be larger, which it shouldn't, the array is grown and decompression retried. */
+    RaytmxDecompressResult result;
+    while (true) {
+        uint32_t capacity = layerTiles->capacity - firstTile;
+        uint64_t grownCapacity = (uint64_t)firstTile + (capacity > 0 ? capacity * 2ull : 256);
+        unsigned char* destination = (unsigned char*)(layerTiles->gids + firstTile);
+        if (isZstd) {
+            result = DecompressZstd(compressed, compressedLength, destination, sizeof(uint32_t) * capacity,
+                &decompressedLength, isChecksumVerified);
+        } else {
+            result = InflateData(compressed, compressedLength, destination, sizeof(uint32_t) * capacity,
+                &decompressedLength, &compressedUsed);
+        }
+        if (result != DECOMPRESS_OUTPUT_FULL || grownCapacity > UINT32_MAX)
+            break;
+        ReserveTileLayerTiles(layerTiles, (uint32_t)grownCapacity);
+    }
+
+    /* Zstandard frames verify their own checksums, if they have them, but DEFLATE streams are followed by theirs */
+    if (result == DECOMPRESS_SUCCESS && !isZstd && isChecksumVerified &&
+            !IsChecksumValid(compressed + compressedUsed, compressedLength - compressedUsed,
+            (const unsigned char*)(layerTiles->gids + firstTile), decompressedLength, isGzip))
+        result = DECOMPRESS_BAD_CHECKSUM;
+    if (result == DECOMPRESS_SUCCESS) /* N bytes with every four bytes being a single GID results in N / 4 tiles */
+        layerTiles->length += (uint32_t)(decompressedLength / 4);
+    return result;
+}
+
+size_t GetGzipHeaderLength(const unsigned char* data, size_t dataLength) {
+    /* The first two bytes are a magic number, 0x1F8B, identifying the format and the third indicates the compression */
+    /* method where 0x08 is DEFLATE. The fourth is a set of flags indicating which optional fields follow the */
+    /* fixed-length part of the header, which ends with a timestamp, extra flags, and OS ID. */
+    if (dataLength < 10 || data[0] != 0x1F || data[1] != 0x8B || data[2] != 0x08 || (data[3] & 0xE0) != 0)
+        return 0;
+
+    uint8_t flags = data[3];
+    size_t headerLength = 10;
+    if (flags & 0x04) { /* FEXTRA: A two-byte length followed by that many bytes */
+        if (dataLength < headerLength + 2)
+            return 0;
+        headerLength += 2 + (size_t)(data[headerLength] | (data[headerLength + 1] << 8));
+    }
+    if (flags & 0x08) { /* FNAME: A zero-terminated file name */
+        while (headerLength < dataLength && data[headerLength] != '\0')
+            headerLength++;
+        headerLength++;
+    }
+    if (flags & 0x10) { /* FCOMMENT: A zero-terminated comment */
+        while (headerLength < dataLength && data[headerLength] != '\0')
+            headerLength++;
+        headerLength++;
+    }
+    if (flags & 0x02) /* FHCRC: A two-byte CRC of the header */
+        headerLength += 2;
+
+    return headerLength <= dataLength ? headerLength : 0;
+}
+
+size_t GetZlibHeaderLength(const unsigned char* data, size_t dataLength) {
+    /* The lower four bits of the first byte indicate the compression method where 8 is DEFLATE and the upper four */
+    /* bits indicate the window size which can't exceed 32K. The two bytes, as a big-endian value, must be a */
+    /* multiple of 31. A preset dictionary, indicated by bit 5 of the second byte, isn't something Tiled uses. */
+    if (dataLength < 2 || (data[0] & 0x0F) != 8 || (data[0] >> 4) > 7 || ((data[0] << 8) | data[1]) % 31 != 0 ||
+            (data[1] & 0x20) != 0)
+        return 0;
+    return 2;
+}
+
+RaytmxDecompressResult InflateData(const unsigned char* compressed, size_t compressedLength,
+        unsigned char* decompressed, size_t decompressedCapacity, size_t* decompressedLength, size_t* compressedUsed) {
+    RaytmxInflater inflater;
+    inflater.input = compressed;
+    inflater.inputEnd = compressed + compressedLength;
+    inflater.bits = 0;
+    inflater.bitsLength = 0;
+    inflater.output = decompressed;
+    inflater.outputStart = decompressed;
+    inflater.outputEnd = decompressed + decompressedCapacity;
+    inflater.isTruncated = false;
+
+    /* A DEFLATE stream is a series of blocks, each starting with a bit indicating whether it's the last one followed */
+    /* by two bits indicating how the block is encoded */
+    bool isFinalBlock;
+    do {
+        RaytmxDecompressResult result;
+        isFinalBlock = GetInflaterBits(&inflater, 1) != 0;
+        switch (GetInflaterBits(&inflater, 2)) {
+            case 0: result = InflateStoredBlock(&inflater); break;
+            case 1: result = InflateFixedBlock(&inflater); break;
+            case 2: result = InflateDynamicBlock(&inflater); break;
+            default: result = DECOMPRESS_MALFORMED; break;
+        }
+        if (inflater.isTruncated)
+            result = DECOMPRESS_MALFORMED;
+        if (result != DECOMPRESS_SUCCESS)
+            return result;
+    } while (!isFinalBlock);
+
+    /* Any whole bytes still held as bits, by the last refill, weren't actually part of the DEFLATE stream */
+    *decompressedLength = (size_t)(inflater.output - decompressed);
+    *compressedUsed = (size_t)(inflater.input - compressed) - (inflater.bitsLength >> 3);
+    return DECOMPRESS_SUCCESS;
+}
+
+bool IsChecksumValid(const unsigned char* trailer, size_t trailerLength, const unsigned char* data, size_t dataLength,
+        bool isGzip) {
+    /* A GZIP trailer is the CRC-32 of the decompressed data followed by its size modulo 2^32, both little-endian. A */
+    /* ZLIB trailer is the Adler-32 of the decompressed data, big-endian. */
+    if (isGzip) {
+        if (trailerLength < 8)
+            return false;
+        uint32_t crc = (uint32_t)trailer[0] | ((uint32_t)trailer[1] << 8) | ((uint32_t)trailer[2] << 16) |
+            ((uint32_t)trailer[3] << 24);
+        uint32_t size = (uint32_t)trailer[4] | ((uint32_t)trailer[5] << 8) | ((uint32_t)trailer[6] << 16) |
+            ((uint32_t)trailer[7] << 24);
+        return crc == GetCrc32(data, dataLength) && size == (uint32_t)dataLength;
+    }
+
+    if (trailerLength < 4)
+        return false;
+    uint32_t adler = ((uint32_t)trailer[0] << 24) | ((uint32_t)trailer[1] << 16) | ((uint32_t)trailer[2] << 8) |
+        (uint32_t)trailer[3];
+    return adler == GetAdler32(data, dataLength);
+}
+
+RaytmxDecompressResult InflateStoredBlock(RaytmxInflater* inflater) {
+    /* Stored blocks begin at the next byte boundary with a 16-bit length and its one's complement */
+    inflater->bits >>= inflater->bitsLength & 7;
+    inflater->bitsLength -= inflater->bitsLength & 7;
+    uint32_t length = GetInflaterBits(inflater, 16), lengthComplement = GetInflaterBits(inflater, 16);
+    if (inflater->isTruncated || length != (~lengthComplement & 0xFFFF))
+        return DECOMPRESS_MALFORMED;
+    if (length > (size_t)(inflater->outputEnd - inflater->output))
+        return DECOMPRESS_OUTPUT_FULL;
+
+    /* Some of the stored bytes may already be held as bits. Take those first and then copy the rest directly. */
+    for (; length > 0 && inflater->bitsLength >= 8; length--) {
+        *inflater->output = (unsigned char)inflater->bits;
+        inflater->output++;
+        inflater->bits >>= 8;
+        inflater->bitsLength -= 8;
+    }
+    if (length > (size_t)(inflater->inputEnd - inflater->input))
+        return DECOMPRESS_MALFORMED;
+    if (length > 0) /* If the bits are used up, clear what's left of the refill that read ahead of them */
+        inflater->bits = 0;
+    memcpy(inflater->output, inflater->input, length);
+    inflater->output += length;
+    inflater->input += length;
+    return DECOMPRESS_SUCCESS;
+}
+
+RaytmxDecompressResult InflateFixedBlock(RaytmxInflater* inflater) {
+    /* Fixed blocks use Huffman codes defined by the DEFLATE specification rather than the stream */
+    uint8_t codeLengths[288 + 32];
+    memset(codeLengths, 8, 144);
+    memset(codeLengths + 144, 9, 256 - 144);
+    memset(codeLengths + 256, 7, 280 - 256);
+    memset(codeLengths + 280, 8, 288 - 280);
+    memset(codeLengths + 288, 5, 32);
+    if (!BuildHuffmanTable(&inflater->literals, codeLengths, 288) ||
+            !BuildHuffmanTable(&inflater->distances, codeLengths + 288, 32))
+        return DECOMPRESS_MALFORMED;
+    return InflateHuffmanBlock(inflater);
+}
+
+RaytmxDecompressResult InflateDynamicBlock(RaytmxInflater* inflater) {
+    /* Order in which the code lengths of the code length alphabet are given */
+    static const uint8_t codeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+    /* Dynamic blocks begin with the number of literal/length codes, distance codes, and code length codes */
+    uint32_t literalsLength = GetInflaterBits(inflater, 5) + 257;
+    uint32_t distancesLength = GetInflaterBits(inflater, 5) + 1;
+    uint32_t codeLengthsLength = GetInflaterBits(inflater, 4) + 4;
+    if (inflater->isTruncated || literalsLength > 286 || distancesLength > 30)
+        return DECOMPRESS_MALFORMED;
+
+    /* The code lengths of the literal/length and distance alphabets are themselves Huffman-coded. First come the */
+    /* lengths of that code, three bits each, which are used to build a table for decoding the rest. */
+    uint8_t codeLengths[286 + 30];
+    memset(codeLengths, 0, 19);
+    for (uint32_t i = 0; i < codeLengthsLength; i++)
+        codeLengths[codeLengthOrder[i]] = (uint8_t)GetInflaterBits(inflater, 3);
+    if (inflater->isTruncated || !BuildHuffmanTable(&inflater->distances, codeLengths, 19))
+        return DECOMPRESS_MALFORMED;
+
+    /* Symbols 0 through 15 are literal code lengths while 16 repeats the previous length and 17 and 18 repeat zero */
+    uint32_t totalLength = literalsLength + distancesLength;
+    for (uint32_t i = 0; i < totalLength; ) {
+        int32_t symbol = DecodeHuffmanSymbol(inflater, &inflater->distances);
+        uint32_t repeat;
+        uint8_t repeated = 0;
+        if (symbol < 0)
+            return DECOMPRESS_MALFORMED;
+        if (symbol < 16) {
+            codeLengths[i++] = (uint8_t)symbol;
+            continue;
+        } else if (symbol == 16) {
+            if (i == 0) /* If there is no previous length to repeat */
+                return DECOMPRESS_MALFORMED;
+            repeated = codeLengths[i - 1];
+            repeat = GetInflaterBits(inflater, 2) + 3;
+        } else if (symbol == 17)
+            repeat = GetInflaterBits(inflater, 3) + 3;
+        else /* if (symbol == 18) */
+            repeat = GetInflaterBits(inflater, 7) + 11;
+        if (inflater->isTruncated || repeat > totalLength - i)
+            return DECOMPRESS_MALFORMED;
+        memset(codeLengths + i, repeated, repeat);
+        i += repeat;
+    }
+
+    /* The end-of-block symbol must be decodable or the block would never end */
+    if (codeLengths[256] == 0 || !BuildHuffmanTable(&inflater->literals, codeLengths, literalsLength) ||
+            !BuildHuffmanTable(&inflater->distances, codeLengths + literalsLength, distancesLength))
+        return DECOMPRESS_MALFORMED;
+    return InflateHuffmanBlock(inflater);
+}
+
+RaytmxDecompressResult InflateHuffmanBlock(RaytmxInflater* inflater) {
+    /* Base lengths and distances of length and distance symbols, and the number of extra bits added to each */
+    static const uint16_t lengthBases[29] = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227,
+        258
+    };
+    static const uint8_t lengthExtraBits[29] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+    };
+    static const uint16_t distanceBases[30] = {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097,
+        6145, 8193, 12289, 16385, 24577
+    };
+    static const uint8_t distanceExtraBits[30] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+    };
+
+    while (true) {
+        int32_t symbol = DecodeHuffmanSymbol(inflater, &inflater->literals);
+        if (symbol < 256) { /* If a literal byte, or an error */
+            if (symbol < 0)
+                return DECOMPRESS_MALFORMED;
+            if (inflater->output == inflater->outputEnd)
+                return DECOMPRESS_OUTPUT_FULL;
+            *inflater->output = (unsigned char)symbol;
+            inflater->output++;
+            continue;
+        } else if (symbol == 256) /* If the end of the block */
+            return DECOMPRESS_SUCCESS;
+        else if (symbol > 285)
+            return DECOMPRESS_MALFORMED;
+
+        /* Any other symbol is the length of a match which is followed by the distance back to the match */
+        size_t length = lengthBases[symbol - 257] + GetInflaterBits(inflater, lengthExtraBits[symbol - 257]);
+        symbol = DecodeHuffmanSymbol(inflater, &inflater->distances);
+        if (symbol < 0 || symbol > 29)
+            return DECOMPRESS_MALFORMED;
+        size_t distance = distanceBases[symbol] + GetInflaterBits(inflater, distanceExtraBits[symbol]);
+        if (inflater->isTruncated || distance > (size_t)(inflater->output - inflater->outputStart))
+            return DECOMPRESS_MALFORMED;
+        if (length > (size_t)(inflater->outputEnd - inflater->output))
+            return DECOMPRESS_OUTPUT_FULL;
+
+        inflater->output = CopyMatch(inflater->output, inflater->outputEnd, distance, length);
+    }
+}
+
+bool BuildHuffmanTable(RaytmxHuffman* huffman, const uint8_t* codeLengths, uint32_t codeLengthsLength) {
+    /* Codes are canonical, meaning shorter codes precede longer ones and codes of the same length are in the order */
+    /* of their symbols, so the code lengths alone are enough to know each symbol's code. Count the codes of each */
+    /* length to find the first code of each length. */
+    uint32_t counts[16], nextCodes[16];
+    memset(counts, 0, sizeof(counts));
+    for (uint32_t i = 0; i < codeLengthsLength; i++)
+        counts[codeLengths[i]]++;
+    counts[0] = 0;
+
+    uint32_t code = 0, symbolIndex = 0;
+    for (uint32_t length = 1; length < 16; length++) {
+        nextCodes[length] = code;
+        huffman->firstCodes[length] = (uint16_t)code;
+        huffman->firstSymbols[length] = (uint16_t)symbolIndex;
+        code += counts[length];
+        if (counts[length] > 0 && code - 1 >= (1u << length)) /* If there are more codes than can be represented */
+            return false;
+        huffman->maxCodes[length] = code << (16 - length);
+        code <<= 1;
+        symbolIndex += counts[length];
+    }
+    huffman->maxCodes[16] = 0x10000; /* Any 16-bit value is less than this which ends the search for a code */
+    huffman->symbolsLength = symbolIndex;
+
+    /* Assign codes to symbols. Codes are read starting with their most significant bit but the input is read least */
+    /* significant bit first so, for the table that decodes shorter codes in one step, codes are reversed. */
+    memset(huffman->fast, 0, sizeof(huffman->fast));
+    for (uint32_t symbol = 0; symbol < codeLengthsLength; symbol++) {
+        uint32_t length = codeLengths[symbol];
+        if (length == 0)
+            continue;
+
+        uint32_t index = nextCodes[length] - huffman->firstCodes[length] + huffman->firstSymbols[length];
+        huffman->lengths[index] = (uint8_t)length;
+        huffman->symbols[index] = (uint16_t)symbol;
+        if (length <= TMX_INFLATE_FAST_BITS) {
+            /* Every entry whose lowest bits are the reversed code decodes to this symbol */
+            for (uint32_t i = ReverseBits16(nextCodes[length]) >> (16 - length); i < (1u << TMX_INFLATE_FAST_BITS);
+                    i += 1u << length)
+                huffman->fast[i] = (uint16_t)((length << 9) | symbol);
+        }
+        nextCodes[length]++;
+    }
+    return true;
+}
+
+int32_t DecodeHuffmanSymbol(RaytmxInflater* inflater, const RaytmxHuffman* huffman) {
+    if (inflater->bitsLength < 16)
+        RefillInflaterBits(inflater);
+
+    uint32_t length, symbol, entry = huffman->fast[inflater->bits & ((1u << TMX_INFLATE_FAST_BITS) - 1)];
+    if (entry != 0) { /* If the code is short enough to be decoded in one step */
+        length = entry >> 9;
+        symbol = entry & 0x1FF;
+    } else {
+        /* Find the length of the code by comparing it, most significant bit first, to the last code of each length */
+        uint32_t code = ReverseBits16((uint32_t)(inflater->bits & 0xFFFF));
+        for (length = TMX_INFLATE_FAST_BITS + 1; code >= huffman->maxCodes[length]; length++)
+            ;
+        if (length == 16) /* If the code isn't one of those assigned */
+            return -1;
+        uint32_t index = (code >> (16 - length)) - huffman->firstCodes[length] + huffman->firstSymbols[length];
+        if (index >= huffman->symbolsLength || huffman->lengths[index] != length)
+            return -1;
+        symbol = huffman->symbols[index];
+    }
+
+    if (length > inflater->bitsLength) /* If the code was cut off by the end of the input */
+        return -1;
+    inflater->bits >>= length;
+    inflater->bitsLength -= length;
+    return (int32_t)symbol;
+}
+
+uint32_t GetInflaterBits(RaytmxInflater* inflater, uint32_t bitsLength) {
+    if (inflater->bitsLength < bitsLength) {
+        RefillInflaterBits(inflater);
+        if (inflater->bitsLength < bitsLength) { /* If the input ended */
+            inflater->isTruncated = true;
+            return 0;
+        }
+    }
+
+    uint32_t bits = (uint32_t)(inflater->bits & ((1u << bitsLength) - 1));
+    inflater->bits >>= bitsLength;
+    inflater->bitsLength -= bitsLength;
+    return bits;
+}
+
+void RefillInflaterBits(RaytmxInflater* inflater) {
+    if (inflater->inputEnd - inflater->input >= 8) {
+        /* Read eight bytes at once and keep as many whole bytes as fit. The bits of a byte that only partly fit are */
+        /* left above 'bitsLength' and the next refill ORs in the same bits again. */
+        uint64_t bytes;
+        memcpy(&bytes, inflater->input, 8);
+        inflater->bits |= bytes << inflater->bitsLength;
+        inflater->input += (63 - inflater->bitsLength) >> 3;
+        inflater->bitsLength |= 56;
+    } else {
+        while (inflater->bitsLength <= 56 && inflater->input < inflater->inputEnd) {
+            inflater->bits |= (uint64_t)*inflater->input << inflater->bitsLength;
+            inflater->input++;
+            inflater->bitsLength += 8;
+        }
+    }
+}
+
+unsigned char* CopyMatch(unsigned char* output, const unsigned char* outputEnd, size_t distance, size_t length) {
+    /* A match may overlap the bytes it produces, repeating the last 'distance' bytes. Since the output repeats */
+    /* every 'distance' bytes, it also repeats every multiple thereof. Copying enough bytes individually to span a */
+    /* multiple of at least eight allows the rest to be copied eight at a time. */
+    size_t period = distance;
+    while (period < 8)
+        period += distance;
+    for (size_t i = distance; i < period && length > 0; i++, length--) {
+        *output = *(output - distance);
+        output++;
+    }
+    const unsigned char* source = output - period;
+    if (length + 8 <= (size_t)(outputEnd - output)) {
+        /* When there's room past the end of the match, round it up to a multiple of eight instead of finishing */
+        /* byte by byte. The excess is overwritten by whatever comes next. */
+        for (size_t i = 0; i < length; i += 8)
+            memcpy(output + i, source + i, 8);
+        return output + length;
+    }
+    for (; length >= 8; length -= 8) {
+        memcpy(output, source, 8);
+        output += 8;
+        source += 8;
+    }
+    for (; length > 0; length--)
+        *output++ = *source++;
+    return output;
+}
+
+uint32_t ReverseBits16(uint32_t value) {
+    value = ((value & 0xAAAA) >> 1) | ((value & 0x5555) << 1);
+    value = ((value & 0xCCCC) >> 2) | ((value & 0x3333) << 2);
+    value = ((value & 0xF0F0) >> 4) | ((value & 0x0F0F) << 4);
+    value = ((value & 0xFF00) >> 8) | ((value & 0x00FF) << 8);
+    return value;
+}
+
+uint32_t GetCrc32(const unsigned char* data, size_t dataLength) {
+    uint32_t table[256];
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t value = i;
+        for (int j = 0; j < 8; j++)
+            value = (value >> 1) ^ (0xEDB88320 & (0 - (value & 1)));
+        table[i] = value;
+    }
+
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < dataLength; i++)
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+uint32_t GetAdler32(const unsigned char* data, size_t dataLength) {
+    uint32_t a = 1, b = 0;
+    while (dataLength > 0) {
+        /* 5552 is the most bytes that can be summed before 'b' may overflow and must be reduced */
+        size_t blockLength = dataLength < 5552 ? dataLength : 5552;
+        dataLength -= blockLength;
+        for (; blockLength > 0; blockLength--) {
+            a += *data++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    return (b << 16) | a;
+}
+
+RaytmxDecompressResult DecompressZstd(const unsigned char* compressed, size_t compressedLength,
+        unsigned char* decompressed, size_t decompressedCapacity, size_t* decompressedLength, bool isChecksumVerified) {
+    const unsigned char* input = compressed;
+    const unsigned char* inputEnd = compressed + compressedLength;
+    RaytmxZstdDecoder decoder;
+    decoder.output = decompressed;
+    decoder.outputEnd = decompressed + decompressedCapacity;
+    decoder.literalsBuffer = NULL;
+
+    /* Zstandard data is a series of frames, each decompressed independently of the others. Skippable frames, with */
+    /* magic numbers 0x184D2A50 through 0x184D2A5F, only contain a length and that many bytes of user data. */
+    RaytmxDecompressResult result = DECOMPRESS_SUCCESS;
+    while (input < inputEnd && result == DECOMPRESS_SUCCESS) {
+        if (inputEnd - input < 8) {
+            result = DECOMPRESS_BAD_HEADER;
+            break;
+        }
+        uint32_t magicNumber = (uint32_t)input[0] | ((uint32_t)input[1] << 8) | ((uint32_t)input[2] << 16) |
+            ((uint32_t)input[3] << 24);
+        if ((magicNumber & 0xFFFFFFF0) == 0x184D2A50) {
+            uint32_t skippedLength = (uint32_t)input[4] | ((uint32_t)input[5] << 8) | ((uint32_t)input[6] << 16) |
+                ((uint32_t)input[7] << 24);
+            if (skippedLength > (size_t)(inputEnd - input) - 8)
+                result = DECOMPRESS_MALFORMED;
+            input += 8 + (size_t)skippedLength;
+        } else if (magicNumber == 0xFD2FB528) {
+            if (decoder.literalsBuffer == NULL)
+                decoder.literalsBuffer = (unsigned char*)MemAlloc(TMX_ZSTD_MAX_BLOCK_SIZE);
+            input += 4;
+            result = DecompressZstdFrame(&decoder, &input, inputEnd, isChecksumVerified);
+        } else
+            result = DECOMPRESS_BAD_HEADER;
+    }
+
+    if (decoder.literalsBuffer != NULL)
+        MemFree(decoder.literalsBuffer);
+    *decompressedLength = (size_t)(decoder.output - decompressed);
+    return result;
+}
+
+RaytmxDecompressResult DecompressZstdFrame(RaytmxZstdDecoder* decoder, const unsigned char** input,
+        const unsigned char* inputEnd, bool isChecksumVerified) {
+    /* The frame header begins with a descriptor byte whose bits say which of the optional fields follow it */
+    static const uint8_t dictionaryIdSizes[4] = { 0, 1, 2, 4 };
+    static const uint8_t contentSizeSizes[4] = { 0, 2, 4, 8 };
+    const unsigned char* iterator = *input;
+    uint8_t descriptor = *iterator;
+    bool isSingleSegment = (descriptor & 0x20) != 0, hasChecksum = (descriptor & 0x04) != 0;
+    size_t contentSizeSize = contentSizeSizes[descriptor >> 6];
+    if (contentSizeSize == 0 && isSingleSegment) /* A single-segment frame always gives its content size */
+        contentSizeSize = 1;
+    size_t headerLength = 1 + (isSingleSegment ? 0 : 1) + dictionaryIdSizes[descriptor & 0x03] + contentSizeSize;
+    if ((descriptor & 0x08) != 0 || (size_t)(inputEnd - iterator) < headerLength) /* If reserved or truncated */
+        return DECOMPRESS_BAD_HEADER;
+    iterator += 1 + (isSingleSegment ? 0 : 1); /* Skip the descriptor and window size since everything is in memory */
+
+    /* Dictionaries are a way of priming the decoder with data common to many frames which Tiled doesn't use */
+    uint32_t dictionaryId = 0;
+    for (uint32_t i = 0; i < dictionaryIdSizes[descriptor & 0x03]; i++)
+        dictionaryId |= (uint32_t)*iterator++ << (8 * i);
+    if (dictionaryId != 0)
+        return DECOMPRESS_UNSUPPORTED;
+
+    uint64_t contentSize = 0;
+    for (uint32_t i = 0; i < contentSizeSize; i++)
+        contentSize |= (uint64_t)*iterator++ << (8 * i);
+    if (contentSizeSize == 2) /* Two-byte sizes are offset since smaller sizes would fit in one byte */
+        contentSize += 256;
+    if (contentSizeSize > 0 && contentSize > (uint64_t)(decoder->outputEnd - decoder->output))
+        return DECOMPRESS_OUTPUT_FULL;
+
+    /* Matches can't reach back into previous frames and each frame starts with its own offsets and tables */
+    decoder->outputStart = decoder->output;
+    decoder->repeatOffsets[0] = 1;
+    decoder->repeatOffsets[1] = 4;
+    decoder->repeatOffsets[2] = 8;
+    decoder->hasHuffmanTable = false;
+    decoder->literalLengths.isDefined = false;
+    decoder->offsets.isDefined = false;
+    decoder->matchLengths.isDefined = false;
+
+    /* Each block begins with a three-byte header: whether it's the last block, its type, and its size */
+    bool isLastBlock;
+    do {
+        if (inputEnd - iterator < 3)
+            return DECOMPRESS_MALFORMED;
+        uint32_t blockHeader = (uint32_t)iterator[0] | ((uint32_t)iterator[1] << 8) | ((uint32_t)iterator[2] << 16);
+        uint32_t blockType = (blockHeader >> 1) & 0x03, blockSize = blockHeader >> 3;
+        isLastBlock = (blockHeader & 0x01) != 0;
+        iterator += 3;
+
+        if (blockType == 1) { /* RLE: A single byte repeated 'blockSize' times */
+            if (iterator == inputEnd)
+                return DECOMPRESS_MALFORMED;
+            if (blockSize > (size_t)(decoder->outputEnd - decoder->output))
+                return DECOMPRESS_OUTPUT_FULL;
+            memset(decoder->output, *iterator, blockSize);
+            decoder->output += blockSize;
+            iterator++;
+            continue;
+        }
+
+        if (blockSize > TMX_ZSTD_MAX_BLOCK_SIZE || blockSize > (size_t)(inputEnd - iterator))
+            return DECOMPRESS_MALFORMED;
+        if (blockType == 0) { /* Raw: 'blockSize' bytes stored as they are */
+            if (blockSize > (size_t)(decoder->outputEnd - decoder->output))
+                return DECOMPRESS_OUTPUT_FULL;
+            memcpy(decoder->output, iterator, blockSize);
+            decoder->output += blockSize;
+        } else if (blockType == 2) { /* Compressed */
+            RaytmxDecompressResult result = DecompressZstdBlock(decoder, iterator, blockSize);
+            if (result != DECOMPRESS_SUCCESS)
+                return result;
+        } else /* Reserved */
+            return DECOMPRESS_MALFORMED;
+        iterator += blockSize;
+    } while (!isLastBlock);
+
+    if (contentSizeSize > 0 && contentSize != (uint64_t)(decoder->output - decoder->outputStart))
+        return DECOMPRESS_MALFORMED;
+
+    /* The optional checksum is the lower 32 bits of the XXH64 hash of the frame's decompressed data */
+    if (hasChecksum) {
+        if (inputEnd - iterator < 4)
+            return DECOMPRESS_MALFORMED;
+        uint32_t checksum = (uint32_t)iterator[0] | ((uint32_t)iterator[1] << 8) | ((uint32_t)iterator[2] << 16) |
+            ((uint32_t)iterator[3] << 24);
+        if (isChecksumVerified && checksum != (uint32_t)GetXxHash64(decoder->outputStart,
+                (size_t)(decoder->output - decoder->outputStart)))
+            return DECOMPRESS_BAD_CHECKSUM;
+        iterator += 4;
+    }
+
+    *input = iterator;
+    return DECOMPRESS_SUCCESS;
+}
+
+RaytmxDecompressResult DecompressZstdBlock(RaytmxZstdDecoder* decoder, const unsigned char* block,
+        size_t blockLength) {
+    /* A compressed block is made of two sections: literals, which are the bytes that couldn't be compressed as */
+    /* matches, and sequences, which say how many literals to copy before copying a match from earlier output */
+    size_t literalsSectionLength;
+    if (!DecodeZstdLiterals(decoder, block, blockLength, &literalsSectionLength))
+        return DECOMPRESS_MALFORMED;
+    return DecodeZstdSequences(decoder, block + literalsSectionLength, blockLength - literalsSectionLength);
+}
+
+bool DecodeZstdLiterals(RaytmxZstdDecoder* decoder, const unsigned char* block, size_t blockLength,
+        size_t* sectionLength) {
+    if (blockLength == 0)
+        return false;
+
+    /* The section's header is one to five bytes. The lowest two bits are the type of literals and the next two */
+    /* determine the size of the header and how many streams Huffman-coded literals are split into. */
+    uint32_t literalsType = block[0] & 0x03, sizeFormat = (block[0] >> 2) & 0x03;
+    size_t headerLength, literalsLength;
+    if (literalsType <= 1) { /* If raw or RLE */
+        headerLength = sizeFormat == 1 ? 2 : (sizeFormat == 3 ? 3 : 1);
+        if (blockLength < headerLength)
+            return false;
+        if (headerLength == 1)
+            literalsLength = block[0] >> 3;
+        else if (headerLength == 2)
+            literalsLength = (block[0] >> 4) | ((size_t)block[1] << 4);
+        else
+            literalsLength = (block[0] >> 4) | ((size_t)block[1] << 4) | ((size_t)block[2] << 12);
+        if (literalsLength > TMX_ZSTD_MAX_BLOCK_SIZE)
+            return false;
+
+        if (literalsType == 0) { /* Raw: The literals are used directly from the block */
+            if (blockLength - headerLength < literalsLength)
+                return false;
+            decoder->literals = block + headerLength;
+            *sectionLength = headerLength + literalsLength;
+        } else { /* RLE: A single byte repeated 'literalsLength' times */
+            if (blockLength - headerLength < 1)
+                return false;
+            memset(decoder->literalsBuffer, block[headerLength], literalsLength);
+            decoder->literals = decoder->literalsBuffer;
+            *sectionLength = headerLength + 1;
+        }
+        decoder->literalsLength = literalsLength;
+        return true;
+    }
+
+    /* Huffman-coded literals give both their regenerated and compressed sizes, 10, 14, or 18 bits each */
+    static const uint8_t headerLengths[4] = { 3, 3, 4, 5 }, sizeBits[4] = { 10, 10, 14, 18 };
+    headerLength = headerLengths[sizeFormat];
+    if (blockLength < headerLength)
+        return false;
+    uint64_t header = 0;
+    for (size_t i = 0; i < headerLength; i++)
+        header |= (uint64_t)block[i] << (8 * i);
+    literalsLength = (size_t)((header >> 4) & ((1u << sizeBits[sizeFormat]) - 1));
+    size_t compressedLength = (size_t)((header >> (4 + sizeBits[sizeFormat])) & ((1u << sizeBits[sizeFormat]) - 1));
+    if (literalsLength > TMX_ZSTD_MAX_BLOCK_SIZE || blockLength - headerLength < compressedLength)
+        return false;
+
+    /* Compressed literals begin with a description of their Huffman code while "treeless" ones reuse the last one */
+    const unsigned char* streams = block + headerLength;
+    size_t streamsLength = compressedLength;
+    if (literalsType == 2) {
+        size_t descriptionLength;
+        if (!ReadZstdHuffmanTable(decoder, streams, streamsLength, &descriptionLength))
+            return false;
+        streams += descriptionLength;
+        streamsLength -= descriptionLength;
+    } else if (!decoder->hasHuffmanTable)
+        return false;
+
+    if (sizeFormat == 0) { /* If the literals are a single stream */
+        if (!DecodeZstdHuffmanStream(decoder, streams, streamsLength, decoder->literalsBuffer, literalsLength))
+            return false;
+    } else {
+        /* Four streams follow a table of the first three's sizes. Each stream decodes a quarter of the literals. */
+        if (streamsLength < 6)
+            return false;
+        size_t streamLengths[4], segmentLength = (literalsLength + 3) / 4;
+        streamLengths[0] = (size_t)streams[0] | ((size_t)streams[1] << 8);
+        streamLengths[1] = (size_t)streams[2] | ((size_t)streams[3] << 8);
+        streamLengths[2] = (size_t)streams[4] | ((size_t)streams[5] << 8);
+        if (streamLengths[0] + streamLengths[1] + streamLengths[2] > streamsLength - 6 ||
+                literalsLength < 3 * segmentLength)
+            return false;
+        streamLengths[3] = streamsLength - 6 - streamLengths[0] - streamLengths[1] - streamLengths[2];
+        streams += 6;
+        for (uint32_t i = 0; i < 4; i++) {
+            size_t outputLength = i < 3 ? segmentLength : literalsLength - 3 * segmentLength;
+            unsigned char* output = decoder->literalsBuffer + i * segmentLength;
+            if (!DecodeZstdHuffmanStream(decoder, streams, streamLengths[i], output, outputLength))
+                return false;
+            streams += streamLengths[i];
+        }
+    }
+
+    decoder->literals = decoder->literalsBuffer;
+    decoder->literalsLength = literalsLength;
+    *sectionLength = headerLength + compressedLength;
+    return true;
+}
+
+bool ReadZstdHuffmanTable(RaytmxZstdDecoder* decoder, const unsigned char* data, size_t dataLength,
+        size_t* descriptionLength) {
+    /* The code is described by the weights of its symbols, in order, except for the last symbol whose weight is */
+    /* implied. The weights are either four bits each or FSE-compressed, depending on the first byte. */
+    uint8_t weights[256];
+    uint32_t weightsLength = 0;
+    if (dataLength == 0)
+        return false;
+    if (data[0] >= 128) { /* If the weights are four bits each */
+        weightsLength = data[0] - 127;
+        *descriptionLength = 1 + (weightsLength + 1) / 2;
+        if (*descriptionLength > dataLength)
+            return false;
+        for (uint32_t i = 0; i < weightsLength; i++)
+            weights[i] = (i % 2 == 0) ? data[1 + i / 2] >> 4 : data[1 + i / 2] & 0x0F;
+    } else { /* If the weights are FSE-compressed within the next 'data[0]' bytes */
+        size_t compressedLength = data[0];
+        *descriptionLength = 1 + compressedLength;
+        if (*descriptionLength > dataLength)
+            return false;
+
+        int16_t probabilities[256];
+        uint32_t symbolsLength, accuracyLog;
+        size_t distributionLength = ReadFseDistribution(data + 1, compressedLength, probabilities, 255, 6,
+            &symbolsLength, &accuracyLog);
+        RaytmxFseTable table;
+        RaytmxZstdBits bits;
+        if (distributionLength == 0 || !BuildFseTable(&table, probabilities, symbolsLength, accuracyLog) ||
+                !InitZstdBits(&bits, data + 1 + distributionLength, compressedLength - distributionLength))
+            return false;
+
+        /* Two interleaved states decode alternate weights until the bits run out. When they do, the state that */
+        /* wasn't just updated still has one more weight to give. */
+        uint32_t states[2];
+        states[0] = (uint32_t)ReadZstdBits(&bits, accuracyLog);
+        states[1] = (uint32_t)ReadZstdBits(&bits, accuracyLog);
+        for (uint32_t i = 0; ; i ^= 1) {
+            if (weightsLength > 253)
+                return false;
+            const RaytmxFseEntry* entry = &table.entries[states[i]];
+            weights[weightsLength++] = entry->symbol;
+            states[i] = entry->baseline + (uint32_t)ReadZstdBits(&bits, entry->bitsLength);
+            ReloadZstdBits(&bits);
+            if (bits.consumed > 64) { /* If the update read past the start of the bits */
+                weights[weightsLength++] = table.entries[states[i ^ 1]].symbol;
+                break;
+            }
+        }
+    }
+
+    /* A weight of W means a code length of 'maxBits + 1 - W' and zero means the symbol isn't used. Codes' lengths */
+    /* must fill the code space exactly so the last weight is whatever fills the rest. */
+    uint32_t weightsSum = 0, weightCounts[TMX_ZSTD_MAX_HUFFMAN_BITS + 1];
+    memset(weightCounts, 0, sizeof(weightCounts));
+    for (uint32_t i = 0; i < weightsLength; i++) {
+        if (weights[i] > TMX_ZSTD_MAX_HUFFMAN_BITS)
+            return false;
+        if (weights[i] > 0)
+            weightsSum += 1u << (weights[i] - 1);
+    }
+    if (weightsSum == 0)
+        return false;
+    uint32_t maxBits = GetHighestBit(weightsSum) + 1, leftover = (1u << maxBits) - weightsSum;
+    if (maxBits > TMX_ZSTD_MAX_HUFFMAN_BITS || (leftover & (leftover - 1)) != 0) /* If not a power of two */
+        return false;
+    weights[weightsLength++] = (uint8_t)(GetHighestBit(leftover) + 1);
+
+    /* Codes are assigned in order of increasing weight, and then symbol, each symbol filling a span of the table */
+    /* that's indexed by the next 'maxBits' bits */
+    uint32_t spanStarts[TMX_ZSTD_MAX_HUFFMAN_BITS + 1], spanStart = 0;
+    for (uint32_t i = 0; i < weightsLength; i++)
+        weightCounts[weights[i]]++;
+    for (uint32_t weight = 1; weight <= TMX_ZSTD_MAX_HUFFMAN_BITS; weight++) {
+        spanStarts[weight] = spanStart;
+        spanStart += weightCounts[weight] << (weight - 1);
+    }
+    for (uint32_t symbol = 0; symbol < weightsLength; symbol++) {
+        uint32_t weight = weights[symbol];
+        if (weight == 0)
+            continue;
+        for (uint32_t i = 0; i < (1u << (weight - 1)); i++) {
+            decoder->huffmanTable[spanStarts[weight] + i].symbol = (uint8_t)symbol;
+            decoder->huffmanTable[spanStarts[weight] + i].bitsLength = (uint8_t)(maxBits + 1 - weight);
+        }
+        spanStarts[weight] += 1u << (weight - 1);
+    }
+    decoder->huffmanBits = maxBits;
+    decoder->hasHuffmanTable = true;
+    return true;
+}
+
+bool DecodeZstdHuffmanStream(const RaytmxZstdDecoder* decoder, const unsigned char* stream, size_t streamLength,
+        unsigned char* output, size_t outputLength) {
+    RaytmxZstdBits bits;
+    if (!InitZstdBits(&bits, stream, streamLength))
+        return false;
+
+    /* Codes are at most eleven bits so four can be decoded from the bits available after each reload */
+    const RaytmxZstdHuffmanEntry* table = decoder->huffmanTable;
+    uint32_t maxBits = decoder->huffmanBits;
+    size_t i = 0;
+    for (; i + 4 <= outputLength; i += 4) {
+        for (uint32_t j = 0; j < 4; j++) {
+            const RaytmxZstdHuffmanEntry* entry = &table[PeekZstdBits(&bits, maxBits)];
+            output[i + j] = entry->symbol;
+            bits.consumed += entry->bitsLength;
+        }
+        ReloadZstdBits(&bits);
+    }
+    for (; i < outputLength; i++) {
+        const RaytmxZstdHuffmanEntry* entry = &table[PeekZstdBits(&bits, maxBits)];
+        output[i] = entry->symbol;
+        bits.consumed += entry->bitsLength;
+        ReloadZstdBits(&bits);
+    }
+
+    /* The stream must end exactly where its bits do */
+    return bits.current == bits.start && bits.consumed == 64;
+}
+
+RaytmxDecompressResult DecodeZstdSequences(RaytmxZstdDecoder* decoder, const unsigned char* section,
+        size_t sectionLength) {
+    /* Predefined distributions of the literal length, offset, and match length codes */
+    static const int16_t literalLengthsDistribution[36] = {
+        4, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 1, 1, 1, 1, 1, -1, -1, -1, -1
+    };
+    static const int16_t offsetsDistribution[29] = {
+        1, 1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1
+    };
+    static const int16_t matchLengthsDistribution[53] = {
+        1, 4, 3, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1, -1, -1
+    };
+    /* Base values of the literal length and match length codes and the number of extra bits added to each */
+    static const uint32_t literalLengthBases[36] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 18, 20, 22, 24, 28, 32, 40, 48, 64, 128, 256, 512,
+        1024, 2048, 4096, 8192, 16384, 32768, 65536
+    };
+    static const uint8_t literalLengthExtraBits[36] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3, 3, 4, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+        16
+    };
+    static const uint32_t matchLengthBases[53] = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+        32, 33, 34, 35, 37, 39, 41, 43, 47, 51, 59, 67, 83, 99, 131, 259, 515, 1027, 2051, 4099, 8195, 16387, 32771,
+        65539
+    };
+    static const uint8_t matchLengthExtraBits[53] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2,
+        2, 3, 3, 4, 4, 5, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16
+    };
+
+    /* The section begins with the number of sequences in one to three bytes */
+    const unsigned char* iterator = section;
+    const unsigned char* end = section + sectionLength;
+    size_t sequencesLength;
+    if (sectionLength < 1)
+        return DECOMPRESS_MALFORMED;
+    if (iterator[0] < 128) {
+        sequencesLength = iterator[0];
+        iterator += 1;
+    } else if (iterator[0] < 255) {
+        if (sectionLength < 2)
+            return DECOMPRESS_MALFORMED;
+        sequencesLength = ((size_t)(iterator[0] - 128) << 8) | iterator[1];
+        iterator += 2;
+    } else {
+        if (sectionLength < 3)
+            return DECOMPRESS_MALFORMED;
+        sequencesLength = ((size_t)iterator[1] | ((size_t)iterator[2] << 8)) + 0x7F00;
+        iterator += 3;
+    }
+
+    const unsigned char* literals = decoder->literals;
+    const unsigned char* literalsEnd = decoder->literals + decoder->literalsLength;
+    unsigned char* output = decoder->output;
+    if (sequencesLength > 0) {
+        /* Next is a byte of the modes of the literal length, offset, and match length tables, followed by the */
+        /* tables themselves, and then the bits of the sequences which are read backward */
+        if (iterator == end || (*iterator & 0x03) != 0)
+            return DECOMPRESS_MALFORMED;
+        uint8_t modes = *iterator++;
+        RaytmxZstdBits bits;
+        if (!ReadZstdSequenceTable(&decoder->literalLengths, modes >> 6, literalLengthsDistribution, 36, 6, 35, 9,
+                &iterator, end) ||
+                !ReadZstdSequenceTable(&decoder->offsets, (modes >> 4) & 0x03, offsetsDistribution, 29, 5, 31, 8,
+                &iterator, end) ||
+                !ReadZstdSequenceTable(&decoder->matchLengths, (modes >> 2) & 0x03, matchLengthsDistribution, 53, 6,
+                52, 9, &iterator, end) ||
+                !InitZstdBits(&bits, iterator, (size_t)(end - iterator)))
+            return DECOMPRESS_MALFORMED;
+
+        const RaytmxFseEntry* literalLengthEntries = decoder->literalLengths.entries;
+        const RaytmxFseEntry* offsetEntries = decoder->offsets.entries;
+        const RaytmxFseEntry* matchLengthEntries = decoder->matchLengths.entries;
+        uint32_t literalLengthState = (uint32_t)ReadZstdBits(&bits, decoder->literalLengths.accuracyLog);
+        uint32_t offsetState = (uint32_t)ReadZstdBits(&bits, decoder->offsets.accuracyLog);
+        uint32_t matchLengthState = (uint32_t)ReadZstdBits(&bits, decoder->matchLengths.accuracyLog);
+        ReloadZstdBits(&bits);
+
+        for (size_t i = 0; i < sequencesLength; i++) {
+            /* Each sequence's offset, match length, and literal length are read, in that order, from the codes */
+            /* given by the current states and their extra bits */
+            uint32_t offsetCode = offsetEntries[offsetState].symbol;
+            uint32_t matchLengthCode = matchLengthEntries[matchLengthState].symbol;
+            uint32_t literalLengthCode = literalLengthEntries[literalLengthState].symbol;
+            uint32_t matchLengthBits = matchLengthExtraBits[matchLengthCode];
+            uint32_t literalLengthBits = literalLengthExtraBits[literalLengthCode];
+            size_t offsetValue = ((size_t)1 << offsetCode) + (size_t)ReadZstdBits(&bits, offsetCode);
+            size_t matchLength = matchLengthBases[matchLengthCode] + (size_t)ReadZstdBits(&bits, matchLengthBits);
+            /* Up to seven bits are left over from the last reload and the state updates take up to 26 more, so */
+            /* the container only needs reloading between sequences unless the extra bits take more than 31 */
+            if (offsetCode + matchLengthBits + literalLengthBits > 31)
+                ReloadZstdBits(&bits);
+            size_t literalLength = literalLengthBases[literalLengthCode] +
+                (size_t)ReadZstdBits(&bits, literalLengthBits);
+
+            /* Offset values of one to three refer to the three most recent offsets, shifted by one when there are */
+            /* no literals, and larger values are new offsets plus three */
+            size_t offset;
+            uint32_t* repeatOffsets = decoder->repeatOffsets;
+            if (offsetValue > 3) {
+                offset = offsetValue - 3;
+                repeatOffsets[2] = repeatOffsets[1];
+                repeatOffsets[1] = repeatOffsets[0];
+                repeatOffsets[0] = (uint32_t)offset;
+            } else {
+                size_t repeatIndex = offsetValue - 1 + (literalLength == 0 ? 1 : 0);
+                if (repeatIndex == 0)
+                    offset = repeatOffsets[0];
+                else {
+                    offset = repeatIndex == 3 ? (size_t)repeatOffsets[0] - 1 : repeatOffsets[repeatIndex];
+                    if (repeatIndex > 1)
+                        repeatOffsets[2] = repeatOffsets[1];
+                    repeatOffsets[1] = repeatOffsets[0];
+                    repeatOffsets[0] = (uint32_t)offset;
+                }
+            }
+
+            /* Copy the literals and then the match */
+            if (literalLength > (size_t)(literalsEnd - literals))
+                return DECOMPRESS_MALFORMED;
+            if (literalLength + matchLength > (size_t)(decoder->outputEnd - output))
+                return DECOMPRESS_OUTPUT_FULL;
+            if (literalLength + 16 <= (size_t)(literalsEnd - literals) &&
+                    literalLength + matchLength + 16 <= (size_t)(decoder->outputEnd - output)) {
+                /* With room to spare on both sides, copy sixteen bytes at a time and let the match overwrite the */
+                /* excess. Most literal lengths are short enough for a single copy. */
+                for (size_t j = 0; j < literalLength; j += 16)
+                    memcpy(output + j, literals + j, 16);
+            } else
+                memcpy(output, literals, literalLength);
+            output += literalLength;
+            literals += literalLength;
+            if (offset == 0 || offset > (size_t)(output - decoder->outputStart))
+                return DECOMPRESS_MALFORMED;
+            output = CopyMatch(output, decoder->outputEnd, offset, matchLength);
+
+            if (i + 1 < sequencesLength) { /* If there's another sequence, update the states for it */
+                literalLengthState = literalLengthEntries[literalLengthState].baseline +
+                    (uint32_t)ReadZstdBits(&bits, literalLengthEntries[literalLengthState].bitsLength);
+                matchLengthState = matchLengthEntries[matchLengthState].baseline +
+                    (uint32_t)ReadZstdBits(&bits, matchLengthEntries[matchLengthState].bitsLength);
+                offsetState = offsetEntries[offsetState].baseline +
+                    (uint32_t)ReadZstdBits(&bits, offsetEntries[offsetState].bitsLength);
+                ReloadZstdBits(&bits);
+            }
+        }
+        if (bits.current != bits.start || bits.consumed != 64) /* If the sequences didn't use exactly all bits */
+            return DECOMPRESS_MALFORMED;
+    } else if (iterator != end)
+        return DECOMPRESS_MALFORMED;
+
+    /* Literals not used by any sequence follow the last one */
+    size_t remainingLength = (size_t)(literalsEnd - literals);
+    if (remainingLength > (size_t)(decoder->outputEnd - output))
+        return DECOMPRESS_OUTPUT_FULL;
+    memcpy(output, literals, remainingLength);
+    decoder->output = output + remainingLength;
+    return DECOMPRESS_SUCCESS;
+}
+
+bool ReadZstdSequenceTable(RaytmxFseTable* table, uint32_t mode, const int16_t* defaultDistribution,
+        uint32_t defaultSymbolsLength, uint32_t defaultAccuracyLog, uint32_t maxSymbol, uint32_t maxAccuracyLog,
+        const unsigned char** iterator, const unsigned char* end) {
+    if (mode == 0) /* Predefined: The distribution defined by the Zstandard format */
+        table->isDefined = BuildFseTable(table, defaultDistribution, defaultSymbolsLength, defaultAccuracyLog);
+    else if (mode == 1) { /* RLE: Every code is the same single symbol */
+        if (*iterator == end || **iterator > maxSymbol)
+            return false;
+        table->entries[0].symbol = **iterator;
+        table->entries[0].bitsLength = 0;
+        table->entries[0].baseline = 0;
+        table->accuracyLog = 0;
+        table->isDefined = true;
+        *iterator += 1;
+    } else if (mode == 2) { /* FSE-compressed: The distribution is given by the block */
+        int16_t probabilities[TMX_ZSTD_MAX_FSE_SYMBOLS];
+        uint32_t symbolsLength, accuracyLog;
+        size_t distributionLength = ReadFseDistribution(*iterator, (size_t)(end - *iterator), probabilities, maxSymbol,
+            maxAccuracyLog, &symbolsLength, &accuracyLog);
+        table->isDefined = distributionLength > 0 && BuildFseTable(table, probabilities, symbolsLength, accuracyLog);
+        *iterator += distributionLength;
+    } /* else if (mode == 3) */ /* Repeat: The table of the previous block is used again */
+    return table->isDefined;
+}
+
+size_t ReadFseDistribution(const unsigned char* data, size_t dataLength, int16_t* probabilities, uint32_t maxSymbol,
+        uint32_t maxAccuracyLog, uint32_t* symbolsLength, uint32_t* accuracyLog) {
+    if (dataLength == 0)
+        return 0;
+
+    /* The distribution begins with the accuracy log in four bits. Probabilities then follow in as many bits as */
+    /* needed to represent what probability remains to be given, with a probability of -1 being a special case */
+    /* meaning "less than one." After any zero probability, two-bit values repeatedly give more zeros. */
+    size_t bitPosition = 4;
+    *accuracyLog = (data[0] & 0x0F) + 5;
+    if (*accuracyLog > maxAccuracyLog)
+        return 0;
+    int32_t remaining = (1 << *accuracyLog) + 1, threshold = 1 << *accuracyLog;
+    uint32_t bitsLength = *accuracyLog + 1, symbol = 0;
+    bool isPreviousZero = false;
+    while (remaining > 1 && symbol <= maxSymbol) {
+        if (isPreviousZero) {
+            uint32_t repeat;
+            do {
+                repeat = PeekFseDistributionBits(data, dataLength, bitPosition) & 0x03;
+                bitPosition += 2;
+                for (uint32_t i = 0; i < repeat && symbol <= maxSymbol; i++)
+                    probabilities[symbol++] = 0;
+            } while (repeat == 3);
+            if (symbol > maxSymbol)
+                return 0;
+        }
+
+        int32_t max = (2 * threshold - 1) - remaining, count;
+        uint32_t value = PeekFseDistributionBits(data, dataLength, bitPosition);
+        if ((int32_t)(value & (uint32_t)(threshold - 1)) < max) {
+            count = (int32_t)(value & (uint32_t)(threshold - 1));
+            bitPosition += bitsLength - 1;
+        } else {
+            count = (int32_t)(value & (uint32_t)(2 * threshold - 1));
+            if (count >= threshold)
+                count -= max;
+            bitPosition += bitsLength;
+        }
+        count--;
+        remaining -= count < 0 ? -count : count;
+        probabilities[symbol++] = (int16_t)count;
+        isPreviousZero = count == 0;
+        if (remaining < threshold) {
+            if (remaining <= 1)
+                break;
+            bitsLength = GetHighestBit((uint32_t)remaining) + 1;
+            threshold = 1 << (bitsLength - 1);
+        }
+    }
+    if (remaining != 1 || bitPosition > dataLength * 8)
+        return 0;
+
+    *symbolsLength = symbol;
+    return (bitPosition + 7) / 8;
+}
+
+uint32_t PeekFseDistributionBits(const unsigned char* data, size_t dataLength, size_t bitPosition) {
+    /* Read the (up to) 24 bits starting at 'bitPosition', least significant first, as zeroes past the end */
+    uint32_t value = 0;
+    size_t byteIndex = bitPosition / 8;
+    for (size_t i = 0; i < 4 && byteIndex + i < dataLength; i++)
+        value |= (uint32_t)data[byteIndex + i] << (8 * i);
+    return value >> (bitPosition % 8);
+}
+
+bool BuildFseTable(RaytmxFseTable* table, const int16_t* probabilities, uint32_t symbolsLength, uint32_t accuracyLog) {
+    /* Symbols with a probability of "less than one" each take one of the last states. The rest are spread through */
+    /* the table by repeatedly stepping an odd distance so that states of the same symbol are far apart. */
+    uint32_t tableSize = 1u << accuracyLog, highThreshold = tableSize - 1, position = 0;
+    uint32_t step = (tableSize >> 1) + (tableSize >> 3) + 3, symbolNexts[TMX_ZSTD_MAX_FSE_SYMBOLS];
+    if (symbolsLength > TMX_ZSTD_MAX_FSE_SYMBOLS)
+        return false;
+    for (uint32_t symbol = 0; symbol < symbolsLength; symbol++) {
+        if (probabilities[symbol] == -1) {
+            table->entries[highThreshold--].symbol = (uint8_t)symbol;
+            symbolNexts[symbol] = 1;
+        } else
+            symbolNexts[symbol] = (uint32_t)probabilities[symbol];
+    }
+    for (uint32_t symbol = 0; symbol < symbolsLength; symbol++) {
+        for (int32_t i = 0; i < probabilities[symbol]; i++) {
+            table->entries[position].symbol = (uint8_t)symbol;
+            do {
+                position = (position + step) & (tableSize - 1);
+            } while (position > highThreshold);
+        }
+    }
+    if (position != 0) /* If the probabilities didn't exactly fill the table */
+        return false;
+
+    /* Each state of a symbol decodes into the next state with the same number of bits, give or take one, such that */
+    /* the symbol's states together cover the whole table */
+    for (uint32_t i = 0; i < tableSize; i++) {
+        uint32_t nextState = symbolNexts[table->entries[i].symbol]++;
+        uint32_t bitsLength = accuracyLog - GetHighestBit(nextState);
+        table->entries[i].bitsLength = (uint8_t)bitsLength;
+        table->entries[i].baseline = (uint16_t)((nextState << bitsLength) - tableSize);
+    }
+    table->accuracyLog = accuracyLog;
+    return true;
+}
+
+bool InitZstdBits(RaytmxZstdBits* bits, const unsigned char* data, size_t dataLength) {
+    /* The last byte's highest set bit marks the end of the bits, which are read backward from there */
+    if (dataLength == 0 || data[dataLength - 1] == 0)
+        return false;
+
+    bits->start = data;
+    if (dataLength >= 8) {
+        bits->current = data + dataLength - 8;
+        memcpy(&bits->container, bits->current, 8);
+        bits->consumed = 0;
+    } else { /* Shorter data is treated as if preceded by zeroes that have already been consumed */
+        bits->current = data;
+        bits->container = 0;
+        for (size_t i = 0; i < dataLength; i++)
+            bits->container |= (uint64_t)data[i] << (8 * i);
+        bits->consumed = (uint32_t)(8 - dataLength) * 8;
+    }
+    bits->consumed += 8 - GetHighestBit(data[dataLength - 1]);
+    return true;
+}
+
+uint64_t PeekZstdBits(const RaytmxZstdBits* bits, uint32_t bitsLength) {
+    /* Shifting by one and then the rest avoids a branch for zero bits. Corrupt data may consume more than the */
+    /* container holds, yielding arbitrary bits, but that's caught once the stream is found not to end exactly. */
+    return ((bits->container << (bits->consumed & 63)) >> 1) >> (63 - bitsLength);
+}
+
+uint64_t ReadZstdBits(RaytmxZstdBits* bits, uint32_t bitsLength) {
+    uint64_t value = PeekZstdBits(bits, bitsLength);
+    bits->consumed += bitsLength;
+    return value;
+}
+
+void ReloadZstdBits(RaytmxZstdBits* bits) {
+    /* Move back over the bytes that have been fully consumed, without moving before the start */
+    size_t consumedBytes = bits->consumed >> 3;
+    if (consumedBytes > (size_t)(bits->current - bits->start))
+        consumedBytes = (size_t)(bits->current - bits->start);
+    if (consumedBytes == 0)
+        return;
+    bits->current -= consumedBytes;
+    bits->consumed -= (uint32_t)consumedBytes * 8;
+    memcpy(&bits->container, bits->current, 8);
+}
+
+uint32_t GetHighestBit(uint32_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 31 - (uint32_t)__builtin_clz(value);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, value);
+    return (uint32_t)index;
+#else
+    uint32_t index = 0;
+    while (value >>= 1)
+        index++;
+    return index;
+#endif
+}
+
+uint64_t GetXxHash64(const unsigned char* data, size_t dataLength) {
+    const uint64_t prime1 = 0x9E3779B185EBCA87ull, prime2 = 0xC2B2AE3D27D4EB4Full, prime3 = 0x165667B19E3779F9ull;
+    const uint64_t prime4 = 0x85EBCA77C2B2AE63ull, prime5 = 0x27D4EB2F165667C5ull;
+    const unsigned char* end = data + dataLength;
+    uint64_t hash, lane;
+
+    if (dataLength >= 32) { /* Four lanes, each consuming eight bytes of every 32 */
+        uint64_t accumulators[4] = { prime1 + prime2, prime2, 0, 0 - prime1 };
+        for (; end - data >= 32; data += 32) {
+            for (uint32_t i = 0; i < 4; i++) {
+                memcpy(&lane, data + i * 8, 8);
+                accumulators[i] = TMX_ROTL64(accumulators[i] + lane * prime2, 31) * prime1;
+            }
+        }
+        hash = TMX_ROTL64(accumulators[0], 1) + TMX_ROTL64(accumulators[1], 7) + TMX_ROTL64(accumulators[2], 12) +
+            TMX_ROTL64(accumulators[3], 18);
+        for (uint32_t i = 0; i < 4; i++)
+            hash = (hash ^ (TMX_ROTL64(accumulators[i] * prime2, 31) * prime1)) * prime1 + prime4;
+    } else
+        hash = prime5;
+    hash += (uint64_t)dataLength;
+
+    for (; end - data >= 8; data += 8) {
+        memcpy(&lane, data, 8);
+        hash ^= TMX_ROTL64(lane * prime2, 31) * prime1;
+        hash = TMX_ROTL64(hash, 27) * prime1 + prime4;
+    }
+    if (end - data >= 4) {
+        uint32_t word;
+        memcpy(&word, data, 4);
+        hash ^= (uint64_t)word * prime1;
+        hash = TMX_ROTL64(hash, 23) * prime2 + prime3;
+        data += 4;
+    }
+    for (; data < end; data++) {
+        hash ^= (uint64_t)*data * prime5;
+        hash = TMX_ROTL64(hash, 11) * prime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+Color GetColorFromHexString(const char* hex) {
+    Color color = BLACK; /* #define'd by raylib as { 0, 0, 0, 255 } */
+
+    size_t length = strlen(hex);
+    if (length < 6) /* If the hex string is too short to contain at least R, G, and B components */
+        return color;
+
+    /* Hex strings are in the form #AARRGGBB or #RRGGBB meaning alpha is optional. To avoid any special logic for the */
+    /* two cases where alpha is or isn't given, parsing will just be done backwards. Here, 'hex' is used as an */
+    /* iterator so it will begin at the end of the string. */
+    hex += length - 1;
+
+    char component[] = "\0\0\0"; /* Used to hold the two-digit component (e.g. "55" or "ff") */
+    for (size_t i = 0; i < length / 2; i++) { /* Iterate three or four times with four meaning alpha was included */
+        component[1] = *hex--; /* Store the char value 'hex' points to then point to the previous char */
         component[0] = *hex--; /* With this, 'component' will be something like { 'f', 'f', '\0' } */
         switch (i) {
         case 0: color.b = (unsigned char)strtoul(component, NULL, 16); break; /* e.g. "ff" -> 255 for blue */
@@ -3755,56 +9500,68 @@ int32_t GetGid(int32_t rawGid, bool* isFlippedHorizontally, bool* isFlippedVerti
     return rawGid & ~(FLIP_FLAG_HORIZONTAL | FLIP_FLAG_VERTICAL | FLIP_FLAG_DIAGONAL | FLIP_FLAG_ROTATE_120);
 }
 
+uint32_t GetFlipIndex(int32_t rawGid) {
+    /* The horizontal, vertical, and diagonal flags are the three most significant bits, in that order, so shifting */
+    /* them down yields (flipX << 2) | (flipY << 1) | flipDiag */
+    return ((uint32_t)rawGid >> 29) & 0x7;
+}
+
 void* MemAllocZero(unsigned int size) {
     void* buffer = MemAlloc(size); /* Reserve 'size' bytes of memory */
     memset(buffer, 0, size); /* Initialize any values to zero, NULL, false, or an equivalent enum value */
     return buffer;
 }
 
-/* "Get directory for a given filePath" */
-/* raylib's GetDirectoryPath() doesn't work as described so this is used in its place */
-char* GetDirectoryPath2(const char* filePath) {
-    static char directoryPath[260]; /* Max path length on Windows, the bottleneck, is 260 characters */
-    memset(directoryPath, '\0', 260);
-    size_t length = strlen(filePath);
+bool IsPathAbsolute(const char* path) {
     /* Paths beginning with a Windows drive letter (C:\, D:\, etc.) or beginning with a slash are absolute paths */
-    if (length >= 2 && (filePath[1] == ':' || filePath[0] == '\\' || filePath[0] == '/')) { /* If absolute */
-        if (IsPathFile(filePath)) /* If filePath points to a file, and we already know it's absolute */
-            StringCopy(directoryPath, filePath);
-        else { /* If filePath points to a directory, and we already know it's absolute */
-            StringCopy(directoryPath, filePath);
-            return directoryPath;
-        }
-    } else /* If filePath is relative */
-        StringCopy(directoryPath, JoinPath(GetWorkingDirectory(), filePath));
-
-    /* The goal is to return part of filePath, up to the last slash */
-    length = strlen(directoryPath);
-    char* iterator = directoryPath + length - 1;
-    /* Iterate backwards until a slash is found */
-    while (iterator != directoryPath && *iterator != '\0' && *iterator != '\\' && *iterator != '/')
-        iterator -= 1;
-    *(iterator + 1) = '\0'; /* Place a null terminator after the slash to effectively end the string there */
-    return directoryPath;
-}
-
-char* JoinPath(const char* prefix, const char* suffix) {
-    static char joinedPath[260]; /* Max path length on Windows, the bottleneck, is 260 characters */
-    memset(joinedPath, '\0', 260);
-    StringCopy(joinedPath, prefix);
-    size_t prefixLength = strlen(prefix);
-    if ((prefixLength >= 1) && (joinedPath[prefixLength - 1] != '/') && (joinedPath[prefixLength - 1] != '\\'))
+    return path[0] == '\\' || path[0] == '/' || (path[0] != '\0' && path[1] == ':');
+}
+
+/* Get the directory that paths within the given document are relative to by removing the file name from its path. */
+/* Nothing is read from disk so the file needn't exist yet, as with a binary map about to be written. If files are */
+/* read from disk, the directory is made absolute. If files are read through the callback, paths may be virtual so */
+/* they're kept as they are. */
+char* GetDocumentDirectory(const char* fileName, char* directory, size_t directorySize) {
+    /* Note: GetWorkingDirectory() returns raylib's shared buffer. See BeginLoadTMX(). */
+    if (tmxLoadFile == NULL && !IsPathAbsolute(fileName))
+        JoinPath(GetWorkingDirectory(), fileName, directory, directorySize);
+    else {
+        size_t length = strlen(fileName);
+        if (length >= directorySize)
+            length = directorySize - 1;
+        StringCopyN(directory, fileName, length);
+        directory[length] = '\0';
+    }
+
+    /* Iterate backwards until a slash is found and place a null terminator after it to end the string there */
+    size_t directoryLength = strlen(directory);
+    while (directoryLength > 0 && directory[directoryLength - 1] != '/' && directory[directoryLength - 1] != '\\')
+        directoryLength -= 1;
+    directory[directoryLength] = '\0';
+    return directory;
+}
+
+/* Join a directory and a path relative to it into the caller's buffer. Paths too long for the buffer are cut short. */
+char* JoinPath(const char* prefix, const char* suffix, char* joinedPath, size_t joinedPathSize) {
+    size_t length = strlen(prefix);
+    if (length >= joinedPathSize)
+        length = joinedPathSize - 1;
+    memcpy(joinedPath, prefix, length);
+    if (length >= 1 && joinedPath[length - 1] != '/' && joinedPath[length - 1] != '\\' && length + 1 < joinedPathSize)
 #ifdef _WIN32
-        joinedPath[prefixLength] = '\\'; /* Append the path with a '\\' separator */
+        joinedPath[length++] = '\\'; /* Append the path with a '\\' separator */
 #else
-        joinedPath[prefixLength] = '/'; /* Append the path with a '/' separator */
+        joinedPath[length++] = '/'; /* Append the path with a '/' separator */
 #endif
     const char* suffixStart = suffix;
-    size_t suffixLength = strlen(suffix);
-    if (suffixLength >= 2 && suffix[0] == '.' && (suffix[1] == '/' || suffix[1] == '\\'))
+    if (suffix[0] == '.' && (suffix[1] == '/' || suffix[1] == '\\'))
         suffixStart += 2; /* Skip over the "this directory" part (e.g. "./a.tsx" -> "a.tsx") */
-    /* Note: ".." is kept in the joined path intentionally although it is possible to exceed 260 characters. TODO? */
-    StringConcatenate(joinedPath, suffixStart);
+    /* Note: ".." is kept in the joined path intentionally although it makes the path longer than needed. TODO? */
+    size_t suffixLength = strlen(suffixStart);
+    if (length + suffixLength >= joinedPathSize)
+        suffixLength = joinedPathSize - 1 - length;
+    memcpy(joinedPath + length, suffixStart, suffixLength);
+    joinedPath[length + suffixLength] = '\0';
     return joinedPath;
 }
 